@@ -0,0 +1,19 @@
+# Toolchain for cross compiling to 64 bit ARM Linux, the tools can be run with qemu-user:
+# cmake -S . -B build-arm -DCMAKE_TOOLCHAIN_FILE=cmake/aarch64-linux-gnu.cmake
+# The ARMv8 crypto extensions kernels are built with -DSHA2_ENABLE_ARM_KERNELS=ON. With qemu-user found below
+# ctest runs the tests in the emulator, the kernels group checks the kernels against the scalar code
+set(CMAKE_SYSTEM_NAME Linux)
+set(CMAKE_SYSTEM_PROCESSOR aarch64)
+
+set(CMAKE_C_COMPILER aarch64-linux-gnu-gcc)
+set(CMAKE_CXX_COMPILER aarch64-linux-gnu-g++)
+
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_PACKAGE ONLY)
+
+find_program(SHA2_QEMU_AARCH64 qemu-aarch64)
+if(SHA2_QEMU_AARCH64)
+    set(CMAKE_CROSSCOMPILING_EMULATOR ${SHA2_QEMU_AARCH64} -L /usr/aarch64-linux-gnu)
+endif()
@@ -0,0 +1,13 @@
+#ifndef SHA2_H
+#define SHA2_H
+
+#include "Sha256.h"
+#include "Sha512.h"
+#include "Sha2Service.h"
+#include "Sha2Async.h"
+#include "Sha2Cache.h"
+#include "Sha2Chunking.h"
+#include "Sha2Merkle.h"
+#include "Sha2Metrics.h"
+
+#endif // SHA2_H
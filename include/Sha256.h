@@ -0,0 +1,1539 @@
+#ifndef SHA2_SHA256_H
+#define SHA2_SHA256_H
+
+#include "Sha2Common.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <functional>
+#include <array>
+#include <list>
+#include <unordered_map>
+
+/// \brief Sha256 constants
+inline constexpr std::uint32_t Sha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+/**
+    \brief A function for turning a number to the right
+    
+    The rotation of a number is equivalent to a cyclic shift of that number
+
+    \param [in] digitToRotate the number to be rotated
+    \param [in] rotateLen The number to rotate by
+
+    \example Lets rotate 1234 number by 3  
+    1234 = 0b00000000000000000000010011010010  
+    RightRotate(1234) = 0b01000000000000000000000010011010  
+
+    \return new rotated digit
+*/
+constexpr uint32_t RightRotate(const uint32_t& digitToRotate, const uint32_t& rotateLen) noexcept
+{
+    return (digitToRotate >> rotateLen) | (digitToRotate << (sizeof(uint32_t) * 8 - rotateLen));
+}
+
+/// \brief Convert uint32 to 4 bytes in big endian order
+/// \param [in] a uint32 number to convert
+/// \param [out] destination a pointer to the char array with at least 4 elements
+inline void Uint32ToBytes(const std::uint32_t& a, char* destination) noexcept
+{
+    destination[0] = static_cast<char>(a >> 24);
+    destination[1] = static_cast<char>(a >> 16);
+    destination[2] = static_cast<char>(a >> 8);
+    destination[3] = static_cast<char>(a);
+}
+
+/// \brief Convert 4 bytes in big endian order to uint32
+/// \param [in] source a pointer to the char array with at least 4 elements
+/// \return uint32 number
+inline std::uint32_t BytesToUint32(const char* source) noexcept
+{
+    std::uint32_t res = 0;
+    for (int i = 0; i < 4; ++i)
+        res = (res << 8) | static_cast<unsigned char>(source[i]);
+    return res;
+}
+
+/**
+    \brief Function for obtaining padding for the sha256 algorithm
+
+    \param [in] data a pointer to the char, starting for which you need to find the padding. The length of the data must be less than or equal to 64
+    \param [in] arrayLen the number of elements in the data arr
+    \param [in] dataLen the length of the source data
+    \param [out] destination a pointer to the char in which padding should be written. the length of the destination must be 128
+
+    \return returns the length of the padding. 64 if the length of the source data was less than 56, otherwise it will return 128
+*/
+constexpr int DataPaddingSha256(const char* data, const std::size_t& dataLen, const std::size_t& sourceLen, char* destination) noexcept
+{
+    // Variable to store padding length
+    int res = 0;
+
+    // Copy bytes from data to destination
+    for (std::size_t j = 0; j < dataLen; ++j)
+        destination[j] = data[j];
+    
+    // Set first padding bit to 1
+    destination[dataLen] = 0b10000000;
+
+    // Data length in bits
+    std::uint64_t bitsLength = sourceLen * 8;
+
+    // Check if padding have to be 128 bits
+    if (dataLen < 56)
+        res = 64;
+    else
+        res = 128;
+
+    // Handle last 8 bytes in padding
+    int i = 0;
+    for (; i < 8; ++i)
+    {
+        // Set 63 - i or 127 - i byte in padding value of right 8 bits from bits length
+        destination[res - 1 - i] = bitsLength & 0b11111111;
+
+        // Move 8 right bits from bits length
+        bitsLength >>= 8;
+
+        // If bits length equals 0 then break
+        if (bitsLength == 0) break;
+    }
+
+    // Set 0 byte to all unfilled positions
+    for (std::size_t j = dataLen + 1; j < static_cast<std::size_t>(res - i - 1); ++j)
+        destination[j] = 0;
+
+    return res;
+}
+
+/**
+    \brief Sha256 hashing step
+    
+    The function calculates the sha256 hash sum for a 64 byte block of data
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] offset a shift to indicate the beginning of the data block for which the hash is to be calculated
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+*/
+constexpr void Sha256Step(const char* data, const std::size_t& offset, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7) noexcept
+{
+    // Words array
+    std::uint32_t words[64] = {};
+
+    // Join 4 chars from data into 16 uint32_t numbers and save it to words array
+    for (int i = 0; i < 64; i += 4)
+        words[i >> 2] = (static_cast<std::uint32_t>(static_cast<unsigned char>(data[i + offset])) << 24) | 
+            (static_cast<std::uint32_t>(static_cast<unsigned char>(data[i + 1 + offset])) << 16) |
+            (static_cast<std::uint32_t>(static_cast<unsigned char>(data[i + 2 + offset])) << 8) | 
+            static_cast<std::uint32_t>(static_cast<unsigned char>(data[i + 3 + offset]));
+
+    // Fill last 48 uint32_t numbers
+    for (int i = 16; i < 64; ++i)
+        words[i] = words[i - 16] + (RightRotate(words[i - 15], 7) ^ RightRotate(words[i - 15], 18) ^ (words[i - 15] >> 3)) +
+            words[i - 7] + (RightRotate(words[i - 2], 17) ^ RightRotate(words[i - 2], 19) ^ (words[i - 2] >> 10));
+
+    // Temporary variables
+    std::uint32_t a = h0, b = h1, c = h2, d = h3, e = h4, f = h5, g = h6, h = h7;
+
+    // 64 rounds to calculate hash for data block
+    std::uint32_t temp1 = 0, temp2 = 0;
+    for (int i = 0; i < 64; ++i)
+    {
+        temp1 = h + (RightRotate(e, 6) ^ RightRotate(e, 11) ^ RightRotate(e, 25)) + ((e & f) ^ ((~e) & g)) + Sha256K[i] + words[i];
+        temp2 = (RightRotate(a, 2) ^ RightRotate(a, 13) ^ RightRotate(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + temp1; d = c; c = b; b = a; a = temp1 + temp2;
+    }
+
+    // Add temporary variables to hash
+    h0 += a, h1 += b, h2 += c, h3 += d, h4 += e, h5 += f, h6 += g, h7 += h;
+}
+
+/**
+    \brief Sha256 hashing steps for a run of blocks
+
+    The function calculates the sha256 hash sum for several consecutive 64 byte blocks of data.
+    The kernel is chosen once at the first call depending on the processor features
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] blocksCount the number of 64 byte blocks in data
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+*/
+SHA2_API void Sha256Steps(const char* data, const std::size_t& blocksCount, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7) noexcept;
+
+/**
+    \brief Write the internal state variables to the binary hash sum in big endian order
+
+    \param [in] h0 internal state variable 0
+    \param [in] h1 internal state variable 1
+    \param [in] h2 internal state variable 2
+    \param [in] h3 internal state variable 3
+    \param [in] h4 internal state variable 4
+    \param [in] h5 internal state variable 5
+    \param [in] h6 internal state variable 6
+    \param [in] h7 internal state variable 7
+    \param [in] digestLen the length of the hash sum in bytes. Must be less than or equal to 32
+    \param [out] digest a pointer to the array with at least digestLen elements
+*/
+constexpr void StateToDigest(const std::uint32_t& h0, const std::uint32_t& h1, const std::uint32_t& h2, const std::uint32_t& h3, const std::uint32_t& h4, const std::uint32_t& h5, const std::uint32_t& h6, const std::uint32_t& h7, const std::size_t& digestLen, std::uint8_t* digest) noexcept
+{
+    const std::uint32_t state[8] = { h0, h1, h2, h3, h4, h5, h6, h7 };
+
+    for (std::size_t i = 0; i < digestLen; ++i)
+        digest[i] = static_cast<std::uint8_t>(state[i >> 2] >> (24 - ((i & 3) << 3)));
+}
+
+/**
+    \brief A function for calculating the hash sum using the sha256 algorithm
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+*/
+SHA2_API void HashSha256(const char* data, const std::size_t& dataLen, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7);
+
+/**
+    \brief A function for calculating the hash sum using the sha256 algorithm at compile time
+
+    Unlike HashSha256 the function uses only the portable Sha256Step function, so it can be evaluated in constant expressions
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+*/
+constexpr void ConstexprHashSha256(const char* data, const std::size_t& dataLen, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7) noexcept
+{
+    // Handle 64 byte chunks
+    std::size_t chunksLen = dataLen & ~static_cast<std::size_t>(63);
+    for (std::size_t offset = 0; offset < chunksLen; offset += 64)
+        Sha256Step(data, offset, h0, h1, h2, h3, h4, h5, h6, h7);
+
+    // Padding source data
+    char padding[128] = {};
+    int paddingLen = DataPaddingSha256(data + chunksLen, dataLen - chunksLen, dataLen, padding);
+
+    // Calculate hash for padded data
+    for (int offset = 0; offset < paddingLen; offset += 64)
+        Sha256Step(padding, offset, h0, h1, h2, h3, h4, h5, h6, h7);
+}
+
+/**
+    \brief A function for calculating the file hash sum using the sha256 algorithm
+
+    The stream is read from the current position to the end in chunks, so the function works with pipes and other files without known size
+
+    \param [in] file stream with a file to calculate the hash for
+    \param [in] chunkSize the size of the chunks to read from the stream. Rounded down to a multiple of 64
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+*/
+SHA2_API void HashFileSha256(std::istream& file, const std::size_t& chunkSize, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7);
+
+/**
+    \brief A function for calculating the file hash sum using the sha256 algorithm
+
+    Regular files are mapped to memory if it is possible. Pipes, character devices, files that cannot be mapped
+    and files truncated during the hashing are read in chunks
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [in] chunkSize the size of the chunks to read the file, rounded down to a multiple of 64. For mapped files the size of the read ahead windows, rounded down to a multiple of the page size
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+
+    \return true if the hash was calculated, false if the file cannot be opened or read. The state variables are undefined then
+*/
+SHA2_API bool HashFileSha256(const std::string& fileName, const std::size_t& chunkSize, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7);
+
+/**
+    \brief A function for calculating the hash sums of many independent messages using the sha256 compression function
+
+    If the processor supports AVX-512 the messages are hashed in 16 parallel SIMD lanes.
+    On processors with SHA extensions every message is hashed separately with the HashSha256 function, because it is faster than 8 AVX2 lanes.
+    Otherwise AVX2 lanes are used if they are supported
+
+    \param [in] data an array of pointers to the messages
+    \param [in] dataLens an array of the messages lengths
+    \param [in] count the number of messages
+    \param [in] beginHash begin hash values of the algorithm
+    \param [out] hashes an array for the internal state variables of the messages. The state variable i of the message j is written to hashes[j * 8 + i]
+*/
+SHA2_API void HashSha256Batch(const char* const* data, const std::size_t* dataLens, const std::size_t& count, const std::uint32_t* beginHash, std::uint32_t* hashes) noexcept;
+
+/// \brief Sha256 kernel of the library. The kernels can be measured and checked separately from the dispatch
+struct Sha256Kernel
+{
+    // Name of the kernel
+    const char* name;
+
+    // Number of messages hashed together in parallel SIMD lanes, 1 for the kernels hashing one message at a time
+    std::size_t lanesCount;
+
+    // Function for calculating the hash sums of many messages with the kernel, with the same arguments as the HashSha256Batch function
+    void (*hash)(const char* const* data, const std::size_t* dataLens, const std::size_t& count, const std::uint32_t* beginHash, std::uint32_t* hashes) noexcept;
+};
+
+/**
+    \brief A function for getting the sha256 kernels supported by the processor
+
+    The first kernel is the portable scalar one, the other ones are the hardware accelerated single message and multi-lane kernels
+
+    \return the kernels
+*/
+SHA2_API std::vector<Sha256Kernel> GetSha256Kernels();
+
+/// \brief Binary sha256 hash sum
+typedef std::array<std::uint8_t, 32> Sha256Digest;
+
+/// \brief Binary sha224 hash sum
+typedef std::array<std::uint8_t, 28> Sha224Digest;
+
+/**
+    \brief A function for calculating the binary hash sum using the sha256 algorithm at compile time
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return an array with a sha256 hash sum
+*/
+constexpr Sha256Digest ConstexprSha256(const char* data, const std::size_t& dataLen) noexcept
+{
+    // Begin hash values
+    std::uint32_t h0 = 0x6a09e667, h1 = 0xbb67ae85, h2 = 0x3c6ef372, h3 = 0xa54ff53a, h4 = 0x510e527f, h5 = 0x9b05688c, h6 = 0x1f83d9ab, h7 = 0x5be0cd19;
+
+    // Calculate hash
+    ConstexprHashSha256(data, dataLen, h0, h1, h2, h3, h4, h5, h6, h7);
+
+    // Return calculated hash
+    Sha256Digest res = {};
+    StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, res.size(), res.data());
+    return res;
+}
+
+/**
+    \brief A function for calculating the binary hash sum of a string literal using the sha256 algorithm at compile time
+
+    \param [in] str the string literal to calculate the hash for. The terminating null character is not hashed
+
+    \return an array with a sha256 hash sum
+*/
+template <std::size_t N>
+constexpr Sha256Digest ConstexprSha256(const char (&str)[N]) noexcept
+{
+    return ConstexprSha256(str, N - 1);
+}
+
+/**
+    \brief A function for calculating the binary hash sum using the sha224 algorithm at compile time
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return an array with a sha224 hash sum
+*/
+constexpr Sha224Digest ConstexprSha224(const char* data, const std::size_t& dataLen) noexcept
+{
+    // Begin hash values
+    std::uint32_t h0 = 0xc1059ed8, h1 = 0x367cd507, h2 = 0x3070dd17, h3 = 0xf70e5939, h4 = 0xffc00b31, h5 = 0x68581511, h6 = 0x64f98fa7, h7 = 0xbefa4fa4;
+
+    // Calculate hash
+    ConstexprHashSha256(data, dataLen, h0, h1, h2, h3, h4, h5, h6, h7);
+
+    // Return calculated hash
+    Sha224Digest res = {};
+    StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, res.size(), res.data());
+    return res;
+}
+
+/**
+    \brief A function for calculating the binary hash sum of a string literal using the sha224 algorithm at compile time
+
+    \param [in] str the string literal to calculate the hash for. The terminating null character is not hashed
+
+    \return an array with a sha224 hash sum
+*/
+template <std::size_t N>
+constexpr Sha224Digest ConstexprSha224(const char (&str)[N]) noexcept
+{
+    return ConstexprSha224(str, N - 1);
+}
+
+/**
+    \brief A function for calculating the binary hash sum using the sha256 algorithm
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return an array with a sha256 hash sum
+*/
+SHA2_API Sha256Digest Sha256Binary(const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the binary hash sum using the sha256 algorithm
+
+    \param [in] str the string to calculate the hash for
+
+    \return an array with a sha256 hash sum
+*/
+SHA2_API Sha256Digest Sha256Binary(const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the binary file hash sum using the sha256 algorithm
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [out] digest an array for a sha256 hash sum
+    \param [in] chunkSize the size of the chunks to read the file, rounded down to a multiple of 64. For files mapped to memory the size of the read ahead windows
+
+    \return true if the hash was calculated, false if the file cannot be opened or read
+*/
+SHA2_API bool FileSha256Binary(const std::string& fileName, Sha256Digest& digest, const std::size_t& chunkSize = CHUNK_SIZE) noexcept;
+
+/**
+    \brief A function for calculating the hash sum using the sha256 algorithm
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return a string with a sha256 hash sum
+*/
+SHA2_API std::string Sha256(const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the hash sum using the sha256 algorithm
+
+    \param [in] str the string to calculate the hash for
+
+    \return a string with a sha256 hash sum
+*/
+SHA2_API std::string Sha256(const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the file hash sum using the sha256 algorithm
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [in] chunkSize the size of the chunks to read the file, rounded down to a multiple of 64. For files mapped to memory the size of the read ahead windows
+
+    \return a string with a sha256 hash sum
+*/
+SHA2_API std::string FileSha256(const std::string& fileName, const std::size_t& chunkSize = CHUNK_SIZE) noexcept;
+
+/**
+    \brief A function for calculating the binary hash sum using the sha224 algorithm
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return an array with a sha224 hash sum
+*/
+SHA2_API Sha224Digest Sha224Binary(const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the binary hash sum using the sha224 algorithm
+
+    \param [in] str the string to calculate the hash for
+
+    \return an array with a sha224 hash sum
+*/
+SHA2_API Sha224Digest Sha224Binary(const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the binary file hash sum using the sha224 algorithm
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [out] digest an array for a sha224 hash sum
+    \param [in] chunkSize the size of the chunks to read the file, rounded down to a multiple of 64. For files mapped to memory the size of the read ahead windows
+
+    \return true if the hash was calculated, false if the file cannot be opened or read
+*/
+SHA2_API bool FileSha224Binary(const std::string& fileName, Sha224Digest& digest, const std::size_t& chunkSize = CHUNK_SIZE) noexcept;
+
+/**
+    \brief A function for calculating the hash sum using the sha224 algorithm
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return a string with a sha224 hash sum
+*/
+SHA2_API std::string Sha224(const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the hash sum using the sha224 algorithm
+
+    \param [in] str the string to calculate the hash for
+
+    \return a string with a sha224 hash sum
+*/
+SHA2_API std::string Sha224(const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the file hash sum using the sha224 algorithm
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [in] chunkSize the size of the chunks to read the file, rounded down to a multiple of 64. For files mapped to memory the size of the read ahead windows
+
+    \return a string with a sha224 hash sum
+*/
+SHA2_API std::string FileSha224(const std::string& fileName, const std::size_t& chunkSize = CHUNK_SIZE) noexcept;
+
+/**
+    \brief A function for calculating the hash sums of many messages using the sha256 algorithm
+
+    The messages are hashed in parallel SIMD lanes if the processor supports it
+
+    \param [in] messages the strings to calculate the hashes for
+
+    \return a vector with sha256 hash sums in the order of messages
+*/
+SHA2_API std::vector<std::string> Sha256Batch(const std::vector<std::string>& messages) noexcept;
+
+/**
+    \brief A function for calculating the hash sums of many messages using the sha224 algorithm
+
+    The messages are hashed in parallel SIMD lanes if the processor supports it
+
+    \param [in] messages the strings to calculate the hashes for
+
+    \return a vector with sha224 hash sums in the order of messages
+*/
+SHA2_API std::vector<std::string> Sha224Batch(const std::vector<std::string>& messages) noexcept;
+
+/**
+    \brief A function for calculating the double sha256 hash sum sha256(sha256(data))
+
+    The result of the first pass is hashed in binary form. The second pass hashes one block with the constant padding of a 32 byte message
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return binary sha256d hash sum
+*/
+SHA2_API Sha256Digest Sha256dBinary(const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the double sha256 hash sum sha256(sha256(str))
+
+    \param [in] str the string to calculate the hash for
+
+    \return binary sha256d hash sum
+*/
+SHA2_API Sha256Digest Sha256dBinary(const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the double sha256 hash sum sha256(sha256(data))
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return a string with sha256d hash sum in hex form
+*/
+SHA2_API std::string Sha256d(const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the double sha256 hash sum sha256(sha256(str))
+
+    \param [in] str the string to calculate the hash for
+
+    \return a string with sha256d hash sum in hex form
+*/
+SHA2_API std::string Sha256d(const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the midstate of messages with a common 64 byte beginning
+
+    The midstate is the sha256 state after the first block. Messages which differ only after the first 64 bytes,
+    like block headers with different nonces, can be hashed from the midstate with the Sha256dFromMidstate function
+
+    \param [in] block a pointer to the first 64 bytes of the messages
+    \param [out] h0 internal state variable 0
+    \param [out] h1 internal state variable 1
+    \param [out] h2 internal state variable 2
+    \param [out] h3 internal state variable 3
+    \param [out] h4 internal state variable 4
+    \param [out] h5 internal state variable 5
+    \param [out] h6 internal state variable 6
+    \param [out] h7 internal state variable 7
+*/
+SHA2_API void Sha256Midstate(const char* block, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7) noexcept;
+
+/**
+    \brief A function for calculating the sha256d hash sum of a message from the midstate of its first 64 bytes
+
+    \param [in] h0 midstate variable 0
+    \param [in] h1 midstate variable 1
+    \param [in] h2 midstate variable 2
+    \param [in] h3 midstate variable 3
+    \param [in] h4 midstate variable 4
+    \param [in] h5 midstate variable 5
+    \param [in] h6 midstate variable 6
+    \param [in] h7 midstate variable 7
+    \param [in] tail a pointer to the bytes of the message after the first 64
+    \param [in] tailLen length of the tail. For 80 byte messages it is 16
+
+    \return binary sha256d hash sum of the whole message
+*/
+SHA2_API Sha256Digest Sha256dFromMidstate(const std::uint32_t& h0, const std::uint32_t& h1, const std::uint32_t& h2, const std::uint32_t& h3, const std::uint32_t& h4, const std::uint32_t& h5, const std::uint32_t& h6, const std::uint32_t& h7, const char* tail, const std::size_t& tailLen) noexcept;
+
+/**
+    \brief A function for calculating the sha256d hash sums of many messages with a common 64 byte beginning and tails of the same length
+
+    Intended for scanning many tail values, for example nonces. If the processor supports AVX-512 the messages are hashed in 16 parallel SIMD lanes,
+    with SHA extensions every message is hashed separately, otherwise AVX2 lanes are used if they are supported.
+    Tails of 64 bytes or longer are always hashed separately
+
+    \param [in] midstate the midstate of the common beginning from the Sha256Midstate function, state variable i in midstate[i]
+    \param [in] tails the tails one after another, the tail i starts at tails + i * tailLen
+    \param [in] tailLen length of every tail
+    \param [in] count the number of messages
+    \param [out] digests the binary sha256d hash sums one after another, 32 bytes each
+*/
+SHA2_API void Sha256dFromMidstateBatch(const std::uint32_t* midstate, const char* tails, const std::size_t& tailLen, const std::size_t& count, std::uint8_t* digests) noexcept;
+
+/**
+    \brief A function for calculating the parent nodes of a Merkle tree level using the sha256 algorithm
+
+    Every parent is sha256(left || right) of two adjacent 32 byte children. The message is always 64 bytes,
+    so the padding is not built: the second block is constant and its message schedule is precomputed.
+    If the processor supports AVX-512 the parents are hashed in 16 parallel SIMD lanes,
+    with SHA extensions every parent is hashed separately, otherwise AVX2 lanes are used if they are supported
+
+    \param [in] children the binary children one after another, 2 * count digests of 32 bytes
+    \param [in] count the number of parents
+    \param [out] parents the binary parents one after another, 32 bytes each
+*/
+SHA2_API void HashSha256Nodes(const std::uint8_t* children, const std::size_t& count, std::uint8_t* parents) noexcept;
+
+/// \brief Sha2 algorithms based on the sha256 compression function
+enum class Sha256Variant
+{
+    Sha256,
+    Sha224
+};
+
+/**
+    \brief Context for the incremental calculation of the hash sum using the sha256 or sha224 algorithm
+
+    Data can be passed to the context in parts of arbitrary length using the Update method.
+    Complete 64 byte blocks are hashed directly from the passed data, only the incomplete tail is buffered inside the context.
+    The Final method pads the data, returns the hash sum and resets the context, so the object can be reused
+*/
+class Sha256Context
+{
+private:
+    // Internal state variables
+    std::uint32_t h0, h1, h2, h3, h4, h5, h6, h7;
+
+    // Buffer for the incomplete 64 byte block
+    char buffer[64];
+
+    // Number of bytes in buffer
+    std::size_t bufferLen;
+
+    // Total length of the data passed to the context
+    std::uint64_t dataLen;
+
+    // Hashing algorithm
+    Sha256Variant variant;
+
+public:
+    /// \brief Context constructor
+    /// \param [in] variant hashing algorithm to use
+    Sha256Context(const Sha256Variant& variant = Sha256Variant::Sha256) noexcept : variant(variant)
+    {
+        Reset();
+    }
+
+    /// \brief Method for resetting the context to the begin state of the algorithm
+    void Reset() noexcept
+    {
+        // Begin hash values
+        if (variant == Sha256Variant::Sha224)
+        {
+            h0 = 0xc1059ed8, h1 = 0x367cd507, h2 = 0x3070dd17, h3 = 0xf70e5939, h4 = 0xffc00b31, h5 = 0x68581511, h6 = 0x64f98fa7, h7 = 0xbefa4fa4;
+        }
+        else
+        {
+            h0 = 0x6a09e667, h1 = 0xbb67ae85, h2 = 0x3c6ef372, h3 = 0xa54ff53a, h4 = 0x510e527f, h5 = 0x9b05688c, h6 = 0x1f83d9ab, h7 = 0x5be0cd19;
+        }
+
+        bufferLen = 0;
+        dataLen = 0;
+    }
+
+    /**
+        \brief Method for adding the next part of the data to the hash sum
+
+        \param [in] data a pointer to the array with the next part of the data
+        \param [in] len data array length
+    */
+    void Update(const char* data, const std::size_t& len) noexcept
+    {
+        dataLen += len;
+
+        // Offset of the first unprocessed byte in data
+        std::size_t offset = 0;
+
+        // Complete the buffered block
+        if (bufferLen > 0)
+        {
+            offset = std::min(len, 64 - bufferLen);
+            memcpy(buffer + bufferLen, data, offset);
+            bufferLen += offset;
+
+            // Check if the block is still incomplete
+            if (bufferLen < 64)
+                return;
+
+            Sha256Steps(buffer, 1, h0, h1, h2, h3, h4, h5, h6, h7);
+            bufferLen = 0;
+        }
+
+        // Handle 64 byte chunks directly from data
+        Sha256Steps(data + offset, (len - offset) >> 6, h0, h1, h2, h3, h4, h5, h6, h7);
+        offset += (len - offset) & ~static_cast<std::size_t>(0b00111111);
+
+        // Save the incomplete block to buffer
+        bufferLen = len - offset;
+        memcpy(buffer, data + offset, bufferLen);
+    }
+
+    /**
+        \brief Method for adding the next part of the data to the hash sum
+
+        \param [in] str the string with the next part of the data
+    */
+    void Update(const std::string& str) noexcept
+    {
+        Update(str.c_str(), str.length());
+    }
+
+    /**
+        \brief Method for finishing the hash sum calculation
+
+        After calling this method the context is reset to the begin state
+
+        \param [out] digest a pointer to the array for the binary hash sum. The length of the array must be at least 32 for sha256 and 28 for sha224
+
+        \return the length of the hash sum in bytes
+    */
+    std::size_t Final(std::uint8_t* digest) noexcept
+    {
+        // Padding buffered data
+        char padding[128];
+        int paddingLen = DataPaddingSha256(buffer, bufferLen, dataLen, padding);
+
+        // Calculate hash for padded data
+        Sha256Steps(padding, paddingLen >> 6, h0, h1, h2, h3, h4, h5, h6, h7);
+
+        std::size_t digestLen = variant == Sha256Variant::Sha256 ? 32 : 28;
+        StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, digestLen, digest);
+
+        Reset();
+        return digestLen;
+    }
+
+    /**
+        \brief Method for finishing the hash sum calculation
+
+        After calling this method the context is reset to the begin state
+
+        \return a string with a sha256 or sha224 hash sum
+    */
+    std::string Final() noexcept
+    {
+        std::uint8_t digest[32];
+        std::size_t digestLen = Final(digest);
+
+        std::string res(digestLen * 2, 0);
+        BytesToHex(digest, digestLen, &res[0]);
+        return res;
+    }
+
+    /// \brief Method for getting the hashing algorithm of the context
+    /// \return hashing algorithm
+    Sha256Variant Variant() const noexcept
+    {
+        return variant;
+    }
+
+    /// \brief Method for getting the length of the data passed to the context
+    /// \return the number of bytes
+    std::uint64_t Length() const noexcept
+    {
+        return dataLen;
+    }
+
+    /**
+        \brief Method for exporting the state of the context
+
+        The state is a compact binary blob: format version, hashing algorithm, length of the data, internal state variables and the incomplete block.
+        The blob is at most 105 bytes long
+
+        \return a string with the state
+    */
+    std::string Export() const
+    {
+        std::string res(42 + bufferLen, 0);
+
+        res[0] = 1;
+        res[1] = static_cast<char>(variant);
+        Uint32ToBytes(static_cast<std::uint32_t>(dataLen >> 32), &res[2]);
+        Uint32ToBytes(static_cast<std::uint32_t>(dataLen), &res[6]);
+
+        const std::uint32_t state[8] = { h0, h1, h2, h3, h4, h5, h6, h7 };
+        for (int i = 0; i < 8; ++i)
+            Uint32ToBytes(state[i], &res[10 + i * 4]);
+
+        memcpy(&res[42], buffer, bufferLen);
+        return res;
+    }
+
+    /**
+        \brief Method for importing the state exported by the Export method
+
+        The hashing algorithm of the context is replaced with the algorithm from the state
+
+        \param [in] state the string with the state
+
+        \return true if the state was imported, false if the state is damaged. In this case the context is not changed
+    */
+    bool Import(const std::string& state) noexcept
+    {
+        // Check the format version, the algorithm and the length of the incomplete block
+        if (state.length() < 42 || state.length() >= 106 || state[0] != 1 || state[1] < 0 || state[1] > static_cast<char>(Sha256Variant::Sha224))
+            return false;
+
+        std::uint64_t len = (static_cast<std::uint64_t>(BytesToUint32(&state[2])) << 32) | BytesToUint32(&state[6]);
+        if ((len & 63) != state.length() - 42)
+            return false;
+
+        variant = static_cast<Sha256Variant>(state[1]);
+        dataLen = len;
+
+        h0 = BytesToUint32(&state[10]), h1 = BytesToUint32(&state[14]), h2 = BytesToUint32(&state[18]), h3 = BytesToUint32(&state[22]);
+        h4 = BytesToUint32(&state[26]), h5 = BytesToUint32(&state[30]), h6 = BytesToUint32(&state[34]), h7 = BytesToUint32(&state[38]);
+
+        bufferLen = state.length() - 42;
+        memcpy(buffer, &state[42], bufferLen);
+        return true;
+    }
+};
+
+/**
+    \brief A function for calculating the file hash sum with periodic checkpoints
+
+    The hashing continues from the length of the data already passed to the context,
+    so a context imported from a checkpoint hashes only the rest of the file
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [in, out] context the context with the state of the already hashed beginning of the file. The context is not finished
+    \param [in] checkpoint the function called with the exported state of the context after every checkpointInterval bytes
+    \param [in] checkpointInterval the number of bytes between checkpoints
+    \param [in] chunkSize the size of the chunks to read the file
+
+    \return true if the whole file was hashed, false if the file cannot be read or is shorter than the already hashed length
+*/
+SHA2_API bool HashFileSha256Resumable(const std::string& fileName, Sha256Context& context, const std::function<void(const std::string&)>& checkpoint, const std::uint64_t& checkpointInterval = CHECKPOINT_INTERVAL, const std::size_t& chunkSize = CHUNK_SIZE);
+
+/**
+    \brief A function for calculating the file hash sum using the sha256 or sha224 algorithm which can be resumed after interruption
+
+    The state of the hashing is saved to the checkpoint file periodically. If the checkpoint file exists, the hashing continues from the saved state.
+    The checkpoint stores the device, inode, size and modification time of the file, the state saved for another version of the file is discarded.
+    The checkpoint file is replaced atomically and durably and removed after the hash sum is calculated
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [in] checkpointFileName the string with the name of the checkpoint file
+    \param [in] variant hashing algorithm to use
+    \param [in] checkpointInterval the number of bytes between checkpoints
+    \param [in] chunkSize the size of the chunks to read the file
+
+    \return a string with a hash sum
+*/
+SHA2_API std::string ResumableFileSha256(const std::string& fileName, const std::string& checkpointFileName, const Sha256Variant& variant = Sha256Variant::Sha256, const std::uint64_t& checkpointInterval = CHECKPOINT_INTERVAL, const std::size_t& chunkSize = CHUNK_SIZE) noexcept;
+
+/// \brief Snapshot of the sha256 or sha224 state after a common prefix of many messages
+class Sha256Prefix
+{
+private:
+    // Context after processing the prefix
+    Sha256Context context;
+
+public:
+    /**
+        \brief Prefix constructor
+
+        The full blocks of the prefix are compressed once, the rest of the prefix is kept in the context buffer
+
+        \param [in] prefix a pointer to the array with the prefix
+        \param [in] prefixLen prefix array length
+        \param [in] variant hashing algorithm to use
+    */
+    Sha256Prefix(const char* prefix, const std::size_t& prefixLen, const Sha256Variant& variant = Sha256Variant::Sha256) noexcept : context(variant)
+    {
+        context.Update(prefix, prefixLen);
+    }
+
+    /**
+        \brief Prefix constructor
+
+        \param [in] prefix the string with the prefix
+        \param [in] variant hashing algorithm to use
+    */
+    Sha256Prefix(const std::string& prefix, const Sha256Variant& variant = Sha256Variant::Sha256) noexcept : Sha256Prefix(prefix.c_str(), prefix.length(), variant) {}
+
+    /// \brief Method for getting the context after processing the prefix
+    /// \return a context to continue hashing with
+    const Sha256Context& Context() const noexcept
+    {
+        return context;
+    }
+
+    /**
+        \brief Method for calculating the hash sum of the prefix followed by the suffix
+
+        \param [in] suffix a pointer to the array with the suffix
+        \param [in] suffixLen suffix array length
+        \param [out] digest a pointer to the array for the binary hash sum. The length of the array must be at least 32 for sha256 and 28 for sha224
+
+        \return the length of the hash sum in bytes
+    */
+    std::size_t Hash(const char* suffix, const std::size_t& suffixLen, std::uint8_t* digest) const noexcept
+    {
+        Sha256Context res = context;
+        res.Update(suffix, suffixLen);
+        return res.Final(digest);
+    }
+
+    /**
+        \brief Method for calculating the hash sum of the prefix followed by the suffix
+
+        \param [in] suffix the string with the suffix
+
+        \return a string with a hash sum
+    */
+    std::string Hash(const std::string& suffix) const noexcept
+    {
+        Sha256Context res = context;
+        res.Update(suffix);
+        return res.Final();
+    }
+};
+
+/// \brief Thread safe cache of the sha256 or sha224 prefix states with the least recently used eviction
+class Sha256PrefixCache
+{
+private:
+    // Cached prefix and its position in the usage order
+    struct Entry
+    {
+        Sha256Prefix prefix;
+        std::list<const std::string*>::iterator position;
+    };
+
+    // Maximum number of cached prefixes
+    std::size_t capacity;
+
+    // Cached prefixes. The key is the algorithm followed by the prefix
+    std::unordered_map<std::string, Entry> entries;
+
+    // Keys of the cached prefixes from the most recently used to the least recently used
+    std::list<const std::string*> order;
+
+    // Mutex for entries and order
+    std::mutex mutex;
+
+public:
+    /// \brief Cache constructor
+    /// \param [in] capacity maximum number of cached prefixes
+    Sha256PrefixCache(const std::size_t& capacity = 64) noexcept : capacity(std::max(capacity, static_cast<std::size_t>(1))) {}
+
+    /**
+        \brief Method for getting the state after the prefix
+
+        The prefix is compressed only if it is not in the cache. The least recently used prefix is evicted when the cache is full
+
+        \param [in] prefix a pointer to the array with the prefix
+        \param [in] prefixLen prefix array length
+        \param [in] variant hashing algorithm to use
+
+        \return a snapshot of the state after the prefix
+    */
+    Sha256Prefix Prefix(const char* prefix, const std::size_t& prefixLen, const Sha256Variant& variant = Sha256Variant::Sha256)
+    {
+        std::string key(1 + prefixLen, static_cast<char>(variant));
+        memcpy(&key[1], prefix, prefixLen);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto entry = entries.find(key);
+            if (entry != entries.end())
+            {
+                order.splice(order.begin(), order, entry->second.position);
+                return entry->second.prefix;
+            }
+        }
+
+        // Compress the prefix without holding the lock
+        Sha256Prefix res(prefix, prefixLen, variant);
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Other thread could add the same prefix
+        if (entries.find(key) != entries.end())
+            return res;
+
+        if (entries.size() == capacity)
+        {
+            entries.erase(*order.back());
+            order.pop_back();
+        }
+
+        auto entry = entries.emplace(std::move(key), Entry{ res, order.end() }).first;
+        order.push_front(&entry->first);
+        entry->second.position = order.begin();
+
+        return res;
+    }
+
+    /**
+        \brief Method for calculating the hash sum of the prefix followed by the suffix
+
+        \param [in] prefix a pointer to the array with the prefix
+        \param [in] prefixLen prefix array length
+        \param [in] suffix a pointer to the array with the suffix
+        \param [in] suffixLen suffix array length
+        \param [out] digest a pointer to the array for the binary hash sum. The length of the array must be at least 32 for sha256 and 28 for sha224
+        \param [in] variant hashing algorithm to use
+
+        \return the length of the hash sum in bytes
+    */
+    std::size_t Hash(const char* prefix, const std::size_t& prefixLen, const char* suffix, const std::size_t& suffixLen, std::uint8_t* digest, const Sha256Variant& variant = Sha256Variant::Sha256)
+    {
+        return Prefix(prefix, prefixLen, variant).Hash(suffix, suffixLen, digest);
+    }
+
+    /**
+        \brief Method for calculating the hash sum of the prefix followed by the suffix
+
+        \param [in] prefix the string with the prefix
+        \param [in] suffix the string with the suffix
+        \param [in] variant hashing algorithm to use
+
+        \return a string with a hash sum
+    */
+    std::string Hash(const std::string& prefix, const std::string& suffix, const Sha256Variant& variant = Sha256Variant::Sha256)
+    {
+        return Prefix(prefix.c_str(), prefix.length(), variant).Hash(suffix);
+    }
+
+    /// \brief Method for removing all prefixes from the cache
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.clear();
+        order.clear();
+    }
+};
+
+/// \brief Hmac key with the precomputed internal states of the sha256 and sha224 algorithms
+class HmacSha256Key
+{
+private:
+    // Internal state after processing the key block xored with ipad
+    std::uint32_t innerState[8];
+
+    // Internal state after processing the key block xored with opad
+    std::uint32_t outerState[8];
+
+    // Hashing algorithm
+    Sha256Variant variant;
+
+public:
+    /**
+        \brief Key constructor
+
+        The key is padded to the block size, xored with ipad and opad and both blocks are hashed once, so each message authentication code costs only the message blocks and one outer block
+
+        \param [in] key a pointer to the array with the key
+        \param [in] keyLen key array length
+        \param [in] variant hashing algorithm to use
+    */
+    HmacSha256Key(const char* key, const std::size_t& keyLen, const Sha256Variant& variant = Sha256Variant::Sha256) noexcept : variant(variant)
+    {
+        // Key block. Keys longer than the block are hashed
+        char keyBlock[64] = {};
+        if (keyLen > 64)
+        {
+            Sha256Context context(variant);
+            context.Update(key, keyLen);
+            context.Final(reinterpret_cast<std::uint8_t*>(keyBlock));
+        }
+        else
+            memcpy(keyBlock, key, keyLen);
+
+        // Begin hash values
+        if (variant == Sha256Variant::Sha224)
+        {
+            const std::uint32_t beginState[8] = { 0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4 };
+            memcpy(innerState, beginState, sizeof(beginState));
+        }
+        else
+        {
+            const std::uint32_t beginState[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+            memcpy(innerState, beginState, sizeof(beginState));
+        }
+        memcpy(outerState, innerState, sizeof(innerState));
+
+        // Hash the key blocks xored with ipad and opad
+        char padBlock[64];
+        for (int i = 0; i < 64; ++i)
+            padBlock[i] = keyBlock[i] ^ 0x36;
+        Sha256Steps(padBlock, 1, innerState[0], innerState[1], innerState[2], innerState[3], innerState[4], innerState[5], innerState[6], innerState[7]);
+
+        for (int i = 0; i < 64; ++i)
+            padBlock[i] = keyBlock[i] ^ 0x5c;
+        Sha256Steps(padBlock, 1, outerState[0], outerState[1], outerState[2], outerState[3], outerState[4], outerState[5], outerState[6], outerState[7]);
+    }
+
+    /**
+        \brief Key constructor
+
+        \param [in] key the string with the key
+        \param [in] variant hashing algorithm to use
+    */
+    HmacSha256Key(const std::string& key, const Sha256Variant& variant = Sha256Variant::Sha256) noexcept : HmacSha256Key(key.c_str(), key.length(), variant) {}
+
+    /// \brief Method for getting the hashing algorithm of the key
+    /// \return hashing algorithm
+    Sha256Variant Variant() const noexcept
+    {
+        return variant;
+    }
+
+    /**
+        \brief Method for getting the internal state after processing the key block xored with ipad
+
+        \param [out] state a pointer to the array with at least 8 elements
+    */
+    void InnerState(std::uint32_t* state) const noexcept
+    {
+        memcpy(state, innerState, sizeof(innerState));
+    }
+
+    /**
+        \brief Method for getting the internal state after processing the key block xored with opad
+
+        \param [out] state a pointer to the array with at least 8 elements
+    */
+    void OuterState(std::uint32_t* state) const noexcept
+    {
+        memcpy(state, outerState, sizeof(outerState));
+    }
+
+    /**
+        \brief Method for finishing the message authentication code with the outer hash
+
+        \param [in] h0 inner internal state variable 0 after processing the padded message
+        \param [in] h1 inner internal state variable 1 after processing the padded message
+        \param [in] h2 inner internal state variable 2 after processing the padded message
+        \param [in] h3 inner internal state variable 3 after processing the padded message
+        \param [in] h4 inner internal state variable 4 after processing the padded message
+        \param [in] h5 inner internal state variable 5 after processing the padded message
+        \param [in] h6 inner internal state variable 6 after processing the padded message
+        \param [in] h7 inner internal state variable 7 after processing the padded message
+        \param [out] digest a pointer to the array for the binary message authentication code. The length of the array must be at least 32 for sha256 and 28 for sha224
+
+        \return the length of the message authentication code in bytes
+    */
+    std::size_t Outer(const std::uint32_t& h0, const std::uint32_t& h1, const std::uint32_t& h2, const std::uint32_t& h3, const std::uint32_t& h4, const std::uint32_t& h5, const std::uint32_t& h6, const std::uint32_t& h7, std::uint8_t* digest) const noexcept
+    {
+        std::size_t digestLen = variant == Sha256Variant::Sha256 ? 32 : 28;
+
+        // Inner hash sum is always padded to one block
+        std::uint8_t innerDigest[32];
+        StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, digestLen, innerDigest);
+
+        char padding[128];
+        DataPaddingSha256(reinterpret_cast<const char*>(innerDigest), digestLen, 64 + digestLen, padding);
+
+        std::uint32_t o0 = outerState[0], o1 = outerState[1], o2 = outerState[2], o3 = outerState[3], o4 = outerState[4], o5 = outerState[5], o6 = outerState[6], o7 = outerState[7];
+        Sha256Steps(padding, 1, o0, o1, o2, o3, o4, o5, o6, o7);
+
+        StateToDigest(o0, o1, o2, o3, o4, o5, o6, o7, digestLen, digest);
+        return digestLen;
+    }
+
+    /**
+        \brief Method for calculating the message authentication code
+
+        \param [in] data a pointer to the array with the message
+        \param [in] dataLen data array length
+        \param [out] digest a pointer to the array for the binary message authentication code. The length of the array must be at least 32 for sha256 and 28 for sha224
+
+        \return the length of the message authentication code in bytes
+    */
+    std::size_t Mac(const char* data, const std::size_t& dataLen, std::uint8_t* digest) const noexcept
+    {
+        std::uint32_t h0 = innerState[0], h1 = innerState[1], h2 = innerState[2], h3 = innerState[3], h4 = innerState[4], h5 = innerState[5], h6 = innerState[6], h7 = innerState[7];
+
+        // Handle 64 byte chunks
+        Sha256Steps(data, dataLen >> 6, h0, h1, h2, h3, h4, h5, h6, h7);
+
+        // Padding message. The key block is already processed
+        char padding[128];
+        int paddingLen = DataPaddingSha256(data + (dataLen & ~static_cast<std::size_t>(0b00111111)), dataLen & 0b00111111, 64 + dataLen, padding);
+        Sha256Steps(padding, paddingLen >> 6, h0, h1, h2, h3, h4, h5, h6, h7);
+
+        return Outer(h0, h1, h2, h3, h4, h5, h6, h7, digest);
+    }
+
+    /**
+        \brief Method for calculating the message authentication code
+
+        \param [in] str the string with the message
+
+        \return a string with the message authentication code in hex form
+    */
+    std::string Mac(const std::string& str) const noexcept
+    {
+        std::uint8_t digest[32];
+        std::size_t digestLen = Mac(str.c_str(), str.length(), digest);
+
+        std::string res(digestLen * 2, 0);
+        BytesToHex(digest, digestLen, &res[0]);
+        return res;
+    }
+};
+
+/// \brief Context for the incremental calculation of the hmac using the sha256 or sha224 algorithm
+class HmacSha256Context
+{
+private:
+    // Precomputed key
+    HmacSha256Key key;
+
+    // Inner internal state variables
+    std::uint32_t h0, h1, h2, h3, h4, h5, h6, h7;
+
+    // Buffer for the incomplete 64 byte block
+    char buffer[64];
+
+    // Number of bytes in buffer
+    std::size_t bufferLen;
+
+    // Total length of the data passed to the inner hash including the key block
+    std::uint64_t dataLen;
+
+public:
+    /// \brief Context constructor
+    /// \param [in] key precomputed key
+    HmacSha256Context(const HmacSha256Key& key) noexcept : key(key)
+    {
+        Reset();
+    }
+
+    /// \brief Method for resetting the context to the state after processing the key block
+    void Reset() noexcept
+    {
+        std::uint32_t state[8];
+        key.InnerState(state);
+        h0 = state[0], h1 = state[1], h2 = state[2], h3 = state[3], h4 = state[4], h5 = state[5], h6 = state[6], h7 = state[7];
+
+        bufferLen = 0;
+        dataLen = 64;
+    }
+
+    /**
+        \brief Method for adding the next part of the message to the message authentication code
+
+        \param [in] data a pointer to the array with the next part of the message
+        \param [in] len data array length
+    */
+    void Update(const char* data, const std::size_t& len) noexcept
+    {
+        dataLen += len;
+
+        // Offset of the first unprocessed byte in data
+        std::size_t offset = 0;
+
+        // Complete the buffered block
+        if (bufferLen > 0)
+        {
+            offset = std::min(len, 64 - bufferLen);
+            memcpy(buffer + bufferLen, data, offset);
+            bufferLen += offset;
+
+            // Check if the block is still incomplete
+            if (bufferLen < 64)
+                return;
+
+            Sha256Steps(buffer, 1, h0, h1, h2, h3, h4, h5, h6, h7);
+            bufferLen = 0;
+        }
+
+        // Handle 64 byte chunks directly from data
+        Sha256Steps(data + offset, (len - offset) >> 6, h0, h1, h2, h3, h4, h5, h6, h7);
+        offset += (len - offset) & ~static_cast<std::size_t>(0b00111111);
+
+        // Save the incomplete block to buffer
+        bufferLen = len - offset;
+        memcpy(buffer, data + offset, bufferLen);
+    }
+
+    /**
+        \brief Method for adding the next part of the message to the message authentication code
+
+        \param [in] str the string with the next part of the message
+    */
+    void Update(const std::string& str) noexcept
+    {
+        Update(str.c_str(), str.length());
+    }
+
+    /**
+        \brief Method for finishing the message authentication code calculation
+
+        After calling this method the context is reset to the state after processing the key block
+
+        \param [out] digest a pointer to the array for the binary message authentication code. The length of the array must be at least 32 for sha256 and 28 for sha224
+
+        \return the length of the message authentication code in bytes
+    */
+    std::size_t Final(std::uint8_t* digest) noexcept
+    {
+        // Padding buffered data
+        char padding[128];
+        int paddingLen = DataPaddingSha256(buffer, bufferLen, dataLen, padding);
+
+        // Calculate inner hash for padded data
+        Sha256Steps(padding, paddingLen >> 6, h0, h1, h2, h3, h4, h5, h6, h7);
+
+        std::size_t digestLen = key.Outer(h0, h1, h2, h3, h4, h5, h6, h7, digest);
+
+        Reset();
+        return digestLen;
+    }
+
+    /**
+        \brief Method for finishing the message authentication code calculation
+
+        After calling this method the context is reset to the state after processing the key block
+
+        \return a string with the message authentication code in hex form
+    */
+    std::string Final() noexcept
+    {
+        std::uint8_t digest[32];
+        std::size_t digestLen = Final(digest);
+
+        std::string res(digestLen * 2, 0);
+        BytesToHex(digest, digestLen, &res[0]);
+        return res;
+    }
+};
+
+/**
+    \brief A function for calculating the binary hmac using the sha256 algorithm
+
+    \param [in] key a pointer to the array with the key
+    \param [in] keyLen key array length
+    \param [in] data a pointer to the array with the message
+    \param [in] dataLen data array length
+
+    \return an array with a hmac-sha256 message authentication code
+*/
+SHA2_API Sha256Digest HmacSha256Binary(const char* key, const std::size_t& keyLen, const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the hmac using the sha256 algorithm
+
+    \param [in] key the string with the key
+    \param [in] str the string with the message
+
+    \return a string with a hmac-sha256 message authentication code
+*/
+SHA2_API std::string HmacSha256(const std::string& key, const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the binary hmac using the sha224 algorithm
+
+    \param [in] key a pointer to the array with the key
+    \param [in] keyLen key array length
+    \param [in] data a pointer to the array with the message
+    \param [in] dataLen data array length
+
+    \return an array with a hmac-sha224 message authentication code
+*/
+SHA2_API Sha224Digest HmacSha224Binary(const char* key, const std::size_t& keyLen, const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the hmac using the sha224 algorithm
+
+    \param [in] key the string with the key
+    \param [in] str the string with the message
+
+    \return a string with a hmac-sha224 message authentication code
+*/
+SHA2_API std::string HmacSha224(const std::string& key, const std::string& str) noexcept;
+
+/**
+    \brief A function for deriving keys from many passwords with the same salt using the pbkdf2 algorithm
+
+    The derived keys consist of blocks which are computed independently, so the blocks of all keys are iterated together.
+    The keys can have different variants, the keys of the same variant are iterated together
+
+    \param [in] keys an array of the hmac keys made from the passwords
+    \param [in] keysCount the number of keys
+    \param [in] salt a pointer to the array with the salt
+    \param [in] saltLen salt array length
+    \param [in] iterations the number of iterations. Values less than 1 are handled as 1
+    \param [in] derivedKeyLen the length of every derived key in bytes
+    \param [out] derivedKeys an array for the derived keys with at least keysCount * derivedKeyLen elements
+*/
+SHA2_API void Pbkdf2Sha256(const HmacSha256Key* keys, const std::size_t& keysCount, const char* salt, const std::size_t& saltLen, const std::uint64_t& iterations, const std::size_t& derivedKeyLen, std::uint8_t* derivedKeys);
+
+/**
+    \brief A function for deriving the binary key from the password using the pbkdf2 algorithm with hmac-sha256 or hmac-sha224
+
+    \param [in] password a pointer to the array with the password
+    \param [in] passwordLen password array length
+    \param [in] salt a pointer to the array with the salt
+    \param [in] saltLen salt array length
+    \param [in] iterations the number of iterations. Values less than 1 are handled as 1
+    \param [in] derivedKeyLen the length of the derived key in bytes
+    \param [out] derivedKey a pointer to the array for the derived key with at least derivedKeyLen elements
+    \param [in] variant hashing algorithm to use
+*/
+SHA2_API void Pbkdf2HmacSha256Binary(const char* password, const std::size_t& passwordLen, const char* salt, const std::size_t& saltLen, const std::uint64_t& iterations, const std::size_t& derivedKeyLen, std::uint8_t* derivedKey, const Sha256Variant& variant = Sha256Variant::Sha256);
+
+/**
+    \brief A function for deriving the key from the password using the pbkdf2 algorithm with hmac-sha256
+
+    \param [in] password the string with the password
+    \param [in] salt the string with the salt
+    \param [in] iterations the number of iterations. Values less than 1 are handled as 1
+    \param [in] derivedKeyLen the length of the derived key in bytes
+
+    \return a string with the derived key in hex form
+*/
+SHA2_API std::string Pbkdf2HmacSha256(const std::string& password, const std::string& salt, const std::uint64_t& iterations, const std::size_t& derivedKeyLen = 32);
+
+/**
+    \brief A function for deriving the keys from many candidate passwords with the same salt using the pbkdf2 algorithm with hmac-sha256
+
+    The passwords are processed together in parallel SIMD lanes if the processor supports them
+
+    \param [in] passwords the vector with the passwords
+    \param [in] salt the string with the salt
+    \param [in] iterations the number of iterations. Values less than 1 are handled as 1
+    \param [in] derivedKeyLen the length of the derived keys in bytes
+
+    \return a vector with the derived keys in hex form in the order of the passwords
+*/
+SHA2_API std::vector<std::string> Pbkdf2HmacSha256Batch(const std::vector<std::string>& passwords, const std::string& salt, const std::uint64_t& iterations, const std::size_t& derivedKeyLen = 32);
+
+/**
+    \brief A function for calculating the hash sums of files using the sha256 or sha224 algorithm with pipelined reading
+
+    The next chunks of files are read while the current chunk is hashed, so hashing runs at the disk speed
+
+    \param [in] files the names of files to calculate hash for
+    \param [in] variant hashing algorithm to use
+    \param [in] chunkSize the size of the chunks to read the files. Rounded down to a multiple of 64
+    \param [in] depth the number of buffers of every file
+    \param [in] openFilesCount the number of files read at the same time
+
+    \return a vector with hash sums in the order of files. The hash sum is an empty string if the file cannot be read
+*/
+SHA2_API std::vector<std::string> PipelinedFilesSha256(const std::vector<std::string>& files, const Sha256Variant& variant = Sha256Variant::Sha256, const std::size_t& chunkSize = CHUNK_SIZE, const unsigned int& depth = 3, const unsigned int& openFilesCount = 4) noexcept;
+
+/**
+    \brief A function for calculating the file hash sum using the sha256 algorithm with pipelined reading
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [in] chunkSize the size of the chunks to read the file. Rounded down to a multiple of 64
+
+    \return a string with a sha256 hash sum
+*/
+SHA2_API std::string PipelinedFileSha256(const std::string& fileName, const std::size_t& chunkSize = CHUNK_SIZE) noexcept;
+
+/**
+    \brief A function for calculating the tree hash of a file using the sha256 algorithm
+
+    The format of the tree hash is described in the HashTreeFileSha256 function
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [in] leafSize the size of the leaves in bytes
+    \param [in] threadsCount the number of threads to hash the leaves. By default all hardware threads are used
+
+    \return a string with a sha256 tree hash
+*/
+SHA2_API std::string TreeFileSha256(const std::string& fileName, const std::size_t& leafSize = TREE_LEAF_SIZE, const unsigned int& threadsCount = std::thread::hardware_concurrency()) noexcept;
+
+/**
+    \brief A function for checking the file against its sha256 tree hash
+
+    \param [in] fileName the string with file name to check
+    \param [in] treeHash the expected tree hash in hex form
+    \param [in] leafSize the size of the leaves the tree hash was calculated with
+    \param [in] threadsCount the number of threads to hash the leaves. By default all hardware threads are used
+
+    \return true if the file tree hash equals treeHash, otherwise false
+*/
+SHA2_API bool VerifyTreeFileSha256(const std::string& fileName, const std::string& treeHash, const std::size_t& leafSize = TREE_LEAF_SIZE, const unsigned int& threadsCount = std::thread::hardware_concurrency()) noexcept;
+
+#endif // SHA2_SHA256_H
@@ -0,0 +1,328 @@
+#ifndef SHA2_ASYNC_H
+#define SHA2_ASYNC_H
+
+// Awaitable hashing of files and streams. Needs C++20 coroutines, the header is empty for older standards,
+// so the library itself is still built as C++17
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include "Sha256.h"
+#include "Sha512.h"
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+/**
+    \brief Type of the functions resuming suspended hashing coroutines
+
+    The executor receives the handle of a coroutine which finished hashing a chunk and must resume it later,
+    for example from an event loop queue or on a thread pool. An empty executor never suspends the coroutines.
+    An executor which resumes the coroutine before it returns gets the coroutine only once, the next chunks are hashed
+    without suspensions, so the stack does not grow with every chunk
+*/
+typedef std::function<void(std::coroutine_handle<>)> Sha2Executor;
+
+/// \brief Awaiter passing the current coroutine to the executor between the chunks
+struct Sha2Yield
+{
+    // Copy of the executor to resume the coroutine
+    Sha2Executor executor;
+
+    // Coroutine passed to the executor by the current thread, nullptr outside of the executor calls
+    static inline thread_local void* resumingCoroutine = nullptr;
+
+    bool await_ready() const noexcept
+    {
+        return !executor;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        // The executor resumed the coroutine before returning, so it continues without suspension instead of nesting another executor call
+        if (resumingCoroutine == handle.address())
+            return false;
+
+        // The coroutine can be resumed and the awaiter destroyed before the executor returns, so the executor is moved out first
+        Sha2Executor resume = std::move(executor);
+        void* outerCoroutine = resumingCoroutine;
+        resumingCoroutine = handle.address();
+        try
+        {
+            resume(handle);
+        }
+        catch (...)
+        {
+            resumingCoroutine = outerCoroutine;
+            throw;
+        }
+        resumingCoroutine = outerCoroutine;
+        return true;
+    }
+
+    void await_resume() const noexcept {}
+};
+
+/**
+    \brief Lazy coroutine task with the result of an asynchronous hashing
+
+    The task starts when it is awaited with co_await or started with the Start method,
+    the awaiting coroutine is resumed when the result is ready
+
+    \tparam T type of the result
+*/
+template <typename T>
+class Sha2Task
+{
+private:
+    // Awaiter of the final suspension, transfers the control to the awaiting coroutine or completes the detached task
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        {
+            Promise& promise = handle.promise();
+
+            // The detached task owns its frame
+            if (promise.isDetached)
+            {
+                if (promise.completion)
+                    promise.completion(std::move(promise.value));
+                handle.destroy();
+                return std::noop_coroutine();
+            }
+
+            if (promise.continuation)
+                return promise.continuation;
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+public:
+    struct promise_type
+    {
+        // Result of the task
+        T value;
+
+        // Coroutine awaiting the task
+        std::coroutine_handle<> continuation;
+
+        // Completion function of the task started with the Start method
+        std::function<void(T)> completion;
+        bool isDetached = false;
+
+        Sha2Task get_return_object() noexcept
+        {
+            return Sha2Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        FinalAwaiter final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void return_value(T res) noexcept
+        {
+            value = std::move(res);
+        }
+
+        void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+    };
+
+private:
+    // Handle of the coroutine, empty after the task was started with the Start method
+    std::coroutine_handle<promise_type> handle;
+
+    explicit Sha2Task(const std::coroutine_handle<promise_type>& handle) noexcept : handle(handle) {}
+
+public:
+    Sha2Task(Sha2Task&& other) noexcept : handle(other.handle)
+    {
+        other.handle = nullptr;
+    }
+
+    Sha2Task& operator=(Sha2Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (handle)
+                handle.destroy();
+            handle = other.handle;
+            other.handle = nullptr;
+        }
+        return *this;
+    }
+
+    Sha2Task(const Sha2Task&) = delete;
+    Sha2Task& operator=(const Sha2Task&) = delete;
+
+    ~Sha2Task()
+    {
+        if (handle)
+            handle.destroy();
+    }
+
+    bool await_ready() const noexcept
+    {
+        return !handle || handle.done();
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+
+    T await_resume() noexcept
+    {
+        return std::move(handle.promise().value);
+    }
+
+    /**
+        \brief Method for starting the task from a function which is not a coroutine
+
+        The task owns itself after the call and is destroyed after the completion function is called
+
+        \param [in] completion the function to call with the result
+    */
+    void Start(std::function<void(T)> completion = {})
+    {
+        std::coroutine_handle<promise_type> started = handle;
+        handle = nullptr;
+
+        started.promise().completion = std::move(completion);
+        started.promise().isDetached = true;
+        started.resume();
+    }
+};
+
+/**
+    \brief Function for asynchronous calculating the hash sum of a stream using the sha256 or sha224 algorithm
+
+    The coroutine passes itself to the executor after every chunk, so a long stream does not block the thread of the caller.
+    The parameters are taken by value because they must stay valid while the coroutine is suspended
+
+    \param [in] stream the stream to calculate the hash for. Must stay valid until the task is completed
+    \param [in] executor the function resuming the coroutine between the chunks
+    \param [in] variant hashing algorithm to use
+    \param [in] chunkSize number of bytes read from the stream between the suspensions
+
+    \return a task with the hash sum in hex form, empty if the stream can not be read
+*/
+inline Sha2Task<std::string> AsyncStreamSha256(std::istream& stream, Sha2Executor executor = {}, Sha256Variant variant = Sha256Variant::Sha256, std::size_t chunkSize = CHUNK_SIZE)
+{
+    Sha256Context context(variant);
+    std::vector<char> chunk(std::max(chunkSize, static_cast<std::size_t>(64)));
+
+    while (stream)
+    {
+        // Read and hash the chunk
+        stream.read(chunk.data(), chunk.size());
+        context.Update(chunk.data(), static_cast<std::size_t>(stream.gcount()));
+
+        // Let the executor schedule the next chunk
+        if (stream)
+            co_await Sha2Yield{ executor };
+    }
+
+    // The hash sum of the partially read stream is not returned
+    if (stream.bad())
+        co_return "";
+
+    co_return context.Final();
+}
+
+/**
+    \brief Function for asynchronous calculating the hash sum of a file using the sha256 or sha224 algorithm
+
+    \param [in] fileName name of the file to calculate the hash for
+    \param [in] executor the function resuming the coroutine between the chunks
+    \param [in] variant hashing algorithm to use
+    \param [in] chunkSize number of bytes read from the file between the suspensions
+
+    \return a task with the hash sum in hex form, empty if the file can not be opened or read
+*/
+inline Sha2Task<std::string> AsyncFileSha256(std::string fileName, Sha2Executor executor = {}, Sha256Variant variant = Sha256Variant::Sha256, std::size_t chunkSize = CHUNK_SIZE)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open()) {std::cerr << "Can not open file: " << fileName << std::endl; co_return "";}
+
+    co_return co_await AsyncStreamSha256(file, std::move(executor), variant, chunkSize);
+}
+
+/**
+    \brief Function for asynchronous calculating the hash sum of a stream using the sha512, sha384, sha512/224 or sha512/256 algorithm
+
+    The coroutine passes itself to the executor after every chunk, so a long stream does not block the thread of the caller.
+    The parameters are taken by value because they must stay valid while the coroutine is suspended
+
+    \param [in] stream the stream to calculate the hash for. Must stay valid until the task is completed
+    \param [in] executor the function resuming the coroutine between the chunks
+    \param [in] variant hashing algorithm to use
+    \param [in] chunkSize number of bytes read from the stream between the suspensions
+
+    \return a task with the hash sum in hex form, empty if the stream can not be read
+*/
+inline Sha2Task<std::string> AsyncStreamSha512(std::istream& stream, Sha2Executor executor = {}, Sha512Variant variant = Sha512Variant::Sha512, std::size_t chunkSize = CHUNK_SIZE)
+{
+    Sha512Context context(variant);
+    std::vector<char> chunk(std::max(chunkSize, static_cast<std::size_t>(128)));
+
+    while (stream)
+    {
+        // Read and hash the chunk
+        stream.read(chunk.data(), chunk.size());
+        context.Update(chunk.data(), static_cast<std::size_t>(stream.gcount()));
+
+        // Let the executor schedule the next chunk
+        if (stream)
+            co_await Sha2Yield{ executor };
+    }
+
+    // The hash sum of the partially read stream is not returned
+    if (stream.bad())
+        co_return "";
+
+    co_return context.Final();
+}
+
+/**
+    \brief Function for asynchronous calculating the hash sum of a file using the sha512, sha384, sha512/224 or sha512/256 algorithm
+
+    \param [in] fileName name of the file to calculate the hash for
+    \param [in] executor the function resuming the coroutine between the chunks
+    \param [in] variant hashing algorithm to use
+    \param [in] chunkSize number of bytes read from the file between the suspensions
+
+    \return a task with the hash sum in hex form, empty if the file can not be opened or read
+*/
+inline Sha2Task<std::string> AsyncFileSha512(std::string fileName, Sha2Executor executor = {}, Sha512Variant variant = Sha512Variant::Sha512, std::size_t chunkSize = CHUNK_SIZE)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open()) {std::cerr << "Can not open file: " << fileName << std::endl; co_return "";}
+
+    co_return co_await AsyncStreamSha512(file, std::move(executor), variant, chunkSize);
+}
+
+#endif // __cpp_impl_coroutine
+
+#endif // SHA2_ASYNC_H
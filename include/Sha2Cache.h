@@ -0,0 +1,196 @@
+#ifndef SHA2_CACHE_H
+#define SHA2_CACHE_H
+
+#include "Sha2Common.h"
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <vector>
+#include <mutex>
+#include <utility>
+
+/// \brief Sha2 algorithms which hash sums are stored in the digest cache
+enum class Sha2Algorithm
+{
+    Sha256,
+    Sha224,
+    Sha512,
+    Sha384,
+    Sha512_224,
+    Sha512_256
+};
+
+/// \brief Identity of a file version. A cached hash sum is valid only while all fields stay the same
+struct FileIdentity
+{
+    std::uint64_t device = 0;
+    std::uint64_t inode = 0;
+    std::uint64_t size = 0;
+
+    // Modification and status change times in nanoseconds since the epoch
+    std::int64_t modificationTime = 0;
+    std::int64_t changeTime = 0;
+
+    // False if the file can not be identified, such files are never cached
+    bool isValid = false;
+
+    bool operator==(const FileIdentity& other) const noexcept
+    {
+        return isValid && other.isValid && device == other.device && inode == other.inode && size == other.size &&
+            modificationTime == other.modificationTime && changeTime == other.changeTime;
+    }
+};
+
+/**
+    \brief Persistent cache of the file hash sums keyed by the file identity
+
+    The index file is an array of fixed size records sorted by device and inode, it is mapped to memory by the Load method
+    and searched in place, so loading a large index costs no parsing. Hash sums calculated after the load are kept in memory
+    and merged into the index by the Save method.
+
+    A cached hash sum is used only if the device, the inode, the size, the modification time and the status change time
+    of the file are the same as at the calculation. A hash sum is not stored if the file changed while it was hashed,
+    or if the file was modified less than two seconds before, because a following modification within the timestamp granularity
+    would not change the identity. Only POSIX systems are supported, on other systems the cache is always empty.
+
+    The cache is used by the FileSha*Binary and FileSha* functions after it is installed with the SetDigestCache function.
+    All methods are thread safe
+*/
+class SHA2_API DigestCache
+{
+private:
+    // Record of the index file with the hash sums of all algorithms for one file version
+    struct Record
+    {
+        std::uint64_t device;
+        std::uint64_t inode;
+        std::uint64_t size;
+        std::int64_t modificationTime;
+        std::int64_t changeTime;
+
+        // Bit mask of the stored hash sums by the algorithm indices
+        std::uint32_t algorithms;
+        std::uint32_t reserved;
+
+        // Hash sums of sha256, sha224, sha512, sha384, sha512/224 and sha512/256 one after another
+        std::uint8_t digests[232];
+    };
+
+    // The index file mapped to memory and its sorted records
+    void* mapping = nullptr;
+    std::size_t mappingLen = 0;
+    const Record* mappedRecords = nullptr;
+    std::size_t mappedRecordsCount = 0;
+
+    // Flags of the mapped records used after the load
+    std::vector<bool> isMappedRecordUsed;
+
+    // Records stored after the load. They replace the mapped records with the same device and inode
+    std::map<std::pair<std::uint64_t, std::uint64_t>, Record> storedRecords;
+
+    // Lookup counters
+    std::uint64_t hitsCount = 0;
+    std::uint64_t missesCount = 0;
+
+    mutable std::mutex mutex;
+
+    std::size_t FindMapped(const std::uint64_t& device, const std::uint64_t& inode) const noexcept;
+    const Record* Find(const std::uint64_t& device, const std::uint64_t& inode, std::size_t& mappedIndex) const noexcept;
+    void Unmap() noexcept;
+
+public:
+    DigestCache() noexcept = default;
+
+    /// \brief Cache destructor, unmaps the index file. Stored hash sums are not saved automatically
+    ~DigestCache();
+
+    DigestCache(const DigestCache&) = delete;
+    DigestCache& operator=(const DigestCache&) = delete;
+
+    /**
+        \brief Method for loading the index file
+
+        The previous content of the cache is dropped. If the file does not exist or is damaged the cache stays empty
+
+        \param [in] indexFileName name of the index file
+
+        \return true if the index file was loaded
+    */
+    bool Load(const std::string& indexFileName) noexcept;
+
+    /**
+        \brief Method for saving the cache to the index file
+
+        The index is written to a temporary file with a unique name which replaces the index file, so the index file is never left partially written.
+        On POSIX systems the temporary file and its directory are flushed to the disk around the rename, so the index also survives a crash
+
+        \param [in] indexFileName name of the index file
+        \param [in] isUnusedDropped drop the loaded records which were not used after the load, for example records of deleted files
+
+        \return true if the index file was written
+    */
+    bool Save(const std::string& indexFileName, const bool& isUnusedDropped = false) noexcept;
+
+    /**
+        \brief Method for getting a cached hash sum of a file
+
+        \param [in] fileName name of the file
+        \param [in] algorithm algorithm of the hash sum
+        \param [out] digest the hash sum, the array must have a place for the whole hash sum
+        \param [out] identity identity of the file at the call, must be passed to the Store method after hashing the file
+
+        \return true if the hash sum was found
+    */
+    bool Lookup(const std::string& fileName, const Sha2Algorithm& algorithm, std::uint8_t* digest, FileIdentity& identity) noexcept;
+
+    /**
+        \brief Method for storing a hash sum of a file
+
+        The hash sum is not stored if the identity of the file differs from the passed one or the file was modified recently
+
+        \param [in] fileName name of the file
+        \param [in] identity identity of the file before hashing, got from the Lookup method
+        \param [in] algorithm algorithm of the hash sum
+        \param [in] digest the hash sum
+    */
+    void Store(const std::string& fileName, const FileIdentity& identity, const Sha2Algorithm& algorithm, const std::uint8_t* digest) noexcept;
+
+    /// \brief Method for dropping all records and unmapping the index file
+    void Clear() noexcept;
+
+    /// \brief Method for getting the number of files in the cache
+    /// \return the number of loaded and stored records
+    std::size_t Size() const noexcept;
+
+    /// \brief Method for getting the number of successful lookups
+    /// \return the number of lookups which found the hash sum
+    std::uint64_t HitsCount() const noexcept;
+
+    /// \brief Method for getting the number of failed lookups
+    /// \return the number of lookups which did not find the hash sum
+    std::uint64_t MissesCount() const noexcept;
+
+    /**
+        \brief Function for getting the identity of a file
+
+        \param [in] fileName name of the file
+
+        \return the identity, not valid if the file does not exist or is not a regular file
+    */
+    static FileIdentity Identify(const std::string& fileName) noexcept;
+};
+
+/**
+    \brief Function for installing the digest cache used by the file hashing functions
+
+    \param [in] cache the cache to use, nullptr to stop using the cache. The cache must stay valid while it is installed
+*/
+SHA2_API void SetDigestCache(DigestCache* cache) noexcept;
+
+/// \brief Function for getting the installed digest cache
+/// \return the installed cache, nullptr if no cache is installed
+SHA2_API DigestCache* GetDigestCache() noexcept;
+
+#endif // SHA2_CACHE_H
@@ -0,0 +1,78 @@
+#ifndef SHA2_CHUNKING_H
+#define SHA2_CHUNKING_H
+
+#include "Sha256.h"
+#include "Sha512.h"
+
+#include <string>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+
+/// \brief Chunk of data found by the content defined chunking with its hash sums
+struct ContentChunk
+{
+    // Position of the chunk in the data
+    std::uint64_t offset;
+    std::size_t length;
+
+    // Hash sums of the chunk. The sha512/256 hash sum is filled only if it was requested
+    Sha256Digest sha256;
+    Sha512_256Digest sha512_256;
+};
+
+/// \brief Type of the functions receiving the chunks in the order of the data
+typedef std::function<void(const ContentChunk&)> ContentChunkHandler;
+
+/**
+    \brief Function for finding the end of the next chunk with the FastCDC algorithm
+
+    The gear rolling hash is calculated from the minimum size of the chunk. Until the average size a stricter mask is used,
+    after it a looser one, so the chunk sizes concentrate around the average size
+
+    \param [in] data a pointer to the data starting with the chunk
+    \param [in] dataLen length of the available data
+    \param [in] minSize minimum chunk size
+    \param [in] averageSize average chunk size, rounded down to a power of two
+    \param [in] maxSize maximum chunk size
+
+    \return the chunk length, dataLen if the data is shorter than the minimum size
+*/
+SHA2_API std::size_t FindChunkBoundary(const char* data, const std::size_t& dataLen, const std::size_t& minSize = CDC_MIN_SIZE, const std::size_t& averageSize = CDC_AVERAGE_SIZE, const std::size_t& maxSize = CDC_MAX_SIZE) noexcept;
+
+/**
+    \brief Function for splitting a stream into content defined chunks and hashing the chunks and the whole stream in one pass
+
+    The stream is read once. Reading with chunking, hashing of the whole stream and hashing of the chunks run on three threads,
+    the chunks are hashed in batches with the multi-lane functions
+
+    \param [in] stream the stream to split
+    \param [in] handler the function receiving the chunks in the order of the stream. Called on a separate hashing thread, not on the calling one.
+    If the handler throws an exception, the chunking is stopped and the function returns false
+    \param [out] digest the sha256 hash sum of the whole stream
+    \param [in] isSha512_256Calculated calculate the sha512/256 hash sums of the chunks too
+    \param [in] minSize minimum chunk size
+    \param [in] averageSize average chunk size, rounded down to a power of two
+    \param [in] maxSize maximum chunk size
+
+    \return true if the whole stream was read and hashed, false if it can not be read, the handler threw an exception or the threads can not be started
+*/
+SHA2_API bool ChunkStreamSha256(std::istream& stream, const ContentChunkHandler& handler, Sha256Digest& digest, const bool& isSha512_256Calculated = false, const std::size_t& minSize = CDC_MIN_SIZE, const std::size_t& averageSize = CDC_AVERAGE_SIZE, const std::size_t& maxSize = CDC_MAX_SIZE) noexcept;
+
+/**
+    \brief Function for splitting a file into content defined chunks and hashing the chunks and the whole file in one pass
+
+    \param [in] fileName name of the file to split
+    \param [in] handler the function receiving the chunks in the order of the file. Called on a separate hashing thread, not on the calling one.
+    If the handler throws an exception, the chunking is stopped and the function returns false
+    \param [out] digest the sha256 hash sum of the whole file
+    \param [in] isSha512_256Calculated calculate the sha512/256 hash sums of the chunks too
+    \param [in] minSize minimum chunk size
+    \param [in] averageSize average chunk size, rounded down to a power of two
+    \param [in] maxSize maximum chunk size
+
+    \return true if the file was opened, read and hashed, false if it can not be read, the handler threw an exception or the threads can not be started
+*/
+SHA2_API bool ChunkFileSha256(const std::string& fileName, const ContentChunkHandler& handler, Sha256Digest& digest, const bool& isSha512_256Calculated = false, const std::size_t& minSize = CDC_MIN_SIZE, const std::size_t& averageSize = CDC_AVERAGE_SIZE, const std::size_t& maxSize = CDC_MAX_SIZE) noexcept;
+
+#endif // SHA2_CHUNKING_H
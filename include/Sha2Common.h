@@ -0,0 +1,96 @@
+#ifndef SHA2_COMMON_H
+#define SHA2_COMMON_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+// Define the attribute of the functions and classes exported by the shared library. The library is built with hidden visibility,
+// so only the public interface is exported
+#ifndef SHA2_API
+#if defined(__GNUC__) || defined(__clang__)
+#define SHA2_API __attribute__((visibility("default")))
+#else
+#define SHA2_API
+#endif
+#endif
+
+// Define the default block size for working with files
+// Must be multiple 128
+#ifndef CHUNK_SIZE
+#define CHUNK_SIZE 65536
+#endif
+
+// Define the default interval between checkpoints of resumable file hashing
+#ifndef CHECKPOINT_INTERVAL
+#define CHECKPOINT_INTERVAL 1073741824
+#endif
+
+// Define the default leaf size for tree hashing of files
+#ifndef TREE_LEAF_SIZE
+#define TREE_LEAF_SIZE 1048576
+#endif
+
+// Define the default minimum, average and maximum chunk sizes for content defined chunking
+#ifndef CDC_MIN_SIZE
+#define CDC_MIN_SIZE 2048
+#endif
+#ifndef CDC_AVERAGE_SIZE
+#define CDC_AVERAGE_SIZE 8192
+#endif
+#ifndef CDC_MAX_SIZE
+#define CDC_MAX_SIZE 65536
+#endif
+
+// Define the number of nodes hashed by one task when a level of a Merkle tree is built in parallel threads
+// Must be multiple 16
+#ifndef MERKLE_TASK_SIZE
+#define MERKLE_TASK_SIZE 4096
+#endif
+
+/**
+    \brief Convert bytes to hex form without memory allocations
+
+    On x86 16 bytes are converted at once with SSE2 instructions
+
+    \param [in] data a pointer to the bytes to convert
+    \param [in] len the number of bytes
+    \param [out] destination a pointer to the char array with at least 2 * len elements
+*/
+SHA2_API void BytesToHex(const std::uint8_t* data, const std::size_t& len, char* destination) noexcept;
+
+/**
+    \brief Convert the binary hash sum to hex form
+
+    \param [in] digest the binary hash sum
+
+    \return a string with the hash sum in hex form
+*/
+template <std::size_t N>
+inline std::string DigestToHex(const std::array<std::uint8_t, N>& digest) noexcept
+{
+    std::string res(N * 2, 0);
+    BytesToHex(digest.data(), N, &res[0]);
+    return res;
+}
+
+/**
+    \brief Convert the first 8 bytes of the binary hash sum to a number
+
+    The number can be used as a template argument or as a switch case label
+
+    \param [in] digest the binary hash sum
+
+    \return the first 8 bytes of the hash sum in big endian order
+*/
+template <std::size_t N>
+constexpr std::uint64_t DigestKey(const std::array<std::uint8_t, N>& digest) noexcept
+{
+    std::uint64_t res = 0;
+    for (std::size_t i = 0; i < 8; ++i)
+        res = (res << 8) | digest[i];
+    return res;
+}
+
+#endif // SHA2_COMMON_H
@@ -0,0 +1,270 @@
+#ifndef SHA2_MERKLE_H
+#define SHA2_MERKLE_H
+
+#include "Sha256.h"
+#include "Sha512.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <thread>
+
+/// \brief Merkle proof of a leaf of the MerkleTreeSha256 tree
+struct MerkleProofSha256
+{
+    // Position of the leaf and the number of leaves of the tree, they define the sides of the siblings. The verifier checks the number of leaves against its trusted one
+    std::size_t index = 0;
+    std::size_t leavesCount = 0;
+
+    // Siblings of the nodes on the path from the leaf to the root. Levels where the node has no sibling are skipped
+    std::vector<Sha256Digest> siblings;
+};
+
+/// \brief Merkle proof of a leaf of the MerkleTreeSha512 tree
+struct MerkleProofSha512
+{
+    // Position of the leaf and the number of leaves of the tree, they define the sides of the siblings. The verifier checks the number of leaves against its trusted one
+    std::size_t index = 0;
+    std::size_t leavesCount = 0;
+
+    // Siblings of the nodes on the path from the leaf to the root. Levels where the node has no sibling are skipped
+    std::vector<Sha512Digest> siblings;
+};
+
+/**
+    \brief In-memory Merkle tree using the sha256 algorithm
+
+    A leaf is the sha256 hash sum of a record. A parent is sha256(left || right) of its two children,
+    the unpaired last node of a level is moved to the next level unchanged. The root of an empty tree is the hash sum of an empty record.
+
+    The nodes are stored level by level in one array starting from the leaves, so the two children of a parent are adjacent
+    and form the 64 byte message of the parent without copying. Levels are hashed with the HashSha256Nodes function,
+    large levels in parallel threads. Updating a leaf rehashes only the path from the leaf to the root.
+
+    The methods changing the tree must not be called concurrently with other methods
+*/
+class SHA2_API MerkleTreeSha256
+{
+private:
+    // Nodes of all levels one after another, starting from the leaves
+    std::vector<Sha256Digest> nodes;
+
+    // Index of the first node of every level, the last element is the number of nodes
+    std::vector<std::size_t> levelOffsets;
+
+    void Allocate(const std::size_t& leavesCount);
+    void BuildLevels(const unsigned int& threadsCount);
+    void UpdatePath(std::size_t index) noexcept;
+
+public:
+    MerkleTreeSha256() = default;
+
+    /**
+        \brief Method for building the tree from records
+
+        \param [in] leaves pointers to the records
+        \param [in] leafLens lengths of the records
+        \param [in] count the number of records
+        \param [in] threadsCount the number of threads to hash the records and the large levels. By default all hardware threads are used
+    */
+    void Build(const char* const* leaves, const std::size_t* leafLens, const std::size_t& count, const unsigned int& threadsCount = std::thread::hardware_concurrency());
+
+    /**
+        \brief Method for building the tree from records
+
+        \param [in] leaves the records
+        \param [in] threadsCount the number of threads to hash the records and the large levels. By default all hardware threads are used
+    */
+    void Build(const std::vector<std::string>& leaves, const unsigned int& threadsCount = std::thread::hardware_concurrency());
+
+    /**
+        \brief Method for building the tree from the hash sums of records
+
+        \param [in] digests the leaves
+        \param [in] count the number of leaves
+        \param [in] threadsCount the number of threads to hash the large levels. By default all hardware threads are used
+    */
+    void BuildFromDigests(const Sha256Digest* digests, const std::size_t& count, const unsigned int& threadsCount = std::thread::hardware_concurrency());
+
+    /**
+        \brief Method for replacing a record and rehashing the path to the root
+
+        \param [in] index position of the leaf. Must be less than the number of leaves
+        \param [in] data a pointer to the new record
+        \param [in] dataLen length of the new record
+    */
+    void Update(const std::size_t& index, const char* data, const std::size_t& dataLen) noexcept;
+
+    /**
+        \brief Method for replacing a record and rehashing the path to the root
+
+        \param [in] index position of the leaf. Must be less than the number of leaves
+        \param [in] str the new record
+    */
+    void Update(const std::size_t& index, const std::string& str) noexcept;
+
+    /**
+        \brief Method for replacing a leaf and rehashing the path to the root
+
+        \param [in] index position of the leaf. Must be less than the number of leaves
+        \param [in] digest the hash sum of the new record
+    */
+    void UpdateDigest(const std::size_t& index, const Sha256Digest& digest) noexcept;
+
+    /// \brief Method for getting the root of the tree
+    /// \return the root hash sum
+    Sha256Digest Root() const noexcept;
+
+    /// \brief Method for getting the number of leaves
+    /// \return the number of leaves
+    std::size_t LeavesCount() const noexcept;
+
+    /// \brief Method for getting a leaf
+    /// \param [in] index position of the leaf. Must be less than the number of leaves
+    /// \return the hash sum of the record
+    const Sha256Digest& Leaf(const std::size_t& index) const noexcept;
+
+    /**
+        \brief Method for generating the proof of a leaf
+
+        \param [in] index position of the leaf. Must be less than the number of leaves
+
+        \return the proof with the siblings of the path from the leaf to the root
+    */
+    MerkleProofSha256 Proof(const std::size_t& index) const;
+
+    /**
+        \brief Function for checking a leaf against the root with its proof
+
+        The leaves and the parents are hashed without domain separation, so the number of leaves must come from the same trusted source
+        as the root and not from the proof. Otherwise a proof for a smaller tree could present a parent or a pair of parents as a leaf
+
+        \param [in] leaf the hash sum of the record
+        \param [in] proof the proof of the leaf
+        \param [in] leavesCount the trusted number of leaves of the tree. The proof is rejected if it was generated for another number of leaves
+        \param [in] root the expected root
+
+        \return true if the proof is complete and leads from the leaf to the root
+    */
+    static bool VerifyProof(const Sha256Digest& leaf, const MerkleProofSha256& proof, const std::size_t& leavesCount, const Sha256Digest& root) noexcept;
+};
+
+/**
+    \brief In-memory Merkle tree using the sha512 algorithm
+
+    A leaf is the sha512 hash sum of a record. A parent is sha512(left || right) of its two children,
+    the unpaired last node of a level is moved to the next level unchanged. The root of an empty tree is the hash sum of an empty record.
+
+    The nodes are stored level by level in one array starting from the leaves, so the two children of a parent are adjacent
+    and form the 128 byte message of the parent without copying. Levels are hashed with the HashSha512Nodes function,
+    large levels in parallel threads. Updating a leaf rehashes only the path from the leaf to the root.
+
+    The methods changing the tree must not be called concurrently with other methods
+*/
+class SHA2_API MerkleTreeSha512
+{
+private:
+    // Nodes of all levels one after another, starting from the leaves
+    std::vector<Sha512Digest> nodes;
+
+    // Index of the first node of every level, the last element is the number of nodes
+    std::vector<std::size_t> levelOffsets;
+
+    void Allocate(const std::size_t& leavesCount);
+    void BuildLevels(const unsigned int& threadsCount);
+    void UpdatePath(std::size_t index) noexcept;
+
+public:
+    MerkleTreeSha512() = default;
+
+    /**
+        \brief Method for building the tree from records
+
+        \param [in] leaves pointers to the records
+        \param [in] leafLens lengths of the records
+        \param [in] count the number of records
+        \param [in] threadsCount the number of threads to hash the records and the large levels. By default all hardware threads are used
+    */
+    void Build(const char* const* leaves, const std::size_t* leafLens, const std::size_t& count, const unsigned int& threadsCount = std::thread::hardware_concurrency());
+
+    /**
+        \brief Method for building the tree from records
+
+        \param [in] leaves the records
+        \param [in] threadsCount the number of threads to hash the records and the large levels. By default all hardware threads are used
+    */
+    void Build(const std::vector<std::string>& leaves, const unsigned int& threadsCount = std::thread::hardware_concurrency());
+
+    /**
+        \brief Method for building the tree from the hash sums of records
+
+        \param [in] digests the leaves
+        \param [in] count the number of leaves
+        \param [in] threadsCount the number of threads to hash the large levels. By default all hardware threads are used
+    */
+    void BuildFromDigests(const Sha512Digest* digests, const std::size_t& count, const unsigned int& threadsCount = std::thread::hardware_concurrency());
+
+    /**
+        \brief Method for replacing a record and rehashing the path to the root
+
+        \param [in] index position of the leaf. Must be less than the number of leaves
+        \param [in] data a pointer to the new record
+        \param [in] dataLen length of the new record
+    */
+    void Update(const std::size_t& index, const char* data, const std::size_t& dataLen) noexcept;
+
+    /**
+        \brief Method for replacing a record and rehashing the path to the root
+
+        \param [in] index position of the leaf. Must be less than the number of leaves
+        \param [in] str the new record
+    */
+    void Update(const std::size_t& index, const std::string& str) noexcept;
+
+    /**
+        \brief Method for replacing a leaf and rehashing the path to the root
+
+        \param [in] index position of the leaf. Must be less than the number of leaves
+        \param [in] digest the hash sum of the new record
+    */
+    void UpdateDigest(const std::size_t& index, const Sha512Digest& digest) noexcept;
+
+    /// \brief Method for getting the root of the tree
+    /// \return the root hash sum
+    Sha512Digest Root() const noexcept;
+
+    /// \brief Method for getting the number of leaves
+    /// \return the number of leaves
+    std::size_t LeavesCount() const noexcept;
+
+    /// \brief Method for getting a leaf
+    /// \param [in] index position of the leaf. Must be less than the number of leaves
+    /// \return the hash sum of the record
+    const Sha512Digest& Leaf(const std::size_t& index) const noexcept;
+
+    /**
+        \brief Method for generating the proof of a leaf
+
+        \param [in] index position of the leaf. Must be less than the number of leaves
+
+        \return the proof with the siblings of the path from the leaf to the root
+    */
+    MerkleProofSha512 Proof(const std::size_t& index) const;
+
+    /**
+        \brief Function for checking a leaf against the root with its proof
+
+        The leaves and the parents are hashed without domain separation, so the number of leaves must come from the same trusted source
+        as the root and not from the proof. Otherwise a proof for a smaller tree could present a parent or a pair of parents as a leaf
+
+        \param [in] leaf the hash sum of the record
+        \param [in] proof the proof of the leaf
+        \param [in] leavesCount the trusted number of leaves of the tree. The proof is rejected if it was generated for another number of leaves
+        \param [in] root the expected root
+
+        \return true if the proof is complete and leads from the leaf to the root
+    */
+    static bool VerifyProof(const Sha512Digest& leaf, const MerkleProofSha512& proof, const std::size_t& leavesCount, const Sha512Digest& root) noexcept;
+};
+
+#endif // SHA2_MERKLE_H
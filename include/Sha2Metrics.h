@@ -0,0 +1,78 @@
+#ifndef SHA2_METRICS_H
+#define SHA2_METRICS_H
+
+#include "Sha2Common.h"
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+// Upper bounds of the message size buckets in bytes. The last bucket has no bound
+inline constexpr std::uint64_t Sha2SizeBuckets[8] = { 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576 };
+
+// Upper bounds of the call latency buckets in nanoseconds. The last bucket has no bound
+inline constexpr std::uint64_t Sha2LatencyBuckets[12] = { 250, 1000, 4000, 16000, 64000, 256000, 1000000, 4000000, 16000000, 64000000, 256000000, 1000000000 };
+
+/// \brief Counters of the hashing functions based on one compression function
+struct Sha2FamilyMetrics
+{
+    // Bytes of the messages hashed by the one-shot, batch and file functions, and blocks compressed by the kernels
+    // including the padding blocks. The contexts count only the blocks
+    std::uint64_t bytesCount = 0;
+    std::uint64_t blocksCount = 0;
+
+    // One-shot hashing calls, their total length and their number by the message size. The bucket i counts the messages
+    // up to Sha2SizeBuckets[i] bytes which are longer than the bound of the previous bucket
+    std::uint64_t callsCount = 0;
+    std::uint64_t callsBytes = 0;
+    std::uint64_t callsBySize[9] = {};
+
+    // Latencies of the sampled one-shot calls in nanoseconds. All calls of 4096 bytes or longer are sampled, and every 64th shorter call
+    std::uint64_t latencySamplesCount = 0;
+    std::uint64_t latencySum = 0;
+    std::uint64_t latencyBuckets[13] = {};
+
+    // Time of the file hashing spent in waiting for the reads and in the hashing in nanoseconds.
+    // For the files mapped to memory the page faults are counted as hashing
+    std::uint64_t fileReadTime = 0;
+    std::uint64_t fileHashTime = 0;
+
+    // Names of the kernels selected for single messages and for batches of messages
+    std::string singleKernel;
+    std::string batchKernel;
+};
+
+/// \brief Snapshot of the hashing metrics of the whole process
+struct Sha2Metrics
+{
+    // False if the library was built without the metrics, then all counters are zero and only the kernel names are set
+    bool isEnabled = false;
+
+    Sha2FamilyMetrics sha256;
+    Sha2FamilyMetrics sha512;
+};
+
+/**
+    \brief Function for getting the hashing metrics
+
+    Every thread counts its calls in its own counters, the snapshot sums the counters of all threads including the finished ones.
+    The counters are collected only if the library is built with the SHA2_METRICS definition, the SHA2_ENABLE_METRICS CMake option
+
+    \return the counters since the start of the process or the last reset
+*/
+SHA2_API Sha2Metrics GetSha2Metrics() noexcept;
+
+/// \brief Function for resetting the hashing metrics. The following snapshots count only the calls after the reset
+SHA2_API void ResetSha2Metrics() noexcept;
+
+/**
+    \brief Function for exporting the hashing metrics in the Prometheus text format
+
+    The counters are exported as sha2_* metrics with the family label sha256 or sha512,
+    the message sizes and the latencies as histograms and the kernel names as the sha2_kernel_info metric
+
+    \return the metrics text
+*/
+SHA2_API std::string ExportSha2Metrics();
+
+#endif // SHA2_METRICS_H
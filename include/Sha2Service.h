@@ -0,0 +1,349 @@
+#ifndef SHA2_SERVICE_H
+#define SHA2_SERVICE_H
+
+#include "Sha256.h"
+#include "Sha512.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <chrono>
+#include <array>
+#include <optional>
+
+/**
+    \brief Bounded lock-free queue for many producers and many consumers
+
+    Every cell of the ring buffer has a sequence number, which tells producers and consumers whose turn it is to use the cell,
+    so pushing and popping take one compare and swap of the position in the common case and never block
+
+    \tparam T type of the elements, must be default constructible and movable
+*/
+template <typename T>
+class BoundedMpmcQueue
+{
+private:
+    // Element of the ring buffer with its turn number
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    // Ring buffer with a power of two length
+    std::vector<Cell> cells;
+
+    // Mask to convert positions to indices of the ring buffer
+    std::size_t mask;
+
+    // Positions of the next push and the next pop, kept in separate cache lines
+    alignas(64) std::atomic<std::size_t> pushPosition;
+    alignas(64) std::atomic<std::size_t> popPosition;
+
+public:
+    /// \brief Queue constructor
+    /// \param [in] capacity maximum number of elements. Rounded up to a power of two
+    BoundedMpmcQueue(const std::size_t& capacity) : pushPosition(0), popPosition(0)
+    {
+        std::size_t len = 2;
+        while (len < capacity)
+            len <<= 1;
+
+        cells = std::vector<Cell>(len);
+        mask = len - 1;
+        for (std::size_t i = 0; i < len; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /**
+        \brief Method for adding an element to the queue without waiting
+
+        \param [in, out] value the element to add. It is moved from only if the method succeeds
+
+        \return true if the element was added, false if the queue is full
+    */
+    bool TryPush(T& value) noexcept
+    {
+        std::size_t position = pushPosition.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        while (true)
+        {
+            cell = &cells[position & mask];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+            // The cell is free, try to take it
+            if (difference == 0)
+            {
+                if (pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            // The cell still holds the element from the previous round
+            else if (difference < 0)
+                return false;
+            // Other producer took the cell
+            else
+                position = pushPosition.load(std::memory_order_relaxed);
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+        \brief Method for taking an element from the queue without waiting
+
+        \param [out] value the taken element
+
+        \return true if an element was taken, false if the queue is empty
+    */
+    bool TryPop(T& value) noexcept
+    {
+        std::size_t position = popPosition.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        while (true)
+        {
+            cell = &cells[position & mask];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+            // The cell is filled, try to take it
+            if (difference == 0)
+            {
+                if (popPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            // The cell is not filled yet
+            else if (difference < 0)
+                return false;
+            // Other consumer took the cell
+            else
+                position = popPosition.load(std::memory_order_relaxed);
+        }
+
+        value = std::move(cell->value);
+        cell->sequence.store(position + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// \brief Method for getting the approximate number of elements in the queue
+    /// \return the number of elements at some moment during the call
+    std::size_t Size() const noexcept
+    {
+        std::size_t popped = popPosition.load(std::memory_order_acquire);
+        std::size_t pushed = pushPosition.load(std::memory_order_acquire);
+        return pushed > popped ? pushed - popped : 0;
+    }
+
+    /// \brief Method for getting the maximum number of elements in the queue
+    /// \return the capacity of the queue
+    std::size_t Capacity() const noexcept
+    {
+        return mask + 1;
+    }
+};
+
+/// \brief Result of a hashing job of the service
+struct HashingResult
+{
+    // Binary hash sum
+    std::array<std::uint8_t, 64> digest;
+
+    // Length of the hash sum in bytes. 0 if the job was rejected
+    std::size_t digestLen;
+
+    /// \brief Method for converting the hash sum to hex form
+    /// \return a string with the hash sum in hex form
+    std::string Hex() const noexcept
+    {
+        std::string res(digestLen * 2, 0);
+        BytesToHex(digest.data(), digestLen, &res[0]);
+        return res;
+    }
+};
+
+/// \brief Type of the functions called when a hashing job of the service is completed
+typedef std::function<void(const HashingResult&)> HashingCallback;
+
+/// \brief Metrics of a submission queue of the hashing service. Times are in nanoseconds
+struct HashingQueueStats
+{
+    // Number of accepted jobs
+    std::uint64_t submittedCount;
+
+    // Number of jobs rejected because the queue was full or the service was stopping
+    std::uint64_t rejectedCount;
+
+    // Number of completed jobs
+    std::uint64_t completedCount;
+
+    // Number of jobs in the queue
+    std::size_t depth;
+
+    // Total and maximum time between the submission and the start of hashing
+    std::uint64_t totalWaitTime;
+    std::uint64_t maxWaitTime;
+
+    // Total and maximum time between the submission and the completion
+    std::uint64_t totalLatency;
+    std::uint64_t maxLatency;
+};
+
+/// \brief Metrics of the hashing service
+struct HashingServiceStats
+{
+    // Queue of the small jobs, which are hashed in batches
+    HashingQueueStats small;
+
+    // Queue of the large jobs, which are hashed one by one
+    HashingQueueStats large;
+
+    // Number of batches and number of jobs hashed in them
+    std::uint64_t batchesCount;
+    std::uint64_t batchedJobsCount;
+};
+
+/**
+    \brief In-process service for hashing with a pool of worker threads
+
+    Jobs are submitted to bounded lock-free queues and completed through futures or callbacks.
+    Small jobs are hashed by workers in batches with the multi-lane batch functions, large jobs have their own queue,
+    so a large payload does not delay the small jobs behind it. When a queue is full the blocking submission waits for a free place,
+    the non-blocking submission is rejected
+*/
+class SHA2_API Sha2Service
+{
+private:
+    // Job in a submission queue
+    struct Job
+    {
+        // Data to hash. Points to ownedData if the service owns the data
+        const char* data = nullptr;
+        std::size_t dataLen = 0;
+        std::string ownedData;
+
+        // Algorithm index, from 0 to 5 for sha256, sha224, sha512, sha384, sha512/224 and sha512/256
+        int algorithm = 0;
+
+        // Completion handlers, the promise is used if there is no callback. The promise is created only by the future submissions,
+        // so the empty jobs of the queue cells and of the workers allocate no shared states
+        HashingCallback callback;
+        std::optional<std::promise<HashingResult>> promise;
+
+        // Time of the submission
+        std::chrono::steady_clock::time_point submitTime;
+    };
+
+    // Atomic metrics of a queue
+    struct QueueCounters
+    {
+        std::atomic<std::uint64_t> submittedCount{ 0 };
+        std::atomic<std::uint64_t> rejectedCount{ 0 };
+        std::atomic<std::uint64_t> completedCount{ 0 };
+        std::atomic<std::uint64_t> totalWaitTime{ 0 };
+        std::atomic<std::uint64_t> maxWaitTime{ 0 };
+        std::atomic<std::uint64_t> totalLatency{ 0 };
+        std::atomic<std::uint64_t> maxLatency{ 0 };
+    };
+
+    // Maximum length of the jobs in the small jobs queue
+    std::size_t smallJobSize;
+
+    // Submission queues and their metrics
+    BoundedMpmcQueue<Job> smallJobs;
+    BoundedMpmcQueue<Job> largeJobs;
+    QueueCounters smallCounters;
+    QueueCounters largeCounters;
+    std::atomic<std::uint64_t> batchesCount{ 0 };
+    std::atomic<std::uint64_t> batchedJobsCount{ 0 };
+
+    // Idle workers sleep on the condition variable, producers wake them only if there are sleeping workers
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::atomic<unsigned int> sleepingCount{ 0 };
+    std::atomic<bool> isStopping{ false };
+
+    // Worker threads
+    std::vector<std::thread> workers;
+
+    void Work() noexcept;
+    void HashBatch(Job* jobs, const std::size_t& count) noexcept;
+    void Complete(Job& job, const HashingResult& result, QueueCounters& counters) noexcept;
+    bool Enqueue(Job& job, const bool& isBlocking) noexcept;
+
+public:
+    /**
+        \brief Service constructor, starts the worker threads
+
+        \param [in] threadsCount number of worker threads
+        \param [in] queueCapacity maximum number of waiting jobs in each of the small and the large jobs queues
+        \param [in] smallJobSize maximum length of the data of the jobs hashed in batches
+    */
+    Sha2Service(const unsigned int& threadsCount = std::thread::hardware_concurrency(), const std::size_t& queueCapacity = 4096, const std::size_t& smallJobSize = 16384);
+
+    /// \brief Service destructor, completes the submitted jobs and stops the worker threads
+    ~Sha2Service();
+
+    Sha2Service(const Sha2Service&) = delete;
+    Sha2Service& operator=(const Sha2Service&) = delete;
+
+    /**
+        \brief Method for submitting a job and getting its result as a future
+
+        Waits while the queue is full. The data must stay valid until the job is completed.
+        Throws std::bad_alloc if the shared state of the future cannot be allocated
+
+        \param [in] data a pointer to the array to calculate the hash for
+        \param [in] dataLen data array length
+        \param [in] variant hashing algorithm to use
+
+        \return a future with the hash sum. The length of the hash sum is 0 if the service is stopping
+    */
+    std::future<HashingResult> Submit(const char* data, const std::size_t& dataLen, const Sha256Variant& variant = Sha256Variant::Sha256);
+    std::future<HashingResult> Submit(const char* data, const std::size_t& dataLen, const Sha512Variant& variant);
+
+    /**
+        \brief Method for submitting a job with the data owned by the service and getting its result as a future
+
+        Waits while the queue is full. Throws std::bad_alloc if the shared state of the future cannot be allocated
+
+        \param [in] data the string to calculate the hash for
+        \param [in] variant hashing algorithm to use
+
+        \return a future with the hash sum. The length of the hash sum is 0 if the service is stopping
+    */
+    std::future<HashingResult> Submit(std::string data, const Sha256Variant& variant = Sha256Variant::Sha256);
+    std::future<HashingResult> Submit(std::string data, const Sha512Variant& variant);
+
+    /**
+        \brief Method for submitting a job with a completion callback
+
+        The callback is called on a worker thread. The data must stay valid until the callback is called.
+        An exception thrown by the callback is caught and ignored, the job is counted as completed
+
+        \param [in] data a pointer to the array to calculate the hash for
+        \param [in] dataLen data array length
+        \param [in] variant hashing algorithm to use
+        \param [in] callback the function to call with the hash sum
+        \param [in] isBlocking wait while the queue is full instead of rejecting the job
+
+        \return true if the job was accepted, false if it was rejected or the job cannot be allocated, the callback will not be called then
+    */
+    bool Submit(const char* data, const std::size_t& dataLen, const Sha256Variant& variant, const HashingCallback& callback, const bool& isBlocking = true) noexcept;
+    bool Submit(const char* data, const std::size_t& dataLen, const Sha512Variant& variant, const HashingCallback& callback, const bool& isBlocking = true) noexcept;
+
+    /// \brief Method for getting the metrics of the service
+    /// \return the metrics at some moment during the call
+    HashingServiceStats Stats() const noexcept;
+};
+
+#endif // SHA2_SERVICE_H
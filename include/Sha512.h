@@ -0,0 +1,1775 @@
+#ifndef SHA2_SHA512_H
+#define SHA2_SHA512_H
+
+#include "Sha2Common.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <functional>
+#include <array>
+#include <list>
+#include <unordered_map>
+
+/// \brief Sha2 512 constants
+inline constexpr std::uint64_t Sha512K[80] = {
+    0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f, 0xe9b5dba58189dbbc,
+    0x3956c25bf348b538, 0x59f111f1b605d019, 0x923f82a4af194f9b, 0xab1c5ed5da6d8118,
+    0xd807aa98a3030242, 0x12835b0145706fbe, 0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
+    0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235, 0xc19bf174cf692694,
+    0xe49b69c19ef14ad2, 0xefbe4786384f25e3, 0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65,
+    0x2de92c6f592b0275, 0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
+    0x983e5152ee66dfab, 0xa831c66d2db43210, 0xb00327c898fb213f, 0xbf597fc7beef0ee4,
+    0xc6e00bf33da88fc2, 0xd5a79147930aa725, 0x06ca6351e003826f, 0x142929670a0e6e70,
+    0x27b70a8546d22ffc, 0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
+    0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6, 0x92722c851482353b,
+    0xa2bfe8a14cf10364, 0xa81a664bbc423001, 0xc24b8b70d0f89791, 0xc76c51a30654be30,
+    0xd192e819d6ef5218, 0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8,
+    0x19a4c116b8d2d0c8, 0x1e376c085141ab53, 0x2748774cdf8eeb99, 0x34b0bcb5e19b48a8,
+    0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb, 0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3,
+    0x748f82ee5defb2fc, 0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
+    0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915, 0xc67178f2e372532b,
+    0xca273eceea26619c, 0xd186b8c721c0c207, 0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178,
+    0x06f067aa72176fba, 0x0a637dc5a2c898a6, 0x113f9804bef90dae, 0x1b710b35131c471b,
+    0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc, 0x431d67c49c100d4c,
+    0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817,
+};
+
+/**
+    \brief A function for turning a number to the right
+    
+    The rotation of a number is equivalent to a cyclic shift of that number
+
+    \param [in] digitToRotate the number to be rotated
+    \param [in] rotateLen The number to rotate by
+
+    \example Lets rotate 1234 number by 3  
+    1234 = 0b0000000000000000000000000000000000000000000000000000010011010010  
+    RightRotate(1234) = 0b0100000000000000000000000000000000000000000000000000000010011010  
+
+    \return new rotated digit
+*/
+constexpr uint64_t RightRotate(const uint64_t& digitToRotate, const uint64_t& rotateLen) noexcept
+{
+    return (digitToRotate >> rotateLen) | (digitToRotate << (sizeof(uint64_t) * 8 - rotateLen));
+}
+
+/// \brief Convert uint64 to 8 bytes in big endian order
+/// \param [in] a uint64 number to convert
+/// \param [out] destination a pointer to the char array with at least 8 elements
+inline void Uint64ToBytes(const std::uint64_t& a, char* destination) noexcept
+{
+    for (int i = 0; i < 8; ++i)
+        destination[i] = static_cast<char>(a >> (56 - i * 8));
+}
+
+/// \brief Convert 8 bytes in big endian order to uint64
+/// \param [in] source a pointer to the char array with at least 8 elements
+/// \return uint64 number
+inline std::uint64_t BytesToUint64(const char* source) noexcept
+{
+    std::uint64_t res = 0;
+    for (int i = 0; i < 8; ++i)
+        res = (res << 8) | static_cast<unsigned char>(source[i]);
+    return res;
+}
+
+/**
+    \brief Function for obtaining padding for the sha512 algorithm
+
+    \param [in] data a pointer to the char, starting for which you need to find the padding. The length of the data must be less than or equal to 128
+    \param [in] arrayLen the number of elements in the data arr
+    \param [in] dataLen the length of the source data
+    \param [out] destination a pointer to the char in which padding should be written. the length of the destination must be 128
+
+    \return returns the length of the padding. 128 if the length of the source data was less than 112, otherwise it will return 256
+*/
+constexpr int DataPaddingSha512(const char* data, const std::size_t& dataLen, const std::size_t& sourceLen, char* destination) noexcept
+{
+    // Variable to store padding length
+    int res = 0;
+
+    // Copy bytes from data to destination
+    for (std::size_t j = 0; j < dataLen; ++j)
+        destination[j] = data[j];
+    
+    // Set first padding bit to 1
+    destination[dataLen] = 0b10000000;
+
+    // Data length in bits
+    std::uint64_t bitsLength = sourceLen * 8;
+
+    // Check if padding have to be 256 bits
+    if (dataLen < 112)
+        res = 128;
+    else
+        res = 256;
+
+    // Handle last 16 bytes in padding
+    int i = 0;
+    for (; i < 16; ++i)
+    {
+        // Set 127 - i or 255 - i byte in padding value of right 8 bits from bits length
+        destination[res - 1 - i] = bitsLength & 0b11111111;
+
+        // Move 8 right bits from bits length
+        bitsLength >>= 8;
+
+        // If bits length equals 0 then break
+        if (bitsLength == 0) break;
+    }
+
+    // Set 0 byte to all unfilled positions
+    for (std::size_t j = dataLen + 1; j < static_cast<std::size_t>(res - i - 1); ++j)
+        destination[j] = 0;
+
+    return res;
+}
+
+/**
+    \brief Sha512 hashing step
+    
+    The function calculates the sha512 hash sum for a 128 byte block of data
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] offset a shift to indicate the beginning of the data block for which the hash is to be calculated
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+*/
+constexpr void Sha512Step(const char* data, const std::size_t& offset, std::uint64_t& h0, std::uint64_t& h1, std::uint64_t& h2, std::uint64_t& h3, std::uint64_t& h4, std::uint64_t& h5, std::uint64_t& h6, std::uint64_t& h7) noexcept
+{
+    // Words array
+    std::uint64_t words[80] = {};
+
+    // Join 8 chars from data into 16 uint64_t numbers and save it to words array
+    for (int i = 0; i < 128; i += 8)
+        words[i >> 3] = (static_cast<std::uint64_t>(static_cast<unsigned char>(data[i + offset])) << 56) |
+            (static_cast<std::uint64_t>(static_cast<unsigned char>(data[i + 1 + offset])) << 48) |
+            (static_cast<std::uint64_t>(static_cast<unsigned char>(data[i + 2 +offset])) << 40) |
+            (static_cast<std::uint64_t>(static_cast<unsigned char>(data[i + 3 + offset])) << 32) |
+            (static_cast<std::uint64_t>(static_cast<unsigned char>(data[i + 4 + offset])) << 24) |
+            (static_cast<std::uint64_t>(static_cast<unsigned char>(data[i + 5 + offset])) << 16) |
+            (static_cast<std::uint64_t>(static_cast<unsigned char>(data[i + 6 + offset])) << 8) |
+            static_cast<std::uint64_t>(static_cast<unsigned char>(data[i + 7 + offset]));
+
+    // Fill last 64 uint64_t numbers
+    for (int i = 16; i < 80; ++i)
+        words[i] = words[i - 16] + (RightRotate(words[i - 15], 1) ^ RightRotate(words[i - 15], 8) ^ (words[i - 15] >> 7)) +
+            words[i - 7] + (RightRotate(words[i - 2], 19) ^ RightRotate(words[i - 2], 61) ^ (words[i - 2] >> 6));
+
+    // Temporary variables
+    std::uint64_t a = h0, b = h1, c = h2, d = h3, e = h4, f = h5, g = h6, h = h7;
+
+    // 80 rounds to calculate hash for data block
+    std::uint64_t temp1 = 0, temp2 = 0;
+    for (int i = 0; i < 80; ++i)
+    {
+        temp1 = h + (RightRotate(e, 14) ^ RightRotate(e, 18) ^ RightRotate(e, 41)) + ((e & f) ^ ((~e) & g)) + Sha512K[i] + words[i];
+        temp2 = (RightRotate(a, 28) ^ RightRotate(a, 34) ^ RightRotate(a, 39)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + temp1; d = c; c = b; b = a; a = temp1 + temp2;
+    }
+
+    // Add temporary variables to hash
+    h0 += a, h1 += b, h2 += c, h3 += d, h4 += e, h5 += f, h6 += g, h7 += h;
+}
+
+/**
+    \brief Sha512 hashing steps for a run of blocks
+
+    The function calculates the sha512 hash sum for several consecutive 128 byte blocks of data.
+    The kernel is chosen once at the first call depending on the processor features
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] blocksCount the number of 128 byte blocks in data
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+*/
+SHA2_API void Sha512Steps(const char* data, const std::size_t& blocksCount, std::uint64_t& h0, std::uint64_t& h1, std::uint64_t& h2, std::uint64_t& h3, std::uint64_t& h4, std::uint64_t& h5, std::uint64_t& h6, std::uint64_t& h7) noexcept;
+
+/**
+    \brief Write the internal state variables to the binary hash sum in big endian order
+
+    \param [in] h0 internal state variable 0
+    \param [in] h1 internal state variable 1
+    \param [in] h2 internal state variable 2
+    \param [in] h3 internal state variable 3
+    \param [in] h4 internal state variable 4
+    \param [in] h5 internal state variable 5
+    \param [in] h6 internal state variable 6
+    \param [in] h7 internal state variable 7
+    \param [in] digestLen the length of the hash sum in bytes. Must be less than or equal to 64
+    \param [out] digest a pointer to the array with at least digestLen elements
+*/
+constexpr void StateToDigest(const std::uint64_t& h0, const std::uint64_t& h1, const std::uint64_t& h2, const std::uint64_t& h3, const std::uint64_t& h4, const std::uint64_t& h5, const std::uint64_t& h6, const std::uint64_t& h7, const std::size_t& digestLen, std::uint8_t* digest) noexcept
+{
+    const std::uint64_t state[8] = { h0, h1, h2, h3, h4, h5, h6, h7 };
+
+    for (std::size_t i = 0; i < digestLen; ++i)
+        digest[i] = static_cast<std::uint8_t>(state[i >> 3] >> (56 - ((i & 7) << 3)));
+}
+
+/**
+    \brief A function for calculating the hash sum using the sha512 algorithm
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+*/
+SHA2_API void HashSha512(const char* data, const std::size_t& dataLen, std::uint64_t& h0, std::uint64_t& h1, std::uint64_t& h2, std::uint64_t& h3, std::uint64_t& h4, std::uint64_t& h5, std::uint64_t& h6, std::uint64_t& h7);
+
+/**
+    \brief A function for calculating the hash sum using the sha512 algorithm at compile time
+
+    Unlike HashSha512 the function uses only the portable Sha512Step function, so it can be evaluated in constant expressions
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+*/
+constexpr void ConstexprHashSha512(const char* data, const std::size_t& dataLen, std::uint64_t& h0, std::uint64_t& h1, std::uint64_t& h2, std::uint64_t& h3, std::uint64_t& h4, std::uint64_t& h5, std::uint64_t& h6, std::uint64_t& h7) noexcept
+{
+    // Handle 128 byte chunks
+    std::size_t chunksLen = dataLen & ~static_cast<std::size_t>(127);
+    for (std::size_t offset = 0; offset < chunksLen; offset += 128)
+        Sha512Step(data, offset, h0, h1, h2, h3, h4, h5, h6, h7);
+
+    // Padding source data
+    char padding[256] = {};
+    int paddingLen = DataPaddingSha512(data + chunksLen, dataLen - chunksLen, dataLen, padding);
+
+    // Calculate hash for padded data
+    for (int offset = 0; offset < paddingLen; offset += 128)
+        Sha512Step(padding, offset, h0, h1, h2, h3, h4, h5, h6, h7);
+}
+
+/**
+    \brief A function for calculating the file hash sum using the sha512 algorithm
+
+    The stream is read from the current position to the end in chunks, so the function works with pipes and other files without known size
+
+    \param [in] file stream with a file to calculate the hash for
+    \param [in] chunkSize the size of the chunks to read from the stream. Rounded down to a multiple of 128
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+*/
+SHA2_API void HashFileSha512(std::istream& file, const std::size_t& chunkSize, std::uint64_t& h0, std::uint64_t& h1, std::uint64_t& h2, std::uint64_t& h3, std::uint64_t& h4, std::uint64_t& h5, std::uint64_t& h6, std::uint64_t& h7);
+
+/**
+    \brief A function for calculating the file hash sum using the sha512 algorithm
+
+    Regular files are mapped to memory if it is possible. Pipes, character devices, files that cannot be mapped
+    and files truncated during the hashing are read in chunks
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [in] chunkSize the size of the chunks to read the file, rounded down to a multiple of 128. For mapped files the size of the read ahead windows, rounded down to a multiple of the page size
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+
+    \return true if the hash was calculated, false if the file cannot be opened or read. The state variables are undefined then
+*/
+SHA2_API bool HashFileSha512(const std::string& fileName, const std::size_t& chunkSize, std::uint64_t& h0, std::uint64_t& h1, std::uint64_t& h2, std::uint64_t& h3, std::uint64_t& h4, std::uint64_t& h5, std::uint64_t& h6, std::uint64_t& h7);
+
+/**
+    \brief A function for calculating the hash sums of many independent messages using the sha512 compression function
+
+    If the processor supports AVX-512 or AVX2 the messages are hashed in 8 or 4 parallel SIMD lanes,
+    otherwise every message is hashed separately with the HashSha512 function
+
+    \param [in] data an array of pointers to the messages
+    \param [in] dataLens an array of the messages lengths
+    \param [in] count the number of messages
+    \param [in] beginHash begin hash values of the algorithm
+    \param [out] hashes an array for the internal state variables of the messages. The state variable i of the message j is written to hashes[j * 8 + i]
+*/
+SHA2_API void HashSha512Batch(const char* const* data, const std::size_t* dataLens, const std::size_t& count, const std::uint64_t* beginHash, std::uint64_t* hashes) noexcept;
+
+/// \brief Sha512 kernel of the library. The kernels can be measured and checked separately from the dispatch
+struct Sha512Kernel
+{
+    // Name of the kernel
+    const char* name;
+
+    // Number of messages hashed together in parallel SIMD lanes, 1 for the kernels hashing one message at a time
+    std::size_t lanesCount;
+
+    // Function for calculating the hash sums of many messages with the kernel, with the same arguments as the HashSha512Batch function
+    void (*hash)(const char* const* data, const std::size_t* dataLens, const std::size_t& count, const std::uint64_t* beginHash, std::uint64_t* hashes) noexcept;
+};
+
+/**
+    \brief A function for getting the sha512 kernels supported by the processor
+
+    The first kernel is the portable scalar one, the other ones are the hardware accelerated single message and multi-lane kernels
+
+    \return the kernels
+*/
+SHA2_API std::vector<Sha512Kernel> GetSha512Kernels();
+
+/**
+    \brief A function for calculating the internal state variables of many messages using the sha512 compression function
+
+    \param [in] messages the strings to calculate the hashes for
+    \param [in] beginHash begin hash values of the algorithm
+
+    \return a vector with the internal state variables of the messages. The state variable i of the message j is stored at index j * 8 + i
+*/
+SHA2_API std::vector<std::uint64_t> HashSha512Batch(const std::vector<std::string>& messages, const std::uint64_t* beginHash) noexcept;
+
+/// \brief Binary sha512 hash sum
+typedef std::array<std::uint8_t, 64> Sha512Digest;
+
+/// \brief Binary sha384 hash sum
+typedef std::array<std::uint8_t, 48> Sha384Digest;
+
+/// \brief Binary sha512/224 hash sum
+typedef std::array<std::uint8_t, 28> Sha512_224Digest;
+
+/// \brief Binary sha512/256 hash sum
+typedef std::array<std::uint8_t, 32> Sha512_256Digest;
+
+/**
+    \brief A function for calculating the binary hash sum using the sha512 algorithm at compile time
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return an array with a sha512 hash sum
+*/
+constexpr Sha512Digest ConstexprSha512(const char* data, const std::size_t& dataLen) noexcept
+{
+    // Begin hash values
+    std::uint64_t h0 = 0x6a09e667f3bcc908, h1 = 0xbb67ae8584caa73b, h2 = 0x3c6ef372fe94f82b, h3 = 0xa54ff53a5f1d36f1, h4 = 0x510e527fade682d1, h5 = 0x9b05688c2b3e6c1f, h6 = 0x1f83d9abfb41bd6b, h7 = 0x5be0cd19137e2179;
+
+    // Calculate hash
+    ConstexprHashSha512(data, dataLen, h0, h1, h2, h3, h4, h5, h6, h7);
+
+    // Return calculated hash
+    Sha512Digest res = {};
+    StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, res.size(), res.data());
+    return res;
+}
+
+/**
+    \brief A function for calculating the binary hash sum of a string literal using the sha512 algorithm at compile time
+
+    \param [in] str the string literal to calculate the hash for. The terminating null character is not hashed
+
+    \return an array with a sha512 hash sum
+*/
+template <std::size_t N>
+constexpr Sha512Digest ConstexprSha512(const char (&str)[N]) noexcept
+{
+    return ConstexprSha512(str, N - 1);
+}
+
+/**
+    \brief A function for calculating the binary hash sum using the sha384 algorithm at compile time
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return an array with a sha384 hash sum
+*/
+constexpr Sha384Digest ConstexprSha384(const char* data, const std::size_t& dataLen) noexcept
+{
+    // Begin hash values
+    std::uint64_t h0 = 0xcbbb9d5dc1059ed8, h1 = 0x629a292a367cd507, h2 = 0x9159015a3070dd17, h3 = 0x152fecd8f70e5939, h4 = 0x67332667ffc00b31, h5 = 0x8eb44a8768581511, h6 = 0xdb0c2e0d64f98fa7, h7 = 0x47b5481dbefa4fa4;
+
+    // Calculate hash
+    ConstexprHashSha512(data, dataLen, h0, h1, h2, h3, h4, h5, h6, h7);
+
+    // Return calculated hash
+    Sha384Digest res = {};
+    StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, res.size(), res.data());
+    return res;
+}
+
+/**
+    \brief A function for calculating the binary hash sum of a string literal using the sha384 algorithm at compile time
+
+    \param [in] str the string literal to calculate the hash for. The terminating null character is not hashed
+
+    \return an array with a sha384 hash sum
+*/
+template <std::size_t N>
+constexpr Sha384Digest ConstexprSha384(const char (&str)[N]) noexcept
+{
+    return ConstexprSha384(str, N - 1);
+}
+
+/**
+    \brief A function for calculating the binary hash sum using the sha512/224 algorithm at compile time
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return an array with a sha512/224 hash sum
+*/
+constexpr Sha512_224Digest ConstexprSha512_224(const char* data, const std::size_t& dataLen) noexcept
+{
+    // Begin hash values
+    std::uint64_t h0 = 0x8c3d37c819544da2, h1 = 0x73e1996689dcd4d6, h2 = 0x1dfab7ae32ff9c82, h3 = 0x679dd514582f9fcf, h4 = 0x0f6d2b697bd44da8, h5 = 0x77e36f7304c48942, h6 = 0x3f9d85a86a1d36c8, h7 = 0x1112e6ad91d692a1;
+
+    // Calculate hash
+    ConstexprHashSha512(data, dataLen, h0, h1, h2, h3, h4, h5, h6, h7);
+
+    // Return calculated hash
+    Sha512_224Digest res = {};
+    StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, res.size(), res.data());
+    return res;
+}
+
+/**
+    \brief A function for calculating the binary hash sum of a string literal using the sha512/224 algorithm at compile time
+
+    \param [in] str the string literal to calculate the hash for. The terminating null character is not hashed
+
+    \return an array with a sha512/224 hash sum
+*/
+template <std::size_t N>
+constexpr Sha512_224Digest ConstexprSha512_224(const char (&str)[N]) noexcept
+{
+    return ConstexprSha512_224(str, N - 1);
+}
+
+/**
+    \brief A function for calculating the binary hash sum using the sha512/256 algorithm at compile time
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return an array with a sha512/256 hash sum
+*/
+constexpr Sha512_256Digest ConstexprSha512_256(const char* data, const std::size_t& dataLen) noexcept
+{
+    // Begin hash values
+    std::uint64_t h0 = 0x22312194fc2bf72c, h1 = 0x9f555fa3c84c64c2, h2 = 0x2393b86b6f53b151, h3 = 0x963877195940eabd, h4 = 0x96283ee2a88effe3, h5 = 0xbe5e1e2553863992, h6 = 0x2b0199fc2c85b8aa, h7 = 0x0eb72ddc81c52ca2;
+
+    // Calculate hash
+    ConstexprHashSha512(data, dataLen, h0, h1, h2, h3, h4, h5, h6, h7);
+
+    // Return calculated hash
+    Sha512_256Digest res = {};
+    StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, res.size(), res.data());
+    return res;
+}
+
+/**
+    \brief A function for calculating the binary hash sum of a string literal using the sha512/256 algorithm at compile time
+
+    \param [in] str the string literal to calculate the hash for. The terminating null character is not hashed
+
+    \return an array with a sha512/256 hash sum
+*/
+template <std::size_t N>
+constexpr Sha512_256Digest ConstexprSha512_256(const char (&str)[N]) noexcept
+{
+    return ConstexprSha512_256(str, N - 1);
+}
+
+/**
+    \brief A function for calculating the binary hash sum using the sha512 algorithm
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return an array with a sha512 hash sum
+*/
+SHA2_API Sha512Digest Sha512Binary(const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the binary hash sum using the sha512 algorithm
+
+    \param [in] str the string to calculate the hash for
+
+    \return an array with a sha512 hash sum
+*/
+SHA2_API Sha512Digest Sha512Binary(const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the binary file hash sum using the sha512 algorithm
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [out] digest an array for a sha512 hash sum
+    \param [in] chunkSize the size of the chunks to read the file, rounded down to a multiple of 128. For files mapped to memory the size of the read ahead windows
+
+    \return true if the hash was calculated, false if the file cannot be opened or read
+*/
+SHA2_API bool FileSha512Binary(const std::string& fileName, Sha512Digest& digest, const std::size_t& chunkSize = CHUNK_SIZE) noexcept;
+
+/**
+    \brief A function for calculating the hash sum using the sha512 algorithm
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return a string with a sha512 hash sum
+*/
+SHA2_API std::string Sha512(const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the hash sum using the sha512 algorithm
+
+    \param [in] str the string to calculate the hash for
+
+    \return a string with a sha512 hash sum
+*/
+SHA2_API std::string Sha512(const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the file hash sum using the sha512 algorithm
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [in] chunkSize the size of the chunks to read the file, rounded down to a multiple of 128. For files mapped to memory the size of the read ahead windows
+
+    \return a string with a sha512 hash sum
+*/
+SHA2_API std::string FileSha512(const std::string& fileName, const std::size_t& chunkSize = CHUNK_SIZE) noexcept;
+
+/**
+    \brief A function for calculating the binary hash sum using the sha384 algorithm
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return an array with a sha384 hash sum
+*/
+SHA2_API Sha384Digest Sha384Binary(const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the binary hash sum using the sha384 algorithm
+
+    \param [in] str the string to calculate the hash for
+
+    \return an array with a sha384 hash sum
+*/
+SHA2_API Sha384Digest Sha384Binary(const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the binary file hash sum using the sha384 algorithm
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [out] digest an array for a sha384 hash sum
+    \param [in] chunkSize the size of the chunks to read the file, rounded down to a multiple of 128. For files mapped to memory the size of the read ahead windows
+
+    \return true if the hash was calculated, false if the file cannot be opened or read
+*/
+SHA2_API bool FileSha384Binary(const std::string& fileName, Sha384Digest& digest, const std::size_t& chunkSize = CHUNK_SIZE) noexcept;
+
+/**
+    \brief A function for calculating the hash sum using the sha384 algorithm
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return a string with a sha384 hash sum
+*/
+SHA2_API std::string Sha384(const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the hash sum using the sha384 algorithm
+
+    \param [in] str the string to calculate the hash for
+
+    \return a string with a sha384 hash sum
+*/
+SHA2_API std::string Sha384(const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the file hash sum using the sha384 algorithm
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [in] chunkSize the size of the chunks to read the file, rounded down to a multiple of 128. For files mapped to memory the size of the read ahead windows
+
+    \return a string with a sha384 hash sum
+*/
+SHA2_API std::string FileSha384(const std::string& fileName, const std::size_t& chunkSize = CHUNK_SIZE) noexcept;
+
+/**
+    \brief A function for calculating the binary hash sum using the sha512/224 algorithm
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return an array with a sha512/224 hash sum
+*/
+SHA2_API Sha512_224Digest Sha512_224Binary(const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the binary hash sum using the sha512/224 algorithm
+
+    \param [in] str the string to calculate the hash for
+
+    \return an array with a sha512/224 hash sum
+*/
+SHA2_API Sha512_224Digest Sha512_224Binary(const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the binary file hash sum using the sha512/224 algorithm
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [out] digest an array for a sha512/224 hash sum
+    \param [in] chunkSize the size of the chunks to read the file, rounded down to a multiple of 128. For files mapped to memory the size of the read ahead windows
+
+    \return true if the hash was calculated, false if the file cannot be opened or read
+*/
+SHA2_API bool FileSha512_224Binary(const std::string& fileName, Sha512_224Digest& digest, const std::size_t& chunkSize = CHUNK_SIZE) noexcept;
+
+/**
+    \brief A function for calculating the hash sum using the sha512/224 algorithm
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return a string with a sha512/224 hash sum
+*/
+SHA2_API std::string Sha512_224(const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the hash sum using the sha512/224 algorithm
+
+    \param [in] str the string to calculate the hash for
+
+    \return a string with a sha512/224 hash sum
+*/
+SHA2_API std::string Sha512_224(const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the file hash sum using the sha512/224 algorithm
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [in] chunkSize the size of the chunks to read the file, rounded down to a multiple of 128. For files mapped to memory the size of the read ahead windows
+
+    \return a string with a sha512/224 hash sum
+*/
+SHA2_API std::string FileSha512_224(const std::string& fileName, const std::size_t& chunkSize = CHUNK_SIZE) noexcept;
+
+/**
+    \brief A function for calculating the binary hash sum using the sha512/256 algorithm
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return an array with a sha512/256 hash sum
+*/
+SHA2_API Sha512_256Digest Sha512_256Binary(const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the binary hash sum using the sha512/256 algorithm
+
+    \param [in] str the string to calculate the hash for
+
+    \return an array with a sha512/256 hash sum
+*/
+SHA2_API Sha512_256Digest Sha512_256Binary(const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the binary file hash sum using the sha512/256 algorithm
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [out] digest an array for a sha512/256 hash sum
+    \param [in] chunkSize the size of the chunks to read the file, rounded down to a multiple of 128. For files mapped to memory the size of the read ahead windows
+
+    \return true if the hash was calculated, false if the file cannot be opened or read
+*/
+SHA2_API bool FileSha512_256Binary(const std::string& fileName, Sha512_256Digest& digest, const std::size_t& chunkSize = CHUNK_SIZE) noexcept;
+
+/**
+    \brief A function for calculating the hash sum using the sha512/256 algorithm
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] dataLen data array length
+
+    \return a string with a sha512/256 hash sum
+*/
+SHA2_API std::string Sha512_256(const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the hash sum using the sha512/256 algorithm
+
+    \param [in] str the string to calculate the hash for
+
+    \return a string with a sha512/256 hash sum
+*/
+SHA2_API std::string Sha512_256(const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the file hash sum using the sha512/256 algorithm
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [in] chunkSize the size of the chunks to read the file, rounded down to a multiple of 128. For files mapped to memory the size of the read ahead windows
+
+    \return a string with a sha512/256 hash sum
+*/
+SHA2_API std::string FileSha512_256(const std::string& fileName, const std::size_t& chunkSize = CHUNK_SIZE) noexcept;
+
+/**
+    \brief A function for calculating the hash sums of many messages using the sha512 algorithm
+
+    The messages are hashed in parallel SIMD lanes if the processor supports it
+
+    \param [in] messages the strings to calculate the hashes for
+
+    \return a vector with sha512 hash sums in the order of messages
+*/
+SHA2_API std::vector<std::string> Sha512Batch(const std::vector<std::string>& messages) noexcept;
+
+/**
+    \brief A function for calculating the hash sums of many messages using the sha384 algorithm
+
+    The messages are hashed in parallel SIMD lanes if the processor supports it
+
+    \param [in] messages the strings to calculate the hashes for
+
+    \return a vector with sha384 hash sums in the order of messages
+*/
+SHA2_API std::vector<std::string> Sha384Batch(const std::vector<std::string>& messages) noexcept;
+
+/**
+    \brief A function for calculating the hash sums of many messages using the sha512/224 algorithm
+
+    The messages are hashed in parallel SIMD lanes if the processor supports it
+
+    \param [in] messages the strings to calculate the hashes for
+
+    \return a vector with sha512/224 hash sums in the order of messages
+*/
+SHA2_API std::vector<std::string> Sha512_224Batch(const std::vector<std::string>& messages) noexcept;
+
+/**
+    \brief A function for calculating the hash sums of many messages using the sha512/256 algorithm
+
+    The messages are hashed in parallel SIMD lanes if the processor supports it
+
+    \param [in] messages the strings to calculate the hashes for
+
+    \return a vector with sha512/256 hash sums in the order of messages
+*/
+SHA2_API std::vector<std::string> Sha512_256Batch(const std::vector<std::string>& messages) noexcept;
+
+/**
+    \brief A function for calculating the parent nodes of a Merkle tree level using the sha512 algorithm
+
+    Every parent is sha512(left || right) of two adjacent 64 byte children. The message is always 128 bytes,
+    so the padding is not built: the second block is constant and its message schedule is precomputed.
+    If the processor supports AVX-512 or AVX2 the parents are hashed in parallel SIMD lanes
+
+    \param [in] children the binary children one after another, 2 * count digests of 64 bytes
+    \param [in] count the number of parents
+    \param [out] parents the binary parents one after another, 64 bytes each
+*/
+SHA2_API void HashSha512Nodes(const std::uint8_t* children, const std::size_t& count, std::uint8_t* parents) noexcept;
+
+/// \brief Sha2 algorithms based on the sha512 compression function
+enum class Sha512Variant
+{
+    Sha512,
+    Sha384,
+    Sha512_224,
+    Sha512_256
+};
+
+/**
+    \brief Context for the incremental calculation of the hash sum using the sha512, sha384, sha512/224 or sha512/256 algorithm
+
+    Data can be passed to the context in parts of arbitrary length using the Update method.
+    Complete 128 byte blocks are hashed directly from the passed data, only the incomplete tail is buffered inside the context.
+    The Final method pads the data, returns the hash sum and resets the context, so the object can be reused
+*/
+class Sha512Context
+{
+private:
+    // Internal state variables
+    std::uint64_t h0, h1, h2, h3, h4, h5, h6, h7;
+
+    // Buffer for the incomplete 128 byte block
+    char buffer[128];
+
+    // Number of bytes in buffer
+    std::size_t bufferLen;
+
+    // Total length of the data passed to the context
+    std::uint64_t dataLen;
+
+    // Hashing algorithm
+    Sha512Variant variant;
+
+public:
+    /// \brief Context constructor
+    /// \param [in] variant hashing algorithm to use
+    Sha512Context(const Sha512Variant& variant = Sha512Variant::Sha512) noexcept : variant(variant)
+    {
+        Reset();
+    }
+
+    /// \brief Method for resetting the context to the begin state of the algorithm
+    void Reset() noexcept
+    {
+        // Begin hash values
+        switch (variant)
+        {
+        case Sha512Variant::Sha384:
+            h0 = 0xcbbb9d5dc1059ed8, h1 = 0x629a292a367cd507, h2 = 0x9159015a3070dd17, h3 = 0x152fecd8f70e5939, h4 = 0x67332667ffc00b31, h5 = 0x8eb44a8768581511, h6 = 0xdb0c2e0d64f98fa7, h7 = 0x47b5481dbefa4fa4;
+            break;
+        case Sha512Variant::Sha512_224:
+            h0 = 0x8c3d37c819544da2, h1 = 0x73e1996689dcd4d6, h2 = 0x1dfab7ae32ff9c82, h3 = 0x679dd514582f9fcf, h4 = 0x0f6d2b697bd44da8, h5 = 0x77e36f7304c48942, h6 = 0x3f9d85a86a1d36c8, h7 = 0x1112e6ad91d692a1;
+            break;
+        case Sha512Variant::Sha512_256:
+            h0 = 0x22312194fc2bf72c, h1 = 0x9f555fa3c84c64c2, h2 = 0x2393b86b6f53b151, h3 = 0x963877195940eabd, h4 = 0x96283ee2a88effe3, h5 = 0xbe5e1e2553863992, h6 = 0x2b0199fc2c85b8aa, h7 = 0x0eb72ddc81c52ca2;
+            break;
+        default:
+            h0 = 0x6a09e667f3bcc908, h1 = 0xbb67ae8584caa73b, h2 = 0x3c6ef372fe94f82b, h3 = 0xa54ff53a5f1d36f1, h4 = 0x510e527fade682d1, h5 = 0x9b05688c2b3e6c1f, h6 = 0x1f83d9abfb41bd6b, h7 = 0x5be0cd19137e2179;
+            break;
+        }
+
+        bufferLen = 0;
+        dataLen = 0;
+    }
+
+    /**
+        \brief Method for adding the next part of the data to the hash sum
+
+        \param [in] data a pointer to the array with the next part of the data
+        \param [in] len data array length
+    */
+    void Update(const char* data, const std::size_t& len) noexcept
+    {
+        dataLen += len;
+
+        // Offset of the first unprocessed byte in data
+        std::size_t offset = 0;
+
+        // Complete the buffered block
+        if (bufferLen > 0)
+        {
+            offset = std::min(len, 128 - bufferLen);
+            memcpy(buffer + bufferLen, data, offset);
+            bufferLen += offset;
+
+            // Check if the block is still incomplete
+            if (bufferLen < 128)
+                return;
+
+            Sha512Steps(buffer, 1, h0, h1, h2, h3, h4, h5, h6, h7);
+            bufferLen = 0;
+        }
+
+        // Handle 128 byte chunks directly from data
+        Sha512Steps(data + offset, (len - offset) >> 7, h0, h1, h2, h3, h4, h5, h6, h7);
+        offset += (len - offset) & ~static_cast<std::size_t>(0b01111111);
+
+        // Save the incomplete block to buffer
+        bufferLen = len - offset;
+        memcpy(buffer, data + offset, bufferLen);
+    }
+
+    /**
+        \brief Method for adding the next part of the data to the hash sum
+
+        \param [in] str the string with the next part of the data
+    */
+    void Update(const std::string& str) noexcept
+    {
+        Update(str.c_str(), str.length());
+    }
+
+    /**
+        \brief Method for finishing the hash sum calculation
+
+        After calling this method the context is reset to the begin state
+
+        \param [out] digest a pointer to the array for the binary hash sum. The length of the array must be at least the hash sum length of the context variant, 64 bytes is always enough
+
+        \return the length of the hash sum in bytes
+    */
+    std::size_t Final(std::uint8_t* digest) noexcept
+    {
+        // Padding buffered data
+        char padding[256];
+        int paddingLen = DataPaddingSha512(buffer, bufferLen, dataLen, padding);
+
+        // Calculate hash for padded data
+        Sha512Steps(padding, paddingLen >> 7, h0, h1, h2, h3, h4, h5, h6, h7);
+
+        std::size_t digestLen;
+        switch (variant)
+        {
+        case Sha512Variant::Sha384:
+            digestLen = 48;
+            break;
+        case Sha512Variant::Sha512_224:
+            digestLen = 28;
+            break;
+        case Sha512Variant::Sha512_256:
+            digestLen = 32;
+            break;
+        default:
+            digestLen = 64;
+            break;
+        }
+        StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, digestLen, digest);
+
+        Reset();
+        return digestLen;
+    }
+
+    /**
+        \brief Method for finishing the hash sum calculation
+
+        After calling this method the context is reset to the begin state
+
+        \return a string with a hash sum
+    */
+    std::string Final() noexcept
+    {
+        std::uint8_t digest[64];
+        std::size_t digestLen = Final(digest);
+
+        std::string res(digestLen * 2, 0);
+        BytesToHex(digest, digestLen, &res[0]);
+        return res;
+    }
+
+    /// \brief Method for getting the hashing algorithm of the context
+    /// \return hashing algorithm
+    Sha512Variant Variant() const noexcept
+    {
+        return variant;
+    }
+
+    /// \brief Method for getting the length of the data passed to the context
+    /// \return the number of bytes
+    std::uint64_t Length() const noexcept
+    {
+        return dataLen;
+    }
+
+    /**
+        \brief Method for exporting the state of the context
+
+        The state is a compact binary blob: format version, hashing algorithm, length of the data, internal state variables and the incomplete block.
+        The blob is at most 201 bytes long
+
+        \return a string with the state
+    */
+    std::string Export() const
+    {
+        std::string res(74 + bufferLen, 0);
+
+        res[0] = 1;
+        res[1] = static_cast<char>(variant);
+        Uint64ToBytes(dataLen, &res[2]);
+
+        const std::uint64_t state[8] = { h0, h1, h2, h3, h4, h5, h6, h7 };
+        for (int i = 0; i < 8; ++i)
+            Uint64ToBytes(state[i], &res[10 + i * 8]);
+
+        memcpy(&res[74], buffer, bufferLen);
+        return res;
+    }
+
+    /**
+        \brief Method for importing the state exported by the Export method
+
+        The hashing algorithm of the context is replaced with the algorithm from the state
+
+        \param [in] state the string with the state
+
+        \return true if the state was imported, false if the state is damaged. In this case the context is not changed
+    */
+    bool Import(const std::string& state) noexcept
+    {
+        // Check the format version, the algorithm and the length of the incomplete block
+        if (state.length() < 74 || state.length() >= 202 || state[0] != 1 || state[1] < 0 || state[1] > static_cast<char>(Sha512Variant::Sha512_256))
+            return false;
+
+        std::uint64_t len = BytesToUint64(&state[2]);
+        if ((len & 127) != state.length() - 74)
+            return false;
+
+        variant = static_cast<Sha512Variant>(state[1]);
+        dataLen = len;
+
+        h0 = BytesToUint64(&state[10]), h1 = BytesToUint64(&state[18]), h2 = BytesToUint64(&state[26]), h3 = BytesToUint64(&state[34]);
+        h4 = BytesToUint64(&state[42]), h5 = BytesToUint64(&state[50]), h6 = BytesToUint64(&state[58]), h7 = BytesToUint64(&state[66]);
+
+        bufferLen = state.length() - 74;
+        memcpy(buffer, &state[74], bufferLen);
+        return true;
+    }
+};
+
+/**
+    \brief A function for calculating the file hash sum with periodic checkpoints
+
+    The hashing continues from the length of the data already passed to the context,
+    so a context imported from a checkpoint hashes only the rest of the file
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [in, out] context the context with the state of the already hashed beginning of the file. The context is not finished
+    \param [in] checkpoint the function called with the exported state of the context after every checkpointInterval bytes
+    \param [in] checkpointInterval the number of bytes between checkpoints
+    \param [in] chunkSize the size of the chunks to read the file
+
+    \return true if the whole file was hashed, false if the file cannot be read or is shorter than the already hashed length
+*/
+SHA2_API bool HashFileSha512Resumable(const std::string& fileName, Sha512Context& context, const std::function<void(const std::string&)>& checkpoint, const std::uint64_t& checkpointInterval = CHECKPOINT_INTERVAL, const std::size_t& chunkSize = CHUNK_SIZE);
+
+/**
+    \brief A function for calculating the file hash sum using the sha512 family algorithm which can be resumed after interruption
+
+    The state of the hashing is saved to the checkpoint file periodically. If the checkpoint file exists, the hashing continues from the saved state.
+    The checkpoint stores the device, inode, size and modification time of the file, the state saved for another version of the file is discarded.
+    The checkpoint file is replaced atomically and durably and removed after the hash sum is calculated
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [in] checkpointFileName the string with the name of the checkpoint file
+    \param [in] variant hashing algorithm to use
+    \param [in] checkpointInterval the number of bytes between checkpoints
+    \param [in] chunkSize the size of the chunks to read the file
+
+    \return a string with a hash sum
+*/
+SHA2_API std::string ResumableFileSha512(const std::string& fileName, const std::string& checkpointFileName, const Sha512Variant& variant = Sha512Variant::Sha512, const std::uint64_t& checkpointInterval = CHECKPOINT_INTERVAL, const std::size_t& chunkSize = CHUNK_SIZE) noexcept;
+
+/// \brief Snapshot of the sha512 family state after a common prefix of many messages
+class Sha512Prefix
+{
+private:
+    // Context after processing the prefix
+    Sha512Context context;
+
+public:
+    /**
+        \brief Prefix constructor
+
+        The full blocks of the prefix are compressed once, the rest of the prefix is kept in the context buffer
+
+        \param [in] prefix a pointer to the array with the prefix
+        \param [in] prefixLen prefix array length
+        \param [in] variant hashing algorithm to use
+    */
+    Sha512Prefix(const char* prefix, const std::size_t& prefixLen, const Sha512Variant& variant = Sha512Variant::Sha512) noexcept : context(variant)
+    {
+        context.Update(prefix, prefixLen);
+    }
+
+    /**
+        \brief Prefix constructor
+
+        \param [in] prefix the string with the prefix
+        \param [in] variant hashing algorithm to use
+    */
+    Sha512Prefix(const std::string& prefix, const Sha512Variant& variant = Sha512Variant::Sha512) noexcept : Sha512Prefix(prefix.c_str(), prefix.length(), variant) {}
+
+    /// \brief Method for getting the context after processing the prefix
+    /// \return a context to continue hashing with
+    const Sha512Context& Context() const noexcept
+    {
+        return context;
+    }
+
+    /**
+        \brief Method for calculating the hash sum of the prefix followed by the suffix
+
+        \param [in] suffix a pointer to the array with the suffix
+        \param [in] suffixLen suffix array length
+        \param [out] digest a pointer to the array for the binary hash sum. 64 bytes is always enough
+
+        \return the length of the hash sum in bytes
+    */
+    std::size_t Hash(const char* suffix, const std::size_t& suffixLen, std::uint8_t* digest) const noexcept
+    {
+        Sha512Context res = context;
+        res.Update(suffix, suffixLen);
+        return res.Final(digest);
+    }
+
+    /**
+        \brief Method for calculating the hash sum of the prefix followed by the suffix
+
+        \param [in] suffix the string with the suffix
+
+        \return a string with a hash sum
+    */
+    std::string Hash(const std::string& suffix) const noexcept
+    {
+        Sha512Context res = context;
+        res.Update(suffix);
+        return res.Final();
+    }
+};
+
+/// \brief Thread safe cache of the sha512 family prefix states with the least recently used eviction
+class Sha512PrefixCache
+{
+private:
+    // Cached prefix and its position in the usage order
+    struct Entry
+    {
+        Sha512Prefix prefix;
+        std::list<const std::string*>::iterator position;
+    };
+
+    // Maximum number of cached prefixes
+    std::size_t capacity;
+
+    // Cached prefixes. The key is the algorithm followed by the prefix
+    std::unordered_map<std::string, Entry> entries;
+
+    // Keys of the cached prefixes from the most recently used to the least recently used
+    std::list<const std::string*> order;
+
+    // Mutex for entries and order
+    std::mutex mutex;
+
+public:
+    /// \brief Cache constructor
+    /// \param [in] capacity maximum number of cached prefixes
+    Sha512PrefixCache(const std::size_t& capacity = 64) noexcept : capacity(std::max(capacity, static_cast<std::size_t>(1))) {}
+
+    /**
+        \brief Method for getting the state after the prefix
+
+        The prefix is compressed only if it is not in the cache. The least recently used prefix is evicted when the cache is full
+
+        \param [in] prefix a pointer to the array with the prefix
+        \param [in] prefixLen prefix array length
+        \param [in] variant hashing algorithm to use
+
+        \return a snapshot of the state after the prefix
+    */
+    Sha512Prefix Prefix(const char* prefix, const std::size_t& prefixLen, const Sha512Variant& variant = Sha512Variant::Sha512)
+    {
+        std::string key(1 + prefixLen, static_cast<char>(variant));
+        memcpy(&key[1], prefix, prefixLen);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto entry = entries.find(key);
+            if (entry != entries.end())
+            {
+                order.splice(order.begin(), order, entry->second.position);
+                return entry->second.prefix;
+            }
+        }
+
+        // Compress the prefix without holding the lock
+        Sha512Prefix res(prefix, prefixLen, variant);
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Other thread could add the same prefix
+        if (entries.find(key) != entries.end())
+            return res;
+
+        if (entries.size() == capacity)
+        {
+            entries.erase(*order.back());
+            order.pop_back();
+        }
+
+        auto entry = entries.emplace(std::move(key), Entry{ res, order.end() }).first;
+        order.push_front(&entry->first);
+        entry->second.position = order.begin();
+
+        return res;
+    }
+
+    /**
+        \brief Method for calculating the hash sum of the prefix followed by the suffix
+
+        \param [in] prefix a pointer to the array with the prefix
+        \param [in] prefixLen prefix array length
+        \param [in] suffix a pointer to the array with the suffix
+        \param [in] suffixLen suffix array length
+        \param [out] digest a pointer to the array for the binary hash sum. 64 bytes is always enough
+        \param [in] variant hashing algorithm to use
+
+        \return the length of the hash sum in bytes
+    */
+    std::size_t Hash(const char* prefix, const std::size_t& prefixLen, const char* suffix, const std::size_t& suffixLen, std::uint8_t* digest, const Sha512Variant& variant = Sha512Variant::Sha512)
+    {
+        return Prefix(prefix, prefixLen, variant).Hash(suffix, suffixLen, digest);
+    }
+
+    /**
+        \brief Method for calculating the hash sum of the prefix followed by the suffix
+
+        \param [in] prefix the string with the prefix
+        \param [in] suffix the string with the suffix
+        \param [in] variant hashing algorithm to use
+
+        \return a string with a hash sum
+    */
+    std::string Hash(const std::string& prefix, const std::string& suffix, const Sha512Variant& variant = Sha512Variant::Sha512)
+    {
+        return Prefix(prefix.c_str(), prefix.length(), variant).Hash(suffix);
+    }
+
+    /// \brief Method for removing all prefixes from the cache
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.clear();
+        order.clear();
+    }
+};
+
+/// \brief Hmac key with the precomputed internal states of the sha512 family algorithms
+class HmacSha512Key
+{
+private:
+    // Internal state after processing the key block xored with ipad
+    std::uint64_t innerState[8];
+
+    // Internal state after processing the key block xored with opad
+    std::uint64_t outerState[8];
+
+    // Hashing algorithm
+    Sha512Variant variant;
+
+public:
+    /**
+        \brief Key constructor
+
+        The key is padded to the block size, xored with ipad and opad and both blocks are hashed once, so each message authentication code costs only the message blocks and one outer block
+
+        \param [in] key a pointer to the array with the key
+        \param [in] keyLen key array length
+        \param [in] variant hashing algorithm to use
+    */
+    HmacSha512Key(const char* key, const std::size_t& keyLen, const Sha512Variant& variant = Sha512Variant::Sha512) noexcept : variant(variant)
+    {
+        // Key block. Keys longer than the block are hashed
+        char keyBlock[128] = {};
+        if (keyLen > 128)
+        {
+            Sha512Context context(variant);
+            context.Update(key, keyLen);
+            context.Final(reinterpret_cast<std::uint8_t*>(keyBlock));
+        }
+        else
+            memcpy(keyBlock, key, keyLen);
+
+        // Begin hash values
+        std::uint64_t beginState[8];
+        switch (variant)
+        {
+        case Sha512Variant::Sha384:
+            beginState[0] = 0xcbbb9d5dc1059ed8, beginState[1] = 0x629a292a367cd507, beginState[2] = 0x9159015a3070dd17, beginState[3] = 0x152fecd8f70e5939, beginState[4] = 0x67332667ffc00b31, beginState[5] = 0x8eb44a8768581511, beginState[6] = 0xdb0c2e0d64f98fa7, beginState[7] = 0x47b5481dbefa4fa4;
+            break;
+        case Sha512Variant::Sha512_224:
+            beginState[0] = 0x8c3d37c819544da2, beginState[1] = 0x73e1996689dcd4d6, beginState[2] = 0x1dfab7ae32ff9c82, beginState[3] = 0x679dd514582f9fcf, beginState[4] = 0x0f6d2b697bd44da8, beginState[5] = 0x77e36f7304c48942, beginState[6] = 0x3f9d85a86a1d36c8, beginState[7] = 0x1112e6ad91d692a1;
+            break;
+        case Sha512Variant::Sha512_256:
+            beginState[0] = 0x22312194fc2bf72c, beginState[1] = 0x9f555fa3c84c64c2, beginState[2] = 0x2393b86b6f53b151, beginState[3] = 0x963877195940eabd, beginState[4] = 0x96283ee2a88effe3, beginState[5] = 0xbe5e1e2553863992, beginState[6] = 0x2b0199fc2c85b8aa, beginState[7] = 0x0eb72ddc81c52ca2;
+            break;
+        default:
+            beginState[0] = 0x6a09e667f3bcc908, beginState[1] = 0xbb67ae8584caa73b, beginState[2] = 0x3c6ef372fe94f82b, beginState[3] = 0xa54ff53a5f1d36f1, beginState[4] = 0x510e527fade682d1, beginState[5] = 0x9b05688c2b3e6c1f, beginState[6] = 0x1f83d9abfb41bd6b, beginState[7] = 0x5be0cd19137e2179;
+            break;
+        }
+        memcpy(innerState, beginState, sizeof(beginState));
+        memcpy(outerState, innerState, sizeof(innerState));
+
+        // Hash the key blocks xored with ipad and opad
+        char padBlock[128];
+        for (int i = 0; i < 128; ++i)
+            padBlock[i] = keyBlock[i] ^ 0x36;
+        Sha512Steps(padBlock, 1, innerState[0], innerState[1], innerState[2], innerState[3], innerState[4], innerState[5], innerState[6], innerState[7]);
+
+        for (int i = 0; i < 128; ++i)
+            padBlock[i] = keyBlock[i] ^ 0x5c;
+        Sha512Steps(padBlock, 1, outerState[0], outerState[1], outerState[2], outerState[3], outerState[4], outerState[5], outerState[6], outerState[7]);
+    }
+
+    /**
+        \brief Key constructor
+
+        \param [in] key the string with the key
+        \param [in] variant hashing algorithm to use
+    */
+    HmacSha512Key(const std::string& key, const Sha512Variant& variant = Sha512Variant::Sha512) noexcept : HmacSha512Key(key.c_str(), key.length(), variant) {}
+
+    /// \brief Method for getting the hashing algorithm of the key
+    /// \return hashing algorithm
+    Sha512Variant Variant() const noexcept
+    {
+        return variant;
+    }
+
+    /**
+        \brief Method for getting the internal state after processing the key block xored with ipad
+
+        \param [out] state a pointer to the array with at least 8 elements
+    */
+    void InnerState(std::uint64_t* state) const noexcept
+    {
+        memcpy(state, innerState, sizeof(innerState));
+    }
+
+    /**
+        \brief Method for getting the internal state after processing the key block xored with opad
+
+        \param [out] state a pointer to the array with at least 8 elements
+    */
+    void OuterState(std::uint64_t* state) const noexcept
+    {
+        memcpy(state, outerState, sizeof(outerState));
+    }
+
+    /**
+        \brief Method for finishing the message authentication code with the outer hash
+
+        \param [in] h0 inner internal state variable 0 after processing the padded message
+        \param [in] h1 inner internal state variable 1 after processing the padded message
+        \param [in] h2 inner internal state variable 2 after processing the padded message
+        \param [in] h3 inner internal state variable 3 after processing the padded message
+        \param [in] h4 inner internal state variable 4 after processing the padded message
+        \param [in] h5 inner internal state variable 5 after processing the padded message
+        \param [in] h6 inner internal state variable 6 after processing the padded message
+        \param [in] h7 inner internal state variable 7 after processing the padded message
+        \param [out] digest a pointer to the array for the binary message authentication code. The length of the array must be at least the hash sum length of the key variant, 64 bytes is always enough
+
+        \return the length of the message authentication code in bytes
+    */
+    std::size_t Outer(const std::uint64_t& h0, const std::uint64_t& h1, const std::uint64_t& h2, const std::uint64_t& h3, const std::uint64_t& h4, const std::uint64_t& h5, const std::uint64_t& h6, const std::uint64_t& h7, std::uint8_t* digest) const noexcept
+    {
+        std::size_t digestLen;
+        switch (variant)
+        {
+        case Sha512Variant::Sha384:
+            digestLen = 48;
+            break;
+        case Sha512Variant::Sha512_224:
+            digestLen = 28;
+            break;
+        case Sha512Variant::Sha512_256:
+            digestLen = 32;
+            break;
+        default:
+            digestLen = 64;
+            break;
+        }
+
+        // Inner hash sum is always padded to one block
+        std::uint8_t innerDigest[64];
+        StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, digestLen, innerDigest);
+
+        char padding[256];
+        DataPaddingSha512(reinterpret_cast<const char*>(innerDigest), digestLen, 128 + digestLen, padding);
+
+        std::uint64_t o0 = outerState[0], o1 = outerState[1], o2 = outerState[2], o3 = outerState[3], o4 = outerState[4], o5 = outerState[5], o6 = outerState[6], o7 = outerState[7];
+        Sha512Steps(padding, 1, o0, o1, o2, o3, o4, o5, o6, o7);
+
+        StateToDigest(o0, o1, o2, o3, o4, o5, o6, o7, digestLen, digest);
+        return digestLen;
+    }
+
+    /**
+        \brief Method for calculating the message authentication code
+
+        \param [in] data a pointer to the array with the message
+        \param [in] dataLen data array length
+        \param [out] digest a pointer to the array for the binary message authentication code. The length of the array must be at least the hash sum length of the key variant, 64 bytes is always enough
+
+        \return the length of the message authentication code in bytes
+    */
+    std::size_t Mac(const char* data, const std::size_t& dataLen, std::uint8_t* digest) const noexcept
+    {
+        std::uint64_t h0 = innerState[0], h1 = innerState[1], h2 = innerState[2], h3 = innerState[3], h4 = innerState[4], h5 = innerState[5], h6 = innerState[6], h7 = innerState[7];
+
+        // Handle 128 byte chunks
+        Sha512Steps(data, dataLen >> 7, h0, h1, h2, h3, h4, h5, h6, h7);
+
+        // Padding message. The key block is already processed
+        char padding[256];
+        int paddingLen = DataPaddingSha512(data + (dataLen & ~static_cast<std::size_t>(0b01111111)), dataLen & 0b01111111, 128 + dataLen, padding);
+        Sha512Steps(padding, paddingLen >> 7, h0, h1, h2, h3, h4, h5, h6, h7);
+
+        return Outer(h0, h1, h2, h3, h4, h5, h6, h7, digest);
+    }
+
+    /**
+        \brief Method for calculating the message authentication code
+
+        \param [in] str the string with the message
+
+        \return a string with the message authentication code in hex form
+    */
+    std::string Mac(const std::string& str) const noexcept
+    {
+        std::uint8_t digest[64];
+        std::size_t digestLen = Mac(str.c_str(), str.length(), digest);
+
+        std::string res(digestLen * 2, 0);
+        BytesToHex(digest, digestLen, &res[0]);
+        return res;
+    }
+};
+
+/// \brief Context for the incremental calculation of the hmac using the sha512 family algorithms
+class HmacSha512Context
+{
+private:
+    // Precomputed key
+    HmacSha512Key key;
+
+    // Inner internal state variables
+    std::uint64_t h0, h1, h2, h3, h4, h5, h6, h7;
+
+    // Buffer for the incomplete 128 byte block
+    char buffer[128];
+
+    // Number of bytes in buffer
+    std::size_t bufferLen;
+
+    // Total length of the data passed to the inner hash including the key block
+    std::uint64_t dataLen;
+
+public:
+    /// \brief Context constructor
+    /// \param [in] key precomputed key
+    HmacSha512Context(const HmacSha512Key& key) noexcept : key(key)
+    {
+        Reset();
+    }
+
+    /// \brief Method for resetting the context to the state after processing the key block
+    void Reset() noexcept
+    {
+        std::uint64_t state[8];
+        key.InnerState(state);
+        h0 = state[0], h1 = state[1], h2 = state[2], h3 = state[3], h4 = state[4], h5 = state[5], h6 = state[6], h7 = state[7];
+
+        bufferLen = 0;
+        dataLen = 128;
+    }
+
+    /**
+        \brief Method for adding the next part of the message to the message authentication code
+
+        \param [in] data a pointer to the array with the next part of the message
+        \param [in] len data array length
+    */
+    void Update(const char* data, const std::size_t& len) noexcept
+    {
+        dataLen += len;
+
+        // Offset of the first unprocessed byte in data
+        std::size_t offset = 0;
+
+        // Complete the buffered block
+        if (bufferLen > 0)
+        {
+            offset = std::min(len, 128 - bufferLen);
+            memcpy(buffer + bufferLen, data, offset);
+            bufferLen += offset;
+
+            // Check if the block is still incomplete
+            if (bufferLen < 128)
+                return;
+
+            Sha512Steps(buffer, 1, h0, h1, h2, h3, h4, h5, h6, h7);
+            bufferLen = 0;
+        }
+
+        // Handle 128 byte chunks directly from data
+        Sha512Steps(data + offset, (len - offset) >> 7, h0, h1, h2, h3, h4, h5, h6, h7);
+        offset += (len - offset) & ~static_cast<std::size_t>(0b01111111);
+
+        // Save the incomplete block to buffer
+        bufferLen = len - offset;
+        memcpy(buffer, data + offset, bufferLen);
+    }
+
+    /**
+        \brief Method for adding the next part of the message to the message authentication code
+
+        \param [in] str the string with the next part of the message
+    */
+    void Update(const std::string& str) noexcept
+    {
+        Update(str.c_str(), str.length());
+    }
+
+    /**
+        \brief Method for finishing the message authentication code calculation
+
+        After calling this method the context is reset to the state after processing the key block
+
+        \param [out] digest a pointer to the array for the binary message authentication code. The length of the array must be at least the hash sum length of the key variant, 64 bytes is always enough
+
+        \return the length of the message authentication code in bytes
+    */
+    std::size_t Final(std::uint8_t* digest) noexcept
+    {
+        // Padding buffered data
+        char padding[256];
+        int paddingLen = DataPaddingSha512(buffer, bufferLen, dataLen, padding);
+
+        // Calculate inner hash for padded data
+        Sha512Steps(padding, paddingLen >> 7, h0, h1, h2, h3, h4, h5, h6, h7);
+
+        std::size_t digestLen = key.Outer(h0, h1, h2, h3, h4, h5, h6, h7, digest);
+
+        Reset();
+        return digestLen;
+    }
+
+    /**
+        \brief Method for finishing the message authentication code calculation
+
+        After calling this method the context is reset to the state after processing the key block
+
+        \return a string with the message authentication code in hex form
+    */
+    std::string Final() noexcept
+    {
+        std::uint8_t digest[64];
+        std::size_t digestLen = Final(digest);
+
+        std::string res(digestLen * 2, 0);
+        BytesToHex(digest, digestLen, &res[0]);
+        return res;
+    }
+};
+
+/**
+    \brief A function for calculating the binary hmac using the sha512 algorithm
+
+    \param [in] key a pointer to the array with the key
+    \param [in] keyLen key array length
+    \param [in] data a pointer to the array with the message
+    \param [in] dataLen data array length
+
+    \return an array with a hmac-sha512 message authentication code
+*/
+SHA2_API Sha512Digest HmacSha512Binary(const char* key, const std::size_t& keyLen, const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the hmac using the sha512 algorithm
+
+    \param [in] key the string with the key
+    \param [in] str the string with the message
+
+    \return a string with a hmac-sha512 message authentication code
+*/
+SHA2_API std::string HmacSha512(const std::string& key, const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the binary hmac using the sha384 algorithm
+
+    \param [in] key a pointer to the array with the key
+    \param [in] keyLen key array length
+    \param [in] data a pointer to the array with the message
+    \param [in] dataLen data array length
+
+    \return an array with a hmac-sha384 message authentication code
+*/
+SHA2_API Sha384Digest HmacSha384Binary(const char* key, const std::size_t& keyLen, const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the hmac using the sha384 algorithm
+
+    \param [in] key the string with the key
+    \param [in] str the string with the message
+
+    \return a string with a hmac-sha384 message authentication code
+*/
+SHA2_API std::string HmacSha384(const std::string& key, const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the binary hmac using the sha512/224 algorithm
+
+    \param [in] key a pointer to the array with the key
+    \param [in] keyLen key array length
+    \param [in] data a pointer to the array with the message
+    \param [in] dataLen data array length
+
+    \return an array with a hmac-sha512/224 message authentication code
+*/
+SHA2_API Sha512_224Digest HmacSha512_224Binary(const char* key, const std::size_t& keyLen, const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the hmac using the sha512/224 algorithm
+
+    \param [in] key the string with the key
+    \param [in] str the string with the message
+
+    \return a string with a hmac-sha512/224 message authentication code
+*/
+SHA2_API std::string HmacSha512_224(const std::string& key, const std::string& str) noexcept;
+
+/**
+    \brief A function for calculating the binary hmac using the sha512/256 algorithm
+
+    \param [in] key a pointer to the array with the key
+    \param [in] keyLen key array length
+    \param [in] data a pointer to the array with the message
+    \param [in] dataLen data array length
+
+    \return an array with a hmac-sha512/256 message authentication code
+*/
+SHA2_API Sha512_256Digest HmacSha512_256Binary(const char* key, const std::size_t& keyLen, const char* data, const std::size_t& dataLen) noexcept;
+
+/**
+    \brief A function for calculating the hmac using the sha512/256 algorithm
+
+    \param [in] key the string with the key
+    \param [in] str the string with the message
+
+    \return a string with a hmac-sha512/256 message authentication code
+*/
+SHA2_API std::string HmacSha512_256(const std::string& key, const std::string& str) noexcept;
+
+/**
+    \brief A function for deriving keys from many passwords with the same salt using the pbkdf2 algorithm
+
+    The derived keys consist of blocks which are computed independently, so the blocks of all keys are iterated together.
+    The keys can have different variants, the keys of the same variant are iterated together
+
+    \param [in] keys an array of the hmac keys made from the passwords
+    \param [in] keysCount the number of keys
+    \param [in] salt a pointer to the array with the salt
+    \param [in] saltLen salt array length
+    \param [in] iterations the number of iterations. Values less than 1 are handled as 1
+    \param [in] derivedKeyLen the length of every derived key in bytes
+    \param [out] derivedKeys an array for the derived keys with at least keysCount * derivedKeyLen elements
+*/
+SHA2_API void Pbkdf2Sha512(const HmacSha512Key* keys, const std::size_t& keysCount, const char* salt, const std::size_t& saltLen, const std::uint64_t& iterations, const std::size_t& derivedKeyLen, std::uint8_t* derivedKeys);
+
+/**
+    \brief A function for deriving the binary key from the password using the pbkdf2 algorithm with hmac with the sha512 family algorithms
+
+    \param [in] password a pointer to the array with the password
+    \param [in] passwordLen password array length
+    \param [in] salt a pointer to the array with the salt
+    \param [in] saltLen salt array length
+    \param [in] iterations the number of iterations. Values less than 1 are handled as 1
+    \param [in] derivedKeyLen the length of the derived key in bytes
+    \param [out] derivedKey a pointer to the array for the derived key with at least derivedKeyLen elements
+    \param [in] variant hashing algorithm to use
+*/
+SHA2_API void Pbkdf2HmacSha512Binary(const char* password, const std::size_t& passwordLen, const char* salt, const std::size_t& saltLen, const std::uint64_t& iterations, const std::size_t& derivedKeyLen, std::uint8_t* derivedKey, const Sha512Variant& variant = Sha512Variant::Sha512);
+
+/**
+    \brief A function for deriving the key from the password using the pbkdf2 algorithm with hmac-sha512
+
+    \param [in] password the string with the password
+    \param [in] salt the string with the salt
+    \param [in] iterations the number of iterations. Values less than 1 are handled as 1
+    \param [in] derivedKeyLen the length of the derived key in bytes
+
+    \return a string with the derived key in hex form
+*/
+SHA2_API std::string Pbkdf2HmacSha512(const std::string& password, const std::string& salt, const std::uint64_t& iterations, const std::size_t& derivedKeyLen = 64);
+
+/**
+    \brief A function for deriving the keys from many candidate passwords with the same salt using the pbkdf2 algorithm with hmac-sha512
+
+    The passwords are processed together in parallel SIMD lanes if the processor supports them
+
+    \param [in] passwords the vector with the passwords
+    \param [in] salt the string with the salt
+    \param [in] iterations the number of iterations. Values less than 1 are handled as 1
+    \param [in] derivedKeyLen the length of the derived keys in bytes
+
+    \return a vector with the derived keys in hex form in the order of the passwords
+*/
+SHA2_API std::vector<std::string> Pbkdf2HmacSha512Batch(const std::vector<std::string>& passwords, const std::string& salt, const std::uint64_t& iterations, const std::size_t& derivedKeyLen = 64);
+
+/**
+    \brief A function for calculating the hash sums of files using the sha512, sha384, sha512/224 or sha512/256 algorithm with pipelined reading
+
+    The next chunks of files are read while the current chunk is hashed, so hashing runs at the disk speed
+
+    \param [in] files the names of files to calculate hash for
+    \param [in] variant hashing algorithm to use
+    \param [in] chunkSize the size of the chunks to read the files. Rounded down to a multiple of 128
+    \param [in] depth the number of buffers of every file
+    \param [in] openFilesCount the number of files read at the same time
+
+    \return a vector with hash sums in the order of files. The hash sum is an empty string if the file cannot be read
+*/
+SHA2_API std::vector<std::string> PipelinedFilesSha512(const std::vector<std::string>& files, const Sha512Variant& variant = Sha512Variant::Sha512, const std::size_t& chunkSize = CHUNK_SIZE, const unsigned int& depth = 3, const unsigned int& openFilesCount = 4) noexcept;
+
+/**
+    \brief A function for calculating the file hash sum using the sha512 algorithm with pipelined reading
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [in] chunkSize the size of the chunks to read the file. Rounded down to a multiple of 128
+
+    \return a string with a sha512 hash sum
+*/
+SHA2_API std::string PipelinedFileSha512(const std::string& fileName, const std::size_t& chunkSize = CHUNK_SIZE) noexcept;
+
+/**
+    \brief A function for calculating the tree hash of a file using the sha512 algorithm
+
+    The format of the tree hash is described in the HashTreeFileSha512 function
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [in] leafSize the size of the leaves in bytes
+    \param [in] threadsCount the number of threads to hash the leaves. By default all hardware threads are used
+
+    \return a string with a sha512 tree hash
+*/
+SHA2_API std::string TreeFileSha512(const std::string& fileName, const std::size_t& leafSize = TREE_LEAF_SIZE, const unsigned int& threadsCount = std::thread::hardware_concurrency()) noexcept;
+
+/**
+    \brief A function for checking the file against its sha512 tree hash
+
+    \param [in] fileName the string with file name to check
+    \param [in] treeHash the expected tree hash in hex form
+    \param [in] leafSize the size of the leaves the tree hash was calculated with
+    \param [in] threadsCount the number of threads to hash the leaves. By default all hardware threads are used
+
+    \return true if the file tree hash equals treeHash, otherwise false
+*/
+SHA2_API bool VerifyTreeFileSha512(const std::string& fileName, const std::string& treeHash, const std::size_t& leafSize = TREE_LEAF_SIZE, const unsigned int& threadsCount = std::thread::hardware_concurrency()) noexcept;
+
+#endif // SHA2_SHA512_H
@@ -0,0 +1,1733 @@
+#include "Sha2Internal.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <filesystem>
+#include <cstdlib>
+
+/// \brief Convert uint32 to string with hex form of this number
+/// \param [in] a uint32 number to convert
+/// \return hex represenation of a
+std::string Uint32ToHexForm(std::uint32_t a) noexcept
+{
+    std::string res(8, 0);
+    
+    for (int i = 7; i > -1; i -= 2)
+    {
+        int highByte = a % 16;
+        a /= 16;
+        
+        int lowByte = a % 16;
+        a /= 16;
+
+        if (highByte > 9)
+            res[i] = 'a' + highByte - 10;
+        else
+            res[i] = highByte + '0';
+
+        if (lowByte > 9)
+            res[i - 1] = 'a' + lowByte - 10;
+        else
+            res[i - 1] = lowByte + '0';
+    }
+
+    return res;
+}
+
+/// \brief Load 4 bytes in big endian order as uint32
+/// \param [in] source a pointer to the char array with at least 4 elements
+/// \return uint32 number
+inline std::uint32_t LoadBigEndian32(const char* source) noexcept
+{
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    // A single unaligned load and a byte swap instruction
+    std::uint32_t res;
+    memcpy(&res, source, 4);
+    return __builtin_bswap32(res);
+#elif defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    std::uint32_t res;
+    memcpy(&res, source, 4);
+    return res;
+#else
+    return BytesToUint32(source);
+#endif
+}
+
+// Sigma functions of the sha256 algorithm
+#define SHA256_BIG_SIGMA0(x) (RightRotate(x, 2) ^ RightRotate(x, 13) ^ RightRotate(x, 22))
+#define SHA256_BIG_SIGMA1(x) (RightRotate(x, 6) ^ RightRotate(x, 11) ^ RightRotate(x, 25))
+#define SHA256_SMALL_SIGMA0(x) (RightRotate(x, 7) ^ RightRotate(x, 18) ^ ((x) >> 3))
+#define SHA256_SMALL_SIGMA1(x) (RightRotate(x, 17) ^ RightRotate(x, 19) ^ ((x) >> 10))
+
+// Message word i of the first 16 rounds is loaded from the block
+#define SHA256_LOAD_WORD(i) (words[i] = LoadBigEndian32(block + ((i) << 2)))
+
+// Message word i of the first 16 rounds is already in the ring buffer
+#define SHA256_KNOWN_WORD(i) (words[i])
+
+// Message word i of the last 48 rounds is computed in place of the word i - 16 of the ring buffer
+#define SHA256_NEXT_WORD(i) (words[(i) & 15] += SHA256_SMALL_SIGMA1(words[((i) - 2) & 15]) + words[((i) - 7) & 15] + SHA256_SMALL_SIGMA0(words[((i) - 15) & 15]))
+
+// One round. Instead of moving the values the roles of the variables are rotated by the callers
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, i, word) \
+    { \
+        std::uint32_t temp = h + SHA256_BIG_SIGMA1(e) + (g ^ (e & (f ^ g))) + Sha256K[i] + (word); \
+        d += temp; \
+        h = temp + SHA256_BIG_SIGMA0(a) + ((a & b) | (c & (a | b))); \
+    }
+
+// Eight rounds starting from the round i, after them the variables are back in their roles
+#define SHA256_ROUNDS8(i, WORD) \
+    SHA256_ROUND(a, b, c, d, e, f, g, h, (i), WORD((i))) \
+    SHA256_ROUND(h, a, b, c, d, e, f, g, (i) + 1, WORD((i) + 1)) \
+    SHA256_ROUND(g, h, a, b, c, d, e, f, (i) + 2, WORD((i) + 2)) \
+    SHA256_ROUND(f, g, h, a, b, c, d, e, (i) + 3, WORD((i) + 3)) \
+    SHA256_ROUND(e, f, g, h, a, b, c, d, (i) + 4, WORD((i) + 4)) \
+    SHA256_ROUND(d, e, f, g, h, a, b, c, (i) + 5, WORD((i) + 5)) \
+    SHA256_ROUND(c, d, e, f, g, h, a, b, (i) + 6, WORD((i) + 6)) \
+    SHA256_ROUND(b, c, d, e, f, g, h, a, (i) + 7, WORD((i) + 7))
+
+/**
+    \brief Sha256 hashing steps for a run of blocks
+
+    The function calculates the sha256 hash sum for several consecutive 64 byte blocks of data without SIMD instructions.
+    All 64 rounds are unrolled, the message schedule is computed on the fly in a ring buffer of 16 words
+    and the state is kept in local variables for the whole run of blocks
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] blocksCount the number of 64 byte blocks in data
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+*/
+void Sha256StepsScalar(const char* data, const std::size_t& blocksCount, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7) noexcept
+{
+    // Load state once for all blocks
+    std::uint32_t s0 = h0, s1 = h1, s2 = h2, s3 = h3, s4 = h4, s5 = h5, s6 = h6, s7 = h7;
+
+    // Ring buffer with the last 16 message words
+    std::uint32_t words[16];
+
+    for (std::size_t i = 0; i < blocksCount; ++i)
+    {
+        const char* block = data + (i << 6);
+        std::uint32_t a = s0, b = s1, c = s2, d = s3, e = s4, f = s5, g = s6, h = s7;
+
+        SHA256_ROUNDS8(0, SHA256_LOAD_WORD)
+        SHA256_ROUNDS8(8, SHA256_LOAD_WORD)
+        SHA256_ROUNDS8(16, SHA256_NEXT_WORD)
+        SHA256_ROUNDS8(24, SHA256_NEXT_WORD)
+        SHA256_ROUNDS8(32, SHA256_NEXT_WORD)
+        SHA256_ROUNDS8(40, SHA256_NEXT_WORD)
+        SHA256_ROUNDS8(48, SHA256_NEXT_WORD)
+        SHA256_ROUNDS8(56, SHA256_NEXT_WORD)
+
+        s0 += a, s1 += b, s2 += c, s3 += d, s4 += e, s5 += f, s6 += g, s7 += h;
+    }
+
+    // Store state back
+    h0 = s0, h1 = s1, h2 = s2, h3 = s3, h4 = s4, h5 = s5, h6 = s6, h7 = s7;
+}
+
+/**
+    \brief A function for calculating the second pass of sha256d with the scalar instructions
+
+    The message of the second pass is the 32 byte result of the first pass, so the message words 0 to 7 are the state variables
+    and the words 8 to 15 are the constant padding. With the unrolled rounds the compiler folds the constant words
+    into the round additions and the message schedule
+
+    \param [in, out] h0 the first pass state variable 0 on input, the sha256d state variable 0 on output
+    \param [in, out] h1 the first pass state variable 1 on input, the sha256d state variable 1 on output
+    \param [in, out] h2 the first pass state variable 2 on input, the sha256d state variable 2 on output
+    \param [in, out] h3 the first pass state variable 3 on input, the sha256d state variable 3 on output
+    \param [in, out] h4 the first pass state variable 4 on input, the sha256d state variable 4 on output
+    \param [in, out] h5 the first pass state variable 5 on input, the sha256d state variable 5 on output
+    \param [in, out] h6 the first pass state variable 6 on input, the sha256d state variable 6 on output
+    \param [in, out] h7 the first pass state variable 7 on input, the sha256d state variable 7 on output
+*/
+void Sha256dSecondPassScalar(std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7) noexcept
+{
+    // Ring buffer with the last 16 message words, the words 8 to 15 are the padding of a 32 byte message
+    std::uint32_t words[16] = { h0, h1, h2, h3, h4, h5, h6, h7, 0x80000000, 0, 0, 0, 0, 0, 0, 256 };
+
+    // Temporary variables
+    std::uint32_t a = 0x6a09e667, b = 0xbb67ae85, c = 0x3c6ef372, d = 0xa54ff53a, e = 0x510e527f, f = 0x9b05688c, g = 0x1f83d9ab, h = 0x5be0cd19;
+
+    SHA256_ROUNDS8(0, SHA256_KNOWN_WORD)
+    SHA256_ROUNDS8(8, SHA256_KNOWN_WORD)
+
+    SHA256_ROUNDS8(16, SHA256_NEXT_WORD)
+    SHA256_ROUNDS8(24, SHA256_NEXT_WORD)
+    SHA256_ROUNDS8(32, SHA256_NEXT_WORD)
+    SHA256_ROUNDS8(40, SHA256_NEXT_WORD)
+    SHA256_ROUNDS8(48, SHA256_NEXT_WORD)
+    SHA256_ROUNDS8(56, SHA256_NEXT_WORD)
+
+    h0 = 0x6a09e667 + a, h1 = 0xbb67ae85 + b, h2 = 0x3c6ef372 + c, h3 = 0xa54ff53a + d, h4 = 0x510e527f + e, h5 = 0x9b05688c + f, h6 = 0x1f83d9ab + g, h7 = 0x5be0cd19 + h;
+}
+
+/**
+    \brief A function for calculating the message schedule of the padding block of 64 byte messages at compile time
+
+    \return the 64 message words of the padding block
+*/
+constexpr std::array<std::uint32_t, 64> Sha256NodePaddingSchedule() noexcept
+{
+    std::array<std::uint32_t, 64> res{};
+    res[0] = 0x80000000;
+    res[15] = 512;
+
+    for (int i = 16; i < 64; ++i)
+        res[i] = SHA256_SMALL_SIGMA1(res[i - 2]) + res[i - 7] + SHA256_SMALL_SIGMA0(res[i - 15]) + res[i - 16];
+
+    return res;
+}
+
+// Message schedule of the padding block of 64 byte messages
+constexpr std::array<std::uint32_t, 64> Sha256NodePadding = Sha256NodePaddingSchedule();
+
+// Message word i of the padding block of 64 byte messages
+#define SHA256_PADDING_WORD(i) (Sha256NodePadding[i])
+
+/**
+    \brief A function for hashing the padding block of 64 byte messages with the scalar instructions
+
+    The message schedule is precomputed, so only the rounds are calculated and the sums of the round constants and the message words
+    are folded by the compiler
+
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+*/
+void Sha256NodePaddingScalar(std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7) noexcept
+{
+    // Temporary variables
+    std::uint32_t a = h0, b = h1, c = h2, d = h3, e = h4, f = h5, g = h6, h = h7;
+
+    SHA256_ROUNDS8(0, SHA256_PADDING_WORD)
+    SHA256_ROUNDS8(8, SHA256_PADDING_WORD)
+    SHA256_ROUNDS8(16, SHA256_PADDING_WORD)
+    SHA256_ROUNDS8(24, SHA256_PADDING_WORD)
+    SHA256_ROUNDS8(32, SHA256_PADDING_WORD)
+    SHA256_ROUNDS8(40, SHA256_PADDING_WORD)
+    SHA256_ROUNDS8(48, SHA256_PADDING_WORD)
+    SHA256_ROUNDS8(56, SHA256_PADDING_WORD)
+
+    h0 += a, h1 += b, h2 += c, h3 += d, h4 += e, h5 += f, h6 += g, h7 += h;
+}
+
+#undef SHA256_ROUNDS8
+#undef SHA256_ROUND
+#undef SHA256_NEXT_WORD
+#undef SHA256_PADDING_WORD
+#undef SHA256_KNOWN_WORD
+#undef SHA256_LOAD_WORD
+#undef SHA256_SMALL_SIGMA1
+#undef SHA256_SMALL_SIGMA0
+#undef SHA256_BIG_SIGMA1
+#undef SHA256_BIG_SIGMA0
+
+/// \brief Choose the fastest sha256 kernel supported by the processor
+/// \return a pointer to the function for calculating sha256 hashing steps
+Sha256StepsFunction SelectSha256Steps() noexcept
+{
+#ifdef SHA2_X86_KERNELS
+    if (IsShaNiSupported())
+        return Sha256StepsShaNi;
+#endif // SHA2_X86_KERNELS
+
+#ifdef SHA2_ARM_KERNELS
+    if (IsArmSha256Supported())
+        return Sha256StepsArm;
+#endif // SHA2_ARM_KERNELS
+
+    return Sha256StepsScalar;
+}
+
+void Sha256Steps(const char* data, const std::size_t& blocksCount, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7) noexcept
+{
+    static const Sha256StepsFunction steps = SelectSha256Steps();
+    steps(data, blocksCount, h0, h1, h2, h3, h4, h5, h6, h7);
+    RecordSha2Blocks(Sha2MetricsFamily::Sha256, blocksCount);
+}
+
+const char* Sha256SingleKernelName() noexcept
+{
+#ifdef SHA2_X86_KERNELS
+    if (IsShaNiSupported())
+        return "sha-ni";
+#endif // SHA2_X86_KERNELS
+
+#ifdef SHA2_ARM_KERNELS
+    if (IsArmSha256Supported())
+        return "armv8";
+#endif // SHA2_ARM_KERNELS
+
+    return "scalar";
+}
+
+const char* Sha256BatchKernelName() noexcept
+{
+#ifdef SHA2_X86_KERNELS
+    if (IsAvx512Supported())
+        return "avx512x16";
+
+    if (IsAvx2Supported() && !IsShaNiSupported())
+        return "avx2x8";
+#endif // SHA2_X86_KERNELS
+
+    return Sha256SingleKernelName();
+}
+
+void HashSha256(const char* data, const std::size_t& dataLen, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7)
+{
+    std::uint64_t startTime = StartSha2Call(Sha2MetricsFamily::Sha256, dataLen);
+
+    // Handle 64 byte chunks
+    Sha256Steps(data, dataLen >> 6, h0, h1, h2, h3, h4, h5, h6, h7);
+
+    // Padding source data
+    char padding[128];
+    int paddingLen = DataPaddingSha256(data + (dataLen & ~0b00111111), dataLen & 0b00111111, dataLen, padding);
+
+    // Calculate hash for padded data
+    Sha256Steps(padding, paddingLen >> 6, h0, h1, h2, h3, h4, h5, h6, h7);
+
+    FinishSha2Call(Sha2MetricsFamily::Sha256, startTime);
+}
+
+void HashFileSha256(std::istream& file, const std::size_t& chunkSize, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7)
+{
+    // Array to read chunks from file
+    std::vector<char> fileDataChunk(std::max(chunkSize & ~static_cast<std::size_t>(0b00111111), static_cast<std::size_t>(64)));
+
+    // Counter for file reading
+    std::uint64_t fileSize = 0;
+
+    // Number of bytes in the last read chunk
+    std::size_t counter;
+
+    // Time spent in the reads and in the hashing for the metrics
+    std::uint64_t readTime = 0, hashTime = 0;
+
+    while (true)
+    {
+        // Read chunk from input file
+        std::uint64_t readStart = Sha2MetricsTime();
+        file.read(fileDataChunk.data(), fileDataChunk.size());
+        counter = file.gcount();
+        fileSize += counter;
+        std::uint64_t hashStart = Sha2MetricsTime();
+        readTime += hashStart - readStart;
+
+        // Check if the chunk is the last one
+        if (counter < fileDataChunk.size())
+            break;
+
+        // Calculate hash steps
+        Sha256Steps(fileDataChunk.data(), counter >> 6, h0, h1, h2, h3, h4, h5, h6, h7);
+        hashTime += Sha2MetricsTime() - hashStart;
+    }
+
+    std::uint64_t hashStart = Sha2MetricsTime();
+
+    // Calculate hash for last bytes
+    Sha256Steps(fileDataChunk.data(), counter >> 6, h0, h1, h2, h3, h4, h5, h6, h7);
+
+    // Padding source file
+    // Move fileDataChunk ptr to last position multiply by 64
+    char padding[128];
+    int paddingLen = DataPaddingSha256(fileDataChunk.data() + (counter & ~0b00111111), counter & 0b00111111, fileSize, padding);
+
+    // Calculate hash for padded data
+    Sha256Steps(padding, paddingLen >> 6, h0, h1, h2, h3, h4, h5, h6, h7);
+
+    hashTime += Sha2MetricsTime() - hashStart;
+    RecordSha2Bytes(Sha2MetricsFamily::Sha256, fileSize);
+    RecordSha2FileTimes(Sha2MetricsFamily::Sha256, readTime, hashTime);
+}
+
+#ifdef SHA2_POSIX_FILES
+/// \brief Mapped file hashed with the sha256 algorithm under the protection against its truncation
+struct MappedFileSha256
+{
+    // Pages of the file
+    const char* data;
+    std::size_t dataLen;
+
+    // Number of bytes hashed between the advices to read ahead, a multiple of the page size
+    std::size_t windowSize;
+    std::size_t pageSize;
+
+    // Internal state variables
+    std::uint32_t h[8];
+
+    // Time spent in the mapping and the page faults and in the hashing for the metrics
+    std::uint64_t readTime;
+    std::uint64_t hashTime;
+};
+
+/**
+    \brief A function for hashing the pages of a mapped file window by window
+
+    The read of the next window is requested from the kernel before the current window is hashed
+
+    \param [in, out] argument the MappedFileSha256 structure
+*/
+static void HashMappedWindowsSha256(void* argument) noexcept
+{
+    MappedFileSha256& file = *static_cast<MappedFileSha256*>(argument);
+    std::size_t blocksLen = file.dataLen & ~static_cast<std::size_t>(0b00111111);
+
+    for (std::size_t offset = 0; offset < blocksLen; offset += file.windowSize)
+    {
+        std::size_t windowLen = std::min(file.windowSize, blocksLen - offset);
+        std::uint64_t readStart = Sha2MetricsTime();
+        if (offset + file.windowSize < file.dataLen)
+            madvise(const_cast<char*>(file.data) + offset + file.windowSize, std::min(file.windowSize, file.dataLen - offset - file.windowSize), MADV_WILLNEED);
+
+#ifdef SHA2_METRICS
+        // Fault the pages of the window in before hashing them, so the wait for the reads is not counted as the hashing
+        for (std::size_t page = 0; page < windowLen; page += file.pageSize)
+            static_cast<void>(*static_cast<const volatile char*>(file.data + offset + page));
+#endif // SHA2_METRICS
+
+        std::uint64_t hashStart = Sha2MetricsTime();
+        file.readTime += hashStart - readStart;
+        Sha256Steps(file.data + offset, windowLen >> 6, file.h[0], file.h[1], file.h[2], file.h[3], file.h[4], file.h[5], file.h[6], file.h[7]);
+        file.hashTime += Sha2MetricsTime() - hashStart;
+    }
+
+    // Padding the tail of the file
+    std::uint64_t hashStart = Sha2MetricsTime();
+    char padding[128];
+    int paddingLen = DataPaddingSha256(file.data + blocksLen, file.dataLen & 0b00111111, file.dataLen, padding);
+    Sha256Steps(padding, paddingLen >> 6, file.h[0], file.h[1], file.h[2], file.h[3], file.h[4], file.h[5], file.h[6], file.h[7]);
+    file.hashTime += Sha2MetricsTime() - hashStart;
+}
+
+/**
+    \brief A function for calculating the file hash sum using the sha256 algorithm with the file mapped to memory
+
+    The pages of the file are passed directly to the hashing steps without copying to a buffer.
+    The kernel is advised that the file will be read sequentially, and the next window of chunkSize bytes is requested
+    before the current one is hashed. If the file is truncated by another process during the hashing,
+    the fault is caught and the function fails without changing the state, so the file can be read again by the streaming reader
+
+    \param [in] fileDescriptor descriptor of the file opened for reading
+    \param [in] fileSize the size of the file
+    \param [in] chunkSize the size of the read ahead windows. Rounded down to a multiple of the page size
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+
+    \return true if the file was mapped and hashed, false if the file cannot be mapped or was truncated and the state was not changed
+*/
+bool HashMappedFileSha256(const int& fileDescriptor, const std::size_t& fileSize, const std::size_t& chunkSize, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7)
+{
+    // The mapping is counted as the read time of the file
+    std::uint64_t mapStart = Sha2MetricsTime();
+    void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (mapping == MAP_FAILED)
+        return false;
+
+    madvise(mapping, fileSize, MADV_SEQUENTIAL);
+
+    std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    MappedFileSha256 file = { static_cast<const char*>(mapping), fileSize, std::max(chunkSize - chunkSize % pageSize, pageSize), pageSize, { h0, h1, h2, h3, h4, h5, h6, h7 }, Sha2MetricsTime() - mapStart, 0 };
+
+    // Calculate hash for mapped file. The page faults are counted as the read time
+    bool isHashed = RunGuardedMappedRead(HashMappedWindowsSha256, &file);
+    munmap(mapping, fileSize);
+    RecordSha2FileTimes(Sha2MetricsFamily::Sha256, file.readTime, file.hashTime);
+    if (!isHashed)
+        return false;
+
+    // The truncated files are counted by the streaming reader which hashes them again
+    RecordSha2Bytes(Sha2MetricsFamily::Sha256, fileSize);
+
+    h0 = file.h[0];
+    h1 = file.h[1];
+    h2 = file.h[2];
+    h3 = file.h[3];
+    h4 = file.h[4];
+    h5 = file.h[5];
+    h6 = file.h[6];
+    h7 = file.h[7];
+    return true;
+}
+#endif // SHA2_POSIX_FILES
+
+bool HashFileSha256(const std::string& fileName, const std::size_t& chunkSize, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7)
+{
+#ifdef SHA2_POSIX_FILES
+    int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+        return false;
+
+    // Map only not empty regular files. Truncated files are read again with the streaming reader
+    struct stat fileStat;
+    bool isHashed = fstat(fileDescriptor, &fileStat) == 0 && S_ISREG(fileStat.st_mode) && fileStat.st_size > 0 &&
+        static_cast<std::uint64_t>(fileStat.st_size) <= SIZE_MAX &&
+        HashMappedFileSha256(fileDescriptor, fileStat.st_size, chunkSize, h0, h1, h2, h3, h4, h5, h6, h7);
+
+    close(fileDescriptor);
+    if (isHashed)
+        return true;
+#endif // SHA2_POSIX_FILES
+
+    // Open file
+    std::ifstream file(fileName, std::ios_base::binary);
+    if (!file.is_open())
+        return false;
+
+    // Calculate hash for file. A read error, for example of a directory, fails instead of returning the hash sum of the data read before it
+    HashFileSha256(file, chunkSize, h0, h1, h2, h3, h4, h5, h6, h7);
+    return !file.bad();
+}
+
+#ifdef SHA2_X86_KERNELS
+/**
+    \brief A function for calculating the hash sums of many messages in parallel SIMD lanes
+
+    Every lane processes its own message block by block. After the last data block each lane hashes its own padding blocks,
+    then the lane is refilled with the next message, so messages of different lengths do not wait for each other.
+    Free lanes at the end of the batch hash a dummy block and their results are ignored
+
+    \param [in] lanesCount the number of lanes in the kernel. Must be less than or equal to 16
+    \param [in] step the multi-lane hashing step
+    \param [in] data an array of pointers to the messages
+    \param [in] dataLens an array of the messages lengths
+    \param [in] count the number of messages
+    \param [in] beginHash begin hash values of the algorithm
+    \param [out] hashes an array for the internal state variables of the messages. The state variable i of the message j is written to hashes[j * 8 + i]
+*/
+void HashSha256Lanes(const int& lanesCount, void (*step)(const char* const*, std::uint32_t*), const char* const* data, const std::size_t* dataLens, const std::size_t& count, const std::uint32_t* beginHash, std::uint32_t* hashes) noexcept
+{
+#ifdef SHA2_METRICS
+    // Count the messages with their padding blocks
+    std::uint64_t bytesCount = 0, blocksCount = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        bytesCount += dataLens[i];
+        blocksCount += (dataLens[i] + 72) >> 6;
+    }
+
+    RecordSha2Bytes(Sha2MetricsFamily::Sha256, bytesCount);
+    RecordSha2Blocks(Sha2MetricsFamily::Sha256, blocksCount);
+#endif // SHA2_METRICS
+
+    // Internal state variables of all lanes
+    alignas(64) std::uint32_t state[8 * 16];
+
+    // Pointers to the current block of every lane
+    const char* blocks[16];
+
+    // Padding blocks of every lane
+    char padding[16][128];
+
+    // Index of the message in every lane. Equals count if lane is free
+    std::size_t messages[16];
+
+    // Number of full data blocks, number of all blocks with padding and index of the current block in every lane
+    std::size_t dataBlocks[16], totalBlocks[16], position[16];
+
+    // Block for free lanes
+    const char dummy[64] = {};
+
+    // Index of the next message to put to a lane
+    std::size_t next = 0;
+
+    // Number of lanes with messages
+    int activeLanes = 0;
+
+    for (int lane = 0; lane < lanesCount; ++lane)
+        messages[lane] = count;
+
+    while (true)
+    {
+        for (int lane = 0; lane < lanesCount; ++lane)
+        {
+            // Put the next message to the free lane
+            if (messages[lane] == count && next < count)
+            {
+                messages[lane] = next;
+                dataBlocks[lane] = dataLens[next] >> 6;
+                totalBlocks[lane] = dataBlocks[lane] + (DataPaddingSha256(data[next] + (dataLens[next] & ~0b00111111), dataLens[next] & 0b00111111, dataLens[next], padding[lane]) >> 6);
+                position[lane] = 0;
+
+                for (int i = 0; i < 8; ++i)
+                    state[i * lanesCount + lane] = beginHash[i];
+
+                ++next;
+                ++activeLanes;
+            }
+
+            // Choose the current block of the lane
+            if (messages[lane] == count)
+                blocks[lane] = dummy;
+            else if (position[lane] < dataBlocks[lane])
+                blocks[lane] = data[messages[lane]] + (position[lane] << 6);
+            else
+                blocks[lane] = padding[lane] + ((position[lane] - dataBlocks[lane]) << 6);
+        }
+
+        if (activeLanes == 0)
+            break;
+
+        step(blocks, state);
+
+        // Save hashes of the finished messages
+        for (int lane = 0; lane < lanesCount; ++lane)
+        {
+            if (messages[lane] != count && ++position[lane] == totalBlocks[lane])
+            {
+                for (int i = 0; i < 8; ++i)
+                    hashes[messages[lane] * 8 + i] = state[i * lanesCount + lane];
+
+                messages[lane] = count;
+                --activeLanes;
+            }
+        }
+    }
+}
+#endif // SHA2_X86_KERNELS
+
+void HashSha256Batch(const char* const* data, const std::size_t* dataLens, const std::size_t& count, const std::uint32_t* beginHash, std::uint32_t* hashes) noexcept
+{
+#ifdef SHA2_X86_KERNELS
+    static const bool isAvx512Supported = IsAvx512Supported();
+    static const bool isAvx2Supported = IsAvx2Supported() && !IsShaNiSupported();
+
+    if (isAvx512Supported)
+        return HashSha256Lanes(16, Sha256StepAvx512x16, data, dataLens, count, beginHash, hashes);
+
+    if (isAvx2Supported)
+        return HashSha256Lanes(8, Sha256StepAvx2x8, data, dataLens, count, beginHash, hashes);
+#endif // SHA2_X86_KERNELS
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::uint32_t* h = hashes + i * 8;
+        memcpy(h, beginHash, 8 * sizeof(std::uint32_t));
+        HashSha256(data[i], dataLens[i], h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7]);
+    }
+}
+
+/**
+    \brief A function for calculating the hash sums of many messages one at a time with the chosen hashing steps function
+
+    \param [in] data an array of pointers to the messages
+    \param [in] dataLens an array of the messages lengths
+    \param [in] count the number of messages
+    \param [in] beginHash begin hash values of the algorithm
+    \param [out] hashes an array for the internal state variables of the messages
+*/
+template <Sha256StepsFunction Steps>
+void HashSha256WithKernel(const char* const* data, const std::size_t* dataLens, const std::size_t& count, const std::uint32_t* beginHash, std::uint32_t* hashes) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::uint32_t* h = hashes + i * 8;
+        memcpy(h, beginHash, 8 * sizeof(std::uint32_t));
+        Steps(data[i], dataLens[i] >> 6, h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7]);
+
+        char padding[128];
+        int paddingLen = DataPaddingSha256(data[i] + (dataLens[i] & ~static_cast<std::size_t>(0b00111111)), dataLens[i] & 0b00111111, dataLens[i], padding);
+        Steps(padding, paddingLen >> 6, h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7]);
+    }
+}
+
+#ifdef SHA2_X86_KERNELS
+/**
+    \brief A function for calculating the hash sums of many messages in parallel SIMD lanes with the chosen step function
+
+    \param [in] data an array of pointers to the messages
+    \param [in] dataLens an array of the messages lengths
+    \param [in] count the number of messages
+    \param [in] beginHash begin hash values of the algorithm
+    \param [out] hashes an array for the internal state variables of the messages
+*/
+template <int LanesCount, void (*Step)(const char* const*, std::uint32_t*) noexcept>
+void HashSha256WithLanes(const char* const* data, const std::size_t* dataLens, const std::size_t& count, const std::uint32_t* beginHash, std::uint32_t* hashes) noexcept
+{
+    HashSha256Lanes(LanesCount, Step, data, dataLens, count, beginHash, hashes);
+}
+#endif // SHA2_X86_KERNELS
+
+std::vector<Sha256Kernel> GetSha256Kernels()
+{
+    std::vector<Sha256Kernel> res = { { "scalar", 1, HashSha256WithKernel<Sha256StepsScalar> } };
+
+#ifdef SHA2_X86_KERNELS
+    if (IsShaNiSupported())
+        res.push_back({ "sha-ni", 1, HashSha256WithKernel<Sha256StepsShaNi> });
+#endif // SHA2_X86_KERNELS
+
+#ifdef SHA2_ARM_KERNELS
+    if (IsArmSha256Supported())
+        res.push_back({ "armv8-sha2", 1, HashSha256WithKernel<Sha256StepsArm> });
+#endif // SHA2_ARM_KERNELS
+
+#ifdef SHA2_X86_KERNELS
+    if (IsAvx2Supported())
+        res.push_back({ "avx2-x8", 8, HashSha256WithLanes<8, Sha256StepAvx2x8> });
+    if (IsAvx512Supported())
+        res.push_back({ "avx512-x16", 16, HashSha256WithLanes<16, Sha256StepAvx512x16> });
+#endif // SHA2_X86_KERNELS
+
+    return res;
+}
+
+Sha256Digest Sha256Binary(const char* data, const std::size_t& dataLen) noexcept
+{
+    // Begin hash values
+    std::uint32_t h0 = 0x6a09e667, h1 = 0xbb67ae85, h2 = 0x3c6ef372, h3 = 0xa54ff53a, h4 = 0x510e527f, h5 = 0x9b05688c, h6 = 0x1f83d9ab, h7 = 0x5be0cd19;
+
+    // Calculate hash
+    HashSha256(data, dataLen, h0, h1, h2, h3, h4, h5, h6, h7);
+
+    // Return calculated hash
+    Sha256Digest res;
+    StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, res.size(), res.data());
+    return res;
+}
+
+Sha256Digest Sha256Binary(const std::string& str) noexcept
+{
+    return Sha256Binary(str.c_str(), str.length());
+}
+
+bool FileSha256Binary(const std::string& fileName, Sha256Digest& digest, const std::size_t& chunkSize) noexcept
+{
+    // Use the cached hash sum if the digest cache is installed
+    DigestCache* cache = GetDigestCache();
+    FileIdentity identity;
+    if (cache != nullptr && cache->Lookup(fileName, Sha2Algorithm::Sha256, digest.data(), identity))
+        return true;
+
+    // Begin hash values
+    std::uint32_t h0 = 0x6a09e667, h1 = 0xbb67ae85, h2 = 0x3c6ef372, h3 = 0xa54ff53a, h4 = 0x510e527f, h5 = 0x9b05688c, h6 = 0x1f83d9ab, h7 = 0x5be0cd19;
+
+    // Calculate hash for file
+    if (!HashFileSha256(fileName, chunkSize, h0, h1, h2, h3, h4, h5, h6, h7))
+        return false;
+
+    StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, digest.size(), digest.data());
+
+    if (cache != nullptr)
+        cache->Store(fileName, identity, Sha2Algorithm::Sha256, digest.data());
+
+    return true;
+}
+
+std::string Sha256(const char* data, const std::size_t& dataLen) noexcept
+{
+    return DigestToHex(Sha256Binary(data, dataLen));
+}
+
+std::string Sha256(const std::string& str) noexcept
+{
+    return Sha256(str.c_str(), str.length());
+}
+
+std::string FileSha256(const std::string& fileName, const std::size_t& chunkSize) noexcept
+{
+    Sha256Digest digest;
+
+    // Calculate hash for file
+    if (!FileSha256Binary(fileName, digest, chunkSize)) {std::cerr << "Can not open file: " << fileName << std::endl; return "";}
+
+    // Return calculated hash
+    return DigestToHex(digest);
+}
+
+Sha224Digest Sha224Binary(const char* data, const std::size_t& dataLen) noexcept
+{
+    // Begin hash values
+    std::uint32_t h0 = 0xc1059ed8, h1 = 0x367cd507, h2 = 0x3070dd17, h3 = 0xf70e5939, h4 = 0xffc00b31, h5 = 0x68581511, h6 = 0x64f98fa7, h7 = 0xbefa4fa4;
+
+    // Calculate hash
+    HashSha256(data, dataLen, h0, h1, h2, h3, h4, h5, h6, h7);
+
+    // Return calculated hash
+    Sha224Digest res;
+    StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, res.size(), res.data());
+    return res;
+}
+
+Sha224Digest Sha224Binary(const std::string& str) noexcept
+{
+    return Sha224Binary(str.c_str(), str.length());
+}
+
+bool FileSha224Binary(const std::string& fileName, Sha224Digest& digest, const std::size_t& chunkSize) noexcept
+{
+    // Use the cached hash sum if the digest cache is installed
+    DigestCache* cache = GetDigestCache();
+    FileIdentity identity;
+    if (cache != nullptr && cache->Lookup(fileName, Sha2Algorithm::Sha224, digest.data(), identity))
+        return true;
+
+    // Begin hash values
+    std::uint32_t h0 = 0xc1059ed8, h1 = 0x367cd507, h2 = 0x3070dd17, h3 = 0xf70e5939, h4 = 0xffc00b31, h5 = 0x68581511, h6 = 0x64f98fa7, h7 = 0xbefa4fa4;
+
+    // Calculate hash for file
+    if (!HashFileSha256(fileName, chunkSize, h0, h1, h2, h3, h4, h5, h6, h7))
+        return false;
+
+    StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, digest.size(), digest.data());
+
+    if (cache != nullptr)
+        cache->Store(fileName, identity, Sha2Algorithm::Sha224, digest.data());
+
+    return true;
+}
+
+std::string Sha224(const char* data, const std::size_t& dataLen) noexcept
+{
+    return DigestToHex(Sha224Binary(data, dataLen));
+}
+
+std::string Sha224(const std::string& str) noexcept
+{
+    return Sha224(str.c_str(), str.length());
+}
+
+std::string FileSha224(const std::string& fileName, const std::size_t& chunkSize) noexcept
+{
+    Sha224Digest digest;
+
+    // Calculate hash for file
+    if (!FileSha224Binary(fileName, digest, chunkSize)) {std::cerr << "Can not open file: " << fileName << std::endl; return "";}
+
+    // Return calculated hash
+    return DigestToHex(digest);
+}
+
+std::vector<std::string> Sha256Batch(const std::vector<std::string>& messages) noexcept
+{
+    // Begin hash values
+    const std::uint32_t beginHash[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+    std::vector<const char*> data(messages.size());
+    std::vector<std::size_t> dataLens(messages.size());
+    for (std::size_t i = 0; i < messages.size(); ++i)
+    {
+        data[i] = messages[i].c_str();
+        dataLens[i] = messages[i].length();
+    }
+
+    // Calculate hashes
+    std::vector<std::uint32_t> hashes(messages.size() * 8);
+    HashSha256Batch(data.data(), dataLens.data(), messages.size(), beginHash, hashes.data());
+
+    // Return calculated hashes
+    std::vector<std::string> res(messages.size());
+    for (std::size_t i = 0; i < messages.size(); ++i)
+    {
+        const std::uint32_t* h = hashes.data() + i * 8;
+        res[i].resize(64);
+        std::uint8_t digest[32];
+        StateToDigest(h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7], 32, digest);
+        BytesToHex(digest, 32, &res[i][0]);
+    }
+
+    return res;
+}
+
+std::vector<std::string> Sha224Batch(const std::vector<std::string>& messages) noexcept
+{
+    // Begin hash values
+    const std::uint32_t beginHash[8] = { 0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4 };
+
+    std::vector<const char*> data(messages.size());
+    std::vector<std::size_t> dataLens(messages.size());
+    for (std::size_t i = 0; i < messages.size(); ++i)
+    {
+        data[i] = messages[i].c_str();
+        dataLens[i] = messages[i].length();
+    }
+
+    // Calculate hashes
+    std::vector<std::uint32_t> hashes(messages.size() * 8);
+    HashSha256Batch(data.data(), dataLens.data(), messages.size(), beginHash, hashes.data());
+
+    // Return calculated hashes
+    std::vector<std::string> res(messages.size());
+    for (std::size_t i = 0; i < messages.size(); ++i)
+    {
+        const std::uint32_t* h = hashes.data() + i * 8;
+        res[i].resize(56);
+        std::uint8_t digest[28];
+        StateToDigest(h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7], 28, digest);
+        BytesToHex(digest, 28, &res[i][0]);
+    }
+
+    return res;
+}
+
+/**
+    \brief A function for calculating the second pass of sha256d
+
+    With hardware accelerated kernels the block with the first pass result and the constant padding is hashed with the Sha256Steps function,
+    otherwise the scalar kernel with the folded padding words is used
+
+    \param [in, out] h0 the first pass state variable 0 on input, the sha256d state variable 0 on output
+    \param [in, out] h1 the first pass state variable 1 on input, the sha256d state variable 1 on output
+    \param [in, out] h2 the first pass state variable 2 on input, the sha256d state variable 2 on output
+    \param [in, out] h3 the first pass state variable 3 on input, the sha256d state variable 3 on output
+    \param [in, out] h4 the first pass state variable 4 on input, the sha256d state variable 4 on output
+    \param [in, out] h5 the first pass state variable 5 on input, the sha256d state variable 5 on output
+    \param [in, out] h6 the first pass state variable 6 on input, the sha256d state variable 6 on output
+    \param [in, out] h7 the first pass state variable 7 on input, the sha256d state variable 7 on output
+*/
+void Sha256dSecondPass(std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7) noexcept
+{
+    static const bool isAccelerated = SelectSha256Steps() != Sha256StepsScalar;
+
+    if (!isAccelerated)
+        return Sha256dSecondPassScalar(h0, h1, h2, h3, h4, h5, h6, h7);
+
+    // Block with the first pass result and the padding of a 32 byte message
+    char block[64] = {};
+    StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, 32, reinterpret_cast<std::uint8_t*>(block));
+    block[32] = static_cast<char>(0x80);
+    block[62] = 1;
+
+    h0 = 0x6a09e667, h1 = 0xbb67ae85, h2 = 0x3c6ef372, h3 = 0xa54ff53a, h4 = 0x510e527f, h5 = 0x9b05688c, h6 = 0x1f83d9ab, h7 = 0x5be0cd19;
+    Sha256Steps(block, 1, h0, h1, h2, h3, h4, h5, h6, h7);
+}
+
+Sha256Digest Sha256dBinary(const char* data, const std::size_t& dataLen) noexcept
+{
+    // Begin hash values
+    std::uint32_t h0 = 0x6a09e667, h1 = 0xbb67ae85, h2 = 0x3c6ef372, h3 = 0xa54ff53a, h4 = 0x510e527f, h5 = 0x9b05688c, h6 = 0x1f83d9ab, h7 = 0x5be0cd19;
+
+    // Calculate both passes
+    HashSha256(data, dataLen, h0, h1, h2, h3, h4, h5, h6, h7);
+    Sha256dSecondPass(h0, h1, h2, h3, h4, h5, h6, h7);
+
+    // Return calculated hash
+    Sha256Digest res;
+    StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, res.size(), res.data());
+    return res;
+}
+
+Sha256Digest Sha256dBinary(const std::string& str) noexcept
+{
+    return Sha256dBinary(str.c_str(), str.length());
+}
+
+std::string Sha256d(const char* data, const std::size_t& dataLen) noexcept
+{
+    return DigestToHex(Sha256dBinary(data, dataLen));
+}
+
+std::string Sha256d(const std::string& str) noexcept
+{
+    return Sha256d(str.c_str(), str.length());
+}
+
+void Sha256Midstate(const char* block, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7) noexcept
+{
+    h0 = 0x6a09e667, h1 = 0xbb67ae85, h2 = 0x3c6ef372, h3 = 0xa54ff53a, h4 = 0x510e527f, h5 = 0x9b05688c, h6 = 0x1f83d9ab, h7 = 0x5be0cd19;
+    Sha256Steps(block, 1, h0, h1, h2, h3, h4, h5, h6, h7);
+}
+
+Sha256Digest Sha256dFromMidstate(const std::uint32_t& h0, const std::uint32_t& h1, const std::uint32_t& h2, const std::uint32_t& h3, const std::uint32_t& h4, const std::uint32_t& h5, const std::uint32_t& h6, const std::uint32_t& h7, const char* tail, const std::size_t& tailLen) noexcept
+{
+    std::uint32_t s0 = h0, s1 = h1, s2 = h2, s3 = h3, s4 = h4, s5 = h5, s6 = h6, s7 = h7;
+
+    // Finish the first pass from the midstate. The length in the padding counts the first 64 bytes too
+    Sha256Steps(tail, tailLen >> 6, s0, s1, s2, s3, s4, s5, s6, s7);
+    char padding[128];
+    int paddingLen = DataPaddingSha256(tail + (tailLen & ~0b00111111), tailLen & 0b00111111, 64 + tailLen, padding);
+    Sha256Steps(padding, paddingLen >> 6, s0, s1, s2, s3, s4, s5, s6, s7);
+
+    Sha256dSecondPass(s0, s1, s2, s3, s4, s5, s6, s7);
+
+    Sha256Digest res;
+    StateToDigest(s0, s1, s2, s3, s4, s5, s6, s7, res.size(), res.data());
+    return res;
+}
+
+#ifdef SHA2_X86_KERNELS
+/**
+    \brief A function for calculating the sha256d hash sums of many messages with a common midstate in parallel SIMD lanes
+
+    The tail blocks of every lane are padded once, only the tail in the beginning of the blocks is rewritten for the next group of messages.
+    Free lanes of the last group repeat the last message and their results are ignored
+
+    \param [in] lanesCount the number of lanes in the kernels. Must be less than or equal to 16
+    \param [in] step the multi-lane hashing step
+    \param [in] secondPass the multi-lane second pass of sha256d
+    \param [in] midstate the midstate of the common beginning, state variable i in midstate[i]
+    \param [in] tails the tails one after another, the tail i starts at tails + i * tailLen
+    \param [in] tailLen length of every tail. Must be less than 64
+    \param [in] count the number of messages
+    \param [out] digests the binary sha256d hash sums one after another, 32 bytes each
+*/
+void Sha256dLanes(const int& lanesCount, void (*step)(const char* const*, std::uint32_t*), void (*secondPass)(std::uint32_t*), const std::uint32_t* midstate, const char* tails, const std::size_t& tailLen, const std::size_t& count, std::uint8_t* digests) noexcept
+{
+    // Internal state variables of all lanes
+    alignas(64) std::uint32_t state[8 * 16];
+
+    // Prebuilt tail blocks of every lane and pointers to their first and second blocks
+    char blocks[16][128];
+    const char* pointers[2][16];
+
+    const char zeros[64] = {};
+    int blocksCount = 0;
+    for (int lane = 0; lane < lanesCount; ++lane)
+    {
+        blocksCount = DataPaddingSha256(zeros, tailLen, 64 + tailLen, blocks[lane]) >> 6;
+        pointers[0][lane] = blocks[lane];
+        pointers[1][lane] = blocks[lane] + 64;
+    }
+
+    RecordSha2Blocks(Sha2MetricsFamily::Sha256, count * (blocksCount + 1));
+
+    for (std::size_t first = 0; first < count; first += lanesCount)
+    {
+        // Number of the lanes with messages
+        int lanes = static_cast<int>(std::min(count - first, static_cast<std::size_t>(lanesCount)));
+
+        for (int lane = 0; lane < lanesCount; ++lane)
+        {
+            memcpy(blocks[lane], tails + (first + std::min(lane, lanes - 1)) * tailLen, tailLen);
+            for (int i = 0; i < 8; ++i)
+                state[i * lanesCount + lane] = midstate[i];
+        }
+
+        // Finish the first pass and calculate the second one
+        for (int i = 0; i < blocksCount; ++i)
+            step(pointers[i], state);
+        secondPass(state);
+
+        for (int lane = 0; lane < lanes; ++lane)
+            for (int i = 0; i < 8; ++i)
+                Uint32ToBytes(state[i * lanesCount + lane], reinterpret_cast<char*>(digests + (first + lane) * 32 + (i << 2)));
+    }
+}
+#endif // SHA2_X86_KERNELS
+
+void Sha256dFromMidstateBatch(const std::uint32_t* midstate, const char* tails, const std::size_t& tailLen, const std::size_t& count, std::uint8_t* digests) noexcept
+{
+#ifdef SHA2_X86_KERNELS
+    static const bool isAvx512Supported = IsAvx512Supported();
+    static const bool isAvx2Supported = IsAvx2Supported() && !IsShaNiSupported();
+
+    if (isAvx512Supported && count > 1 && tailLen < 64)
+        return Sha256dLanes(16, Sha256StepAvx512x16, Sha256dSecondPassAvx512x16, midstate, tails, tailLen, count, digests);
+
+    if (isAvx2Supported && count > 1 && tailLen < 64)
+        return Sha256dLanes(8, Sha256StepAvx2x8, Sha256dSecondPassAvx2x8, midstate, tails, tailLen, count, digests);
+#endif // SHA2_X86_KERNELS
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Sha256Digest digest = Sha256dFromMidstate(midstate[0], midstate[1], midstate[2], midstate[3], midstate[4], midstate[5], midstate[6], midstate[7], tails + i * tailLen, tailLen);
+        memcpy(digests + i * 32, digest.data(), 32);
+    }
+}
+
+#ifdef SHA2_X86_KERNELS
+/**
+    \brief A function for calculating the parent nodes of a Merkle tree level in parallel SIMD lanes
+
+    Free lanes of the last group repeat the last parent and their results are ignored
+
+    \param [in] lanesCount the number of lanes in the kernels. Must be less than or equal to 16
+    \param [in] step the multi-lane hashing step
+    \param [in] padding the multi-lane hashing of the padding block of 64 byte messages
+    \param [in] children the binary children one after another, 2 * count digests of 32 bytes
+    \param [in] count the number of parents
+    \param [out] parents the binary parents one after another, 32 bytes each
+*/
+void Sha256NodesLanes(const int& lanesCount, void (*step)(const char* const*, std::uint32_t*), void (*padding)(std::uint32_t*), const std::uint8_t* children, const std::size_t& count, std::uint8_t* parents) noexcept
+{
+    RecordSha2Blocks(Sha2MetricsFamily::Sha256, count * 2);
+
+    // Begin hash values
+    const std::uint32_t beginHash[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+    // Internal state variables of all lanes
+    alignas(64) std::uint32_t state[8 * 16];
+
+    // Pointers to the pairs of children of every lane
+    const char* blocks[16];
+
+    for (std::size_t first = 0; first < count; first += lanesCount)
+    {
+        // Number of the lanes with parents
+        int lanes = static_cast<int>(std::min(count - first, static_cast<std::size_t>(lanesCount)));
+
+        for (int lane = 0; lane < lanesCount; ++lane)
+        {
+            blocks[lane] = reinterpret_cast<const char*>(children) + (first + std::min(lane, lanes - 1)) * 64;
+            for (int i = 0; i < 8; ++i)
+                state[i * lanesCount + lane] = beginHash[i];
+        }
+
+        step(blocks, state);
+        padding(state);
+
+        for (int lane = 0; lane < lanes; ++lane)
+            for (int i = 0; i < 8; ++i)
+                Uint32ToBytes(state[i * lanesCount + lane], reinterpret_cast<char*>(parents + (first + lane) * 32 + (i << 2)));
+    }
+}
+#endif // SHA2_X86_KERNELS
+
+void HashSha256Nodes(const std::uint8_t* children, const std::size_t& count, std::uint8_t* parents) noexcept
+{
+#ifdef SHA2_X86_KERNELS
+    static const bool isAvx512Supported = IsAvx512Supported();
+    static const bool isAvx2Supported = IsAvx2Supported() && !IsShaNiSupported();
+
+    if (isAvx512Supported && count > 1)
+        return Sha256NodesLanes(16, Sha256StepAvx512x16, Sha256NodePaddingAvx512x16, children, count, parents);
+
+    if (isAvx2Supported && count > 1)
+        return Sha256NodesLanes(8, Sha256StepAvx2x8, Sha256NodePaddingAvx2x8, children, count, parents);
+#endif // SHA2_X86_KERNELS
+
+    // With hardware accelerated kernels the prebuilt padding block is faster than the scalar rounds
+    static const bool isAccelerated = SelectSha256Steps() != Sha256StepsScalar;
+    char padding[64] = {};
+    padding[0] = static_cast<char>(0x80);
+    padding[62] = 2;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::uint32_t h0 = 0x6a09e667, h1 = 0xbb67ae85, h2 = 0x3c6ef372, h3 = 0xa54ff53a, h4 = 0x510e527f, h5 = 0x9b05688c, h6 = 0x1f83d9ab, h7 = 0x5be0cd19;
+        Sha256Steps(reinterpret_cast<const char*>(children) + i * 64, 1, h0, h1, h2, h3, h4, h5, h6, h7);
+
+        if (isAccelerated)
+            Sha256Steps(padding, 1, h0, h1, h2, h3, h4, h5, h6, h7);
+        else
+            Sha256NodePaddingScalar(h0, h1, h2, h3, h4, h5, h6, h7);
+
+        StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, 32, parents + i * 32);
+    }
+}
+
+bool HashFileSha256Resumable(const std::string& fileName, Sha256Context& context, const std::function<void(const std::string&)>& checkpoint, const std::uint64_t& checkpointInterval, const std::size_t& chunkSize)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    // Skip the already hashed part of the file
+    if (context.Length() > 0)
+    {
+        file.seekg(0, std::ios::end);
+        if (!file || static_cast<std::uint64_t>(file.tellg()) < context.Length())
+            return false;
+        file.seekg(context.Length(), std::ios::beg);
+    }
+
+    std::vector<char> chunk(std::max(chunkSize, static_cast<std::size_t>(1)));
+    std::uint64_t nextCheckpoint = context.Length() + checkpointInterval;
+
+    while (file)
+    {
+        file.read(chunk.data(), chunk.size());
+        context.Update(chunk.data(), static_cast<std::size_t>(file.gcount()));
+
+        if (checkpointInterval > 0 && context.Length() >= nextCheckpoint)
+        {
+            checkpoint(context.Export());
+            nextCheckpoint = context.Length() + checkpointInterval;
+        }
+    }
+
+    return file.eof();
+}
+
+std::string ResumableFileSha256(const std::string& fileName, const std::string& checkpointFileName, const Sha256Variant& variant, const std::uint64_t& checkpointInterval, const std::size_t& chunkSize) noexcept
+{
+    Sha256Context context(variant);
+
+    // The checkpoint starts with the version tag of the file, so the state saved for another version of the file is not resumed
+    std::string fileTag = FileVersionTag(fileName);
+
+    // Load the saved state. The damaged state, the state of another algorithm or of another version of the file is ignored
+    std::ifstream checkpointFile(checkpointFileName, std::ios::binary);
+    if (checkpointFile.is_open())
+    {
+        std::string state((std::istreambuf_iterator<char>(checkpointFile)), std::istreambuf_iterator<char>());
+        if (fileTag.empty() || state.compare(0, fileTag.length(), fileTag) != 0 || !context.Import(state.substr(fileTag.length())) || context.Variant() != variant)
+            context = Sha256Context(variant);
+    }
+    checkpointFile.close();
+
+    auto checkpoint = [&checkpointFileName, &fileTag](const std::string& state)
+    {
+        ReplaceFileContent(checkpointFileName, fileTag + state);
+    };
+
+    // The saved state does not match the file, so hash the file from the beginning
+    if (!HashFileSha256Resumable(fileName, context, checkpoint, checkpointInterval, chunkSize))
+    {
+        context = Sha256Context(variant);
+        if (!HashFileSha256Resumable(fileName, context, checkpoint, checkpointInterval, chunkSize)) {std::cerr << "Can not open file: " << fileName << std::endl; return "";}
+    }
+
+    std::error_code error;
+    std::filesystem::remove(checkpointFileName, error);
+
+    return context.Final();
+}
+
+Sha256Digest HmacSha256Binary(const char* key, const std::size_t& keyLen, const char* data, const std::size_t& dataLen) noexcept
+{
+    Sha256Digest res;
+    HmacSha256Key(key, keyLen, Sha256Variant::Sha256).Mac(data, dataLen, res.data());
+    return res;
+}
+
+std::string HmacSha256(const std::string& key, const std::string& str) noexcept
+{
+    return DigestToHex(HmacSha256Binary(key.c_str(), key.length(), str.c_str(), str.length()));
+}
+
+Sha224Digest HmacSha224Binary(const char* key, const std::size_t& keyLen, const char* data, const std::size_t& dataLen) noexcept
+{
+    Sha224Digest res;
+    HmacSha256Key(key, keyLen, Sha256Variant::Sha224).Mac(data, dataLen, res.data());
+    return res;
+}
+
+std::string HmacSha224(const std::string& key, const std::string& str) noexcept
+{
+    return DigestToHex(HmacSha224Binary(key.c_str(), key.length(), str.c_str(), str.length()));
+}
+
+#ifdef SHA2_X86_KERNELS
+/**
+    \brief A function for calculating the iterations of many pbkdf2 blocks in parallel SIMD lanes
+
+    All blocks have the same number of iterations, so the blocks are processed in groups of lanesCount blocks.
+    The inner and outer blocks of the iterations always have the same length, so their padding is built once and only the hash sum in the beginning of the blocks is rewritten.
+    Free lanes of the last group repeat the last block and their results are ignored
+
+    \param [in] lanesCount the number of lanes in the kernel. Must be less than or equal to 16
+    \param [in] step the multi-lane hashing step
+    \param [in] innerStates an array of the hmac inner states of the blocks. The state variable i of the block j is innerStates[j * 8 + i]
+    \param [in] outerStates an array of the hmac outer states of the blocks. The state variable i of the block j is outerStates[j * 8 + i]
+    \param [in] count the number of blocks
+    \param [in] iterations the number of iterations
+    \param [in] digestLen the length of the hash sum in bytes
+    \param [in, out] results an array with the first iteration results of the blocks. The results of all iterations are xored into it. The word i of the block j is results[j * 8 + i]
+*/
+void Pbkdf2Sha256Lanes(const int& lanesCount, void (*step)(const char* const*, std::uint32_t*), const std::uint32_t* innerStates, const std::uint32_t* outerStates, const std::size_t& count, const std::uint64_t& iterations, const std::size_t& digestLen, std::uint32_t* results) noexcept
+{
+    // Every iteration after the first one hashes an inner and an outer block
+    RecordSha2Blocks(Sha2MetricsFamily::Sha256, count * 2 * (iterations > 0 ? iterations - 1 : 0));
+
+    // Internal state variables of all lanes
+    alignas(64) std::uint32_t state[8 * 16];
+
+    // Result of the previous iteration in every lane
+    std::uint32_t u[8 * 16] = {};
+
+    // Prebuilt inner and outer blocks of every lane
+    char innerBlocks[16][128], outerBlocks[16][128];
+    const char* innerPointers[16];
+    const char* outerPointers[16];
+
+    // Number of words in the hash sum
+    std::size_t wordsCount = digestLen >> 2;
+
+    const char zeros[64] = {};
+    for (int lane = 0; lane < lanesCount; ++lane)
+    {
+        DataPaddingSha256(zeros, digestLen, 64 + digestLen, innerBlocks[lane]);
+        memcpy(outerBlocks[lane], innerBlocks[lane], 64);
+        innerPointers[lane] = innerBlocks[lane];
+        outerPointers[lane] = outerBlocks[lane];
+    }
+
+    for (std::size_t first = 0; first < count; first += lanesCount)
+    {
+        // Number of the lanes with blocks
+        int lanes = static_cast<int>(std::min(count - first, static_cast<std::size_t>(lanesCount)));
+
+        for (int lane = 0; lane < lanesCount; ++lane)
+            for (std::size_t i = 0; i < wordsCount; ++i)
+                u[lane * 8 + i] = results[(first + std::min(lane, lanes - 1)) * 8 + i];
+
+        for (std::uint64_t iteration = 1; iteration < iterations; ++iteration)
+        {
+            // Inner hash of the previous result
+            for (int lane = 0; lane < lanesCount; ++lane)
+            {
+                const std::uint32_t* innerState = innerStates + (first + std::min(lane, lanes - 1)) * 8;
+                for (std::size_t i = 0; i < wordsCount; ++i)
+                    Uint32ToBytes(u[lane * 8 + i], innerBlocks[lane] + (i << 2));
+                for (int i = 0; i < 8; ++i)
+                    state[i * lanesCount + lane] = innerState[i];
+            }
+            step(innerPointers, state);
+
+            // Outer hash of the inner hash
+            for (int lane = 0; lane < lanesCount; ++lane)
+            {
+                const std::uint32_t* outerState = outerStates + (first + std::min(lane, lanes - 1)) * 8;
+                for (std::size_t i = 0; i < wordsCount; ++i)
+                    Uint32ToBytes(state[i * lanesCount + lane], outerBlocks[lane] + (i << 2));
+                for (int i = 0; i < 8; ++i)
+                    state[i * lanesCount + lane] = outerState[i];
+            }
+            step(outerPointers, state);
+
+            // Xor the iteration result into the block result
+            for (int lane = 0; lane < lanesCount; ++lane)
+                for (std::size_t i = 0; i < wordsCount; ++i)
+                    u[lane * 8 + i] = state[i * lanesCount + lane];
+
+            for (int lane = 0; lane < lanes; ++lane)
+                for (std::size_t i = 0; i < wordsCount; ++i)
+                    results[(first + lane) * 8 + i] ^= u[lane * 8 + i];
+        }
+    }
+}
+#endif // SHA2_X86_KERNELS
+
+/**
+    \brief A function for calculating the iterations of many pbkdf2 blocks
+
+    If the processor supports AVX-512 the blocks are processed in 16 parallel SIMD lanes.
+    On processors with SHA extensions every block is processed separately with the Sha256Steps function, because it is faster than 8 AVX2 lanes.
+    Otherwise AVX2 lanes are used if they are supported
+
+    \param [in] innerStates an array of the hmac inner states of the blocks. The state variable i of the block j is innerStates[j * 8 + i]
+    \param [in] outerStates an array of the hmac outer states of the blocks. The state variable i of the block j is outerStates[j * 8 + i]
+    \param [in] count the number of blocks
+    \param [in] iterations the number of iterations
+    \param [in] digestLen the length of the hash sum in bytes
+    \param [in, out] results an array with the first iteration results of the blocks. The results of all iterations are xored into it. The word i of the block j is results[j * 8 + i]
+*/
+void Pbkdf2Sha256Iterations(const std::uint32_t* innerStates, const std::uint32_t* outerStates, const std::size_t& count, const std::uint64_t& iterations, const std::size_t& digestLen, std::uint32_t* results) noexcept
+{
+#ifdef SHA2_X86_KERNELS
+    static const bool isAvx512Supported = IsAvx512Supported();
+    static const bool isAvx2Supported = IsAvx2Supported() && !IsShaNiSupported();
+
+    if (isAvx512Supported && count > 1)
+        return Pbkdf2Sha256Lanes(16, Sha256StepAvx512x16, innerStates, outerStates, count, iterations, digestLen, results);
+
+    if (isAvx2Supported && count > 1)
+        return Pbkdf2Sha256Lanes(8, Sha256StepAvx2x8, innerStates, outerStates, count, iterations, digestLen, results);
+#endif // SHA2_X86_KERNELS
+
+    for (std::size_t j = 0; j < count; ++j)
+    {
+        const std::uint32_t* innerState = innerStates + j * 8;
+        const std::uint32_t* outerState = outerStates + j * 8;
+        std::uint32_t* result = results + j * 8;
+
+        // Prebuilt block for inner and outer hashes. Only the hash sum in the beginning of the block changes
+        char block[128];
+        const char zeros[64] = {};
+        DataPaddingSha256(zeros, digestLen, 64 + digestLen, block);
+
+        // Result of the previous iteration
+        std::uint32_t h0 = result[0], h1 = result[1], h2 = result[2], h3 = result[3], h4 = result[4], h5 = result[5], h6 = result[6], h7 = result[7];
+
+        for (std::uint64_t iteration = 1; iteration < iterations; ++iteration)
+        {
+            // Inner hash of the previous result
+            StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, digestLen, reinterpret_cast<std::uint8_t*>(block));
+            h0 = innerState[0], h1 = innerState[1], h2 = innerState[2], h3 = innerState[3], h4 = innerState[4], h5 = innerState[5], h6 = innerState[6], h7 = innerState[7];
+            Sha256Steps(block, 1, h0, h1, h2, h3, h4, h5, h6, h7);
+
+            // Outer hash of the inner hash
+            StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, digestLen, reinterpret_cast<std::uint8_t*>(block));
+            h0 = outerState[0], h1 = outerState[1], h2 = outerState[2], h3 = outerState[3], h4 = outerState[4], h5 = outerState[5], h6 = outerState[6], h7 = outerState[7];
+            Sha256Steps(block, 1, h0, h1, h2, h3, h4, h5, h6, h7);
+
+            result[0] ^= h0, result[1] ^= h1, result[2] ^= h2, result[3] ^= h3, result[4] ^= h4, result[5] ^= h5, result[6] ^= h6, result[7] ^= h7;
+        }
+    }
+}
+
+void Pbkdf2Sha256(const HmacSha256Key* keys, const std::size_t& keysCount, const char* salt, const std::size_t& saltLen, const std::uint64_t& iterations, const std::size_t& derivedKeyLen, std::uint8_t* derivedKeys)
+{
+    if (keysCount == 0 || derivedKeyLen == 0)
+        return;
+
+    // The blocks of the keys of different variants have different lengths, so such keys are derived in groups of the same variant
+    if (std::any_of(keys + 1, keys + keysCount, [&keys](const HmacSha256Key& key) { return key.Variant() != keys[0].Variant(); }))
+    {
+        std::vector<bool> isDerived(keysCount, false);
+        for (std::size_t first = 0; first < keysCount; ++first)
+        {
+            if (isDerived[first])
+                continue;
+
+            std::vector<std::size_t> indexes;
+            std::vector<HmacSha256Key> group;
+            for (std::size_t k = first; k < keysCount; ++k)
+            {
+                if (keys[k].Variant() != keys[first].Variant())
+                    continue;
+
+                indexes.push_back(k);
+                group.push_back(keys[k]);
+                isDerived[k] = true;
+            }
+
+            std::vector<std::uint8_t> groupKeys(group.size() * derivedKeyLen);
+            Pbkdf2Sha256(group.data(), group.size(), salt, saltLen, iterations, derivedKeyLen, groupKeys.data());
+            for (std::size_t i = 0; i < indexes.size(); ++i)
+                memcpy(derivedKeys + indexes[i] * derivedKeyLen, groupKeys.data() + i * derivedKeyLen, derivedKeyLen);
+        }
+
+        return;
+    }
+
+    std::size_t digestLen = keys[0].Variant() == Sha256Variant::Sha256 ? 32 : 28;
+    std::size_t blocksCount = (derivedKeyLen + digestLen - 1) / digestLen;
+
+    std::vector<std::uint32_t> innerStates(keysCount * blocksCount * 8), outerStates(keysCount * blocksCount * 8), results(keysCount * blocksCount * 8);
+
+    for (std::size_t k = 0; k < keysCount; ++k)
+    {
+        HmacSha256Context context(keys[k]);
+
+        for (std::size_t b = 0; b < blocksCount; ++b)
+        {
+            std::size_t j = k * blocksCount + b;
+            keys[k].InnerState(innerStates.data() + j * 8);
+            keys[k].OuterState(outerStates.data() + j * 8);
+
+            // First iteration is the hmac of the salt and the block index
+            char index[4];
+            Uint32ToBytes(static_cast<std::uint32_t>(b + 1), index);
+            context.Update(salt, saltLen);
+            context.Update(index, 4);
+
+            std::uint8_t digest[32] = {};
+            context.Final(digest);
+            for (int i = 0; i < 8; ++i)
+                results[j * 8 + i] = (static_cast<std::uint32_t>(digest[i * 4]) << 24) | (static_cast<std::uint32_t>(digest[i * 4 + 1]) << 16) |
+                    (static_cast<std::uint32_t>(digest[i * 4 + 2]) << 8) | static_cast<std::uint32_t>(digest[i * 4 + 3]);
+        }
+    }
+
+    Pbkdf2Sha256Iterations(innerStates.data(), outerStates.data(), keysCount * blocksCount, iterations, digestLen, results.data());
+
+    // Concatenate the blocks and truncate the last one
+    for (std::size_t k = 0; k < keysCount; ++k)
+    {
+        for (std::size_t b = 0; b < blocksCount; ++b)
+        {
+            const std::uint32_t* t = results.data() + (k * blocksCount + b) * 8;
+            StateToDigest(t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], std::min(digestLen, derivedKeyLen - b * digestLen), derivedKeys + k * derivedKeyLen + b * digestLen);
+        }
+    }
+}
+
+void Pbkdf2HmacSha256Binary(const char* password, const std::size_t& passwordLen, const char* salt, const std::size_t& saltLen, const std::uint64_t& iterations, const std::size_t& derivedKeyLen, std::uint8_t* derivedKey, const Sha256Variant& variant)
+{
+    HmacSha256Key key(password, passwordLen, variant);
+    Pbkdf2Sha256(&key, 1, salt, saltLen, iterations, derivedKeyLen, derivedKey);
+}
+
+std::string Pbkdf2HmacSha256(const std::string& password, const std::string& salt, const std::uint64_t& iterations, const std::size_t& derivedKeyLen)
+{
+    std::vector<std::uint8_t> derivedKey(derivedKeyLen);
+    Pbkdf2HmacSha256Binary(password.c_str(), password.length(), salt.c_str(), salt.length(), iterations, derivedKeyLen, derivedKey.data());
+
+    std::string res(derivedKeyLen * 2, 0);
+    BytesToHex(derivedKey.data(), derivedKeyLen, &res[0]);
+    return res;
+}
+
+std::vector<std::string> Pbkdf2HmacSha256Batch(const std::vector<std::string>& passwords, const std::string& salt, const std::uint64_t& iterations, const std::size_t& derivedKeyLen)
+{
+    std::vector<HmacSha256Key> keys;
+    keys.reserve(passwords.size());
+    for (const std::string& password : passwords)
+        keys.emplace_back(password);
+
+    std::vector<std::uint8_t> derivedKeys(passwords.size() * derivedKeyLen);
+    Pbkdf2Sha256(keys.data(), keys.size(), salt.c_str(), salt.length(), iterations, derivedKeyLen, derivedKeys.data());
+
+    std::vector<std::string> res(passwords.size(), std::string(derivedKeyLen * 2, 0));
+    for (std::size_t k = 0; k < passwords.size(); ++k)
+        BytesToHex(derivedKeys.data() + k * derivedKeyLen, derivedKeyLen, &res[k][0]);
+    return res;
+}
+
+std::vector<std::string> PipelinedFilesSha256(const std::vector<std::string>& files, const Sha256Variant& variant, const std::size_t& chunkSize, const unsigned int& depth, const unsigned int& openFilesCount) noexcept
+{
+    std::vector<Sha256Context> contexts(files.size(), Sha256Context(variant));
+    std::vector<std::string> res(files.size());
+    std::vector<bool> isFailed;
+
+    ReadFilesPipelined(files, std::max(chunkSize & ~static_cast<std::size_t>(0b00111111), static_cast<std::size_t>(64)), depth, openFilesCount,
+        [&](const std::size_t& file, const char* data, const std::size_t& len, const bool& isLast)
+        {
+            contexts[file].Update(data, len);
+            if (isLast)
+                res[file] = contexts[file].Final();
+        }, isFailed);
+
+    for (std::size_t i = 0; i < files.size(); ++i)
+        if (isFailed[i]) {std::cerr << "Can not read file: " << files[i] << std::endl; res[i].clear();}
+
+    return res;
+}
+
+std::string PipelinedFileSha256(const std::string& fileName, const std::size_t& chunkSize) noexcept
+{
+    return PipelinedFilesSha256({ fileName }, Sha256Variant::Sha256, chunkSize)[0];
+}
+
+#ifdef SHA2_POSIX_FILES
+/// \brief Leaf of a mapped file hashed with the sha256 algorithm under the protection against the truncation of the file
+struct MappedLeafSha256
+{
+    // Pages of the leaf
+    const char* data;
+    std::size_t dataLen;
+
+    // Internal state variables of the leaf
+    std::uint32_t* h;
+};
+
+/**
+    \brief A function for hashing a leaf of a mapped file
+
+    \param [in, out] argument the MappedLeafSha256 structure
+*/
+static void HashMappedLeafSha256(void* argument) noexcept
+{
+    MappedLeafSha256& leaf = *static_cast<MappedLeafSha256*>(argument);
+    HashSha256(leaf.data, leaf.dataLen, leaf.h[0], leaf.h[1], leaf.h[2], leaf.h[3], leaf.h[4], leaf.h[5], leaf.h[6], leaf.h[7]);
+}
+#endif // SHA2_POSIX_FILES
+
+/**
+    \brief A function for calculating the tree hash of a file using the sha256 algorithm
+
+    The file is split into leaves of leafSize bytes, the last leaf can be shorter. An empty file has one empty leaf.
+    Every leaf is hashed with sha256 on its own, so the leaves are hashed in parallel threads.
+    The nodes of every level are combined in pairs: node = sha256(0x01 || left || right), the unpaired last node is moved to the next level unchanged.
+    The result is root = sha256(0x02 || leafSize || fileSize || top node), where leafSize and fileSize are 8 byte big endian numbers,
+    so the same data hashed with a different leaf size gives a different root
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [in] leafSize the size of the leaves in bytes. Must be greater than 0
+    \param [in] threadsCount the number of threads to hash the leaves
+    \param [out] root an array for 8 internal state variables of the root hash
+
+    \return true if the hash was calculated, false if the file cannot be opened, its size is unknown or it was truncated during the hashing
+*/
+bool HashTreeFileSha256(const std::string& fileName, const std::size_t& leafSize, const unsigned int& threadsCount, std::uint32_t* root)
+{
+    // Begin hash values
+    const std::uint32_t beginHash[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+    if (leafSize == 0)
+        return false;
+
+    // Pointer to the file mapped to memory. Equals nullptr if the file is read with streams
+    const char* mapping = nullptr;
+    std::uint64_t fileSize = 0;
+
+#ifdef SHA2_POSIX_FILES
+    // Get file size from the descriptor which is mapped, so the size and the mapping belong to the same file
+    int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+        return false;
+
+    struct stat fileStat;
+    if (fstat(fileDescriptor, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+    {
+        close(fileDescriptor);
+        return false;
+    }
+
+    fileSize = static_cast<std::uint64_t>(fileStat.st_size);
+    if (fileSize > 0 && fileSize <= SIZE_MAX)
+    {
+        void* mapped = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if (mapped != MAP_FAILED)
+            mapping = static_cast<const char*>(mapped);
+    }
+
+    close(fileDescriptor);
+#else
+    // Get file size
+    std::ifstream sizeFile(fileName, std::ios_base::binary | std::ios_base::ate);
+    if (!sizeFile.is_open() || sizeFile.tellg() < 0)
+        return false;
+
+    fileSize = sizeFile.tellg();
+    sizeFile.close();
+#endif // SHA2_POSIX_FILES
+
+    std::size_t leavesCount = std::max((fileSize + leafSize - 1) / leafSize, static_cast<std::uint64_t>(1));
+
+    // Internal state variables of every node on the current level
+    std::vector<std::uint32_t> nodes(leavesCount * 8);
+
+    // Index of the next leaf to hash
+    std::atomic<std::size_t> nextLeaf(0);
+
+    // Flag of read errors in threads
+    std::atomic<bool> isFailed(false);
+
+    auto hashLeaves = [&]()
+    {
+        std::ifstream file;
+        std::vector<char> buffer;
+
+        if (mapping == nullptr)
+        {
+            file.open(fileName, std::ios_base::binary);
+            buffer.resize(leafSize);
+        }
+
+        for (std::size_t leaf = nextLeaf++; leaf < leavesCount && !isFailed; leaf = nextLeaf++)
+        {
+            std::uint64_t offset = static_cast<std::uint64_t>(leaf) * leafSize;
+            std::size_t leafLen = std::min(static_cast<std::uint64_t>(leafSize), fileSize - offset);
+            std::uint32_t* h = nodes.data() + leaf * 8;
+            memcpy(h, beginHash, sizeof(beginHash));
+
+            // Read leaf from file
+            if (mapping == nullptr)
+            {
+                file.seekg(offset);
+                file.read(buffer.data(), leafLen);
+                if (static_cast<std::size_t>(file.gcount()) != leafLen) { isFailed = true; break; }
+                HashSha256(buffer.data(), leafLen, h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7]);
+                continue;
+            }
+
+#ifdef SHA2_POSIX_FILES
+            // Hash the mapped leaf. If the file is truncated by another process the hashing fails instead of killing the process
+            MappedLeafSha256 mappedLeaf = { mapping + offset, leafLen, h };
+            if (!RunGuardedMappedRead(HashMappedLeafSha256, &mappedLeaf)) { isFailed = true; break; }
+#endif // SHA2_POSIX_FILES
+        }
+    };
+
+    // Hash leaves in parallel
+    std::vector<std::thread> threads;
+    try
+    {
+        for (unsigned int i = 1; i < std::min(static_cast<std::size_t>(std::max(threadsCount, 1u)), leavesCount); ++i)
+            threads.emplace_back(hashLeaves);
+    }
+    catch (...)
+    {
+        // The leaves of the threads which can not be started are hashed by the calling thread
+    }
+
+    hashLeaves();
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+#ifdef SHA2_POSIX_FILES
+    if (mapping != nullptr)
+        munmap(const_cast<char*>(mapping), fileSize);
+#endif // SHA2_POSIX_FILES
+
+    if (isFailed)
+        return false;
+
+    // Combine nodes level by level
+    char node[65];
+    node[0] = 0x01;
+    for (std::size_t count = leavesCount; count > 1; count = (count + 1) >> 1)
+    {
+        for (std::size_t i = 0; i < count >> 1; ++i)
+        {
+            for (int j = 0; j < 16; ++j)
+                Uint32ToBytes(nodes[i * 16 + j], node + 1 + j * 4);
+
+            std::uint32_t* h = nodes.data() + i * 8;
+            memcpy(h, beginHash, sizeof(beginHash));
+            HashSha256(node, 65, h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7]);
+        }
+
+        // Move unpaired node to the next level
+        if (count & 1)
+            memcpy(nodes.data() + (count >> 1) * 8, nodes.data() + (count - 1) * 8, 8 * sizeof(std::uint32_t));
+    }
+
+    // Calculate root hash
+    char rootData[49];
+    rootData[0] = 0x02;
+    for (int i = 0; i < 8; ++i)
+    {
+        rootData[1 + i] = static_cast<char>(static_cast<std::uint64_t>(leafSize) >> (56 - i * 8));
+        rootData[9 + i] = static_cast<char>(fileSize >> (56 - i * 8));
+        Uint32ToBytes(nodes[i], rootData + 17 + i * 4);
+    }
+
+    memcpy(root, beginHash, sizeof(beginHash));
+    HashSha256(rootData, 49, root[0], root[1], root[2], root[3], root[4], root[5], root[6], root[7]);
+    return true;
+}
+
+std::string TreeFileSha256(const std::string& fileName, const std::size_t& leafSize, const unsigned int& threadsCount) noexcept
+{
+    std::uint32_t h[8];
+
+    // Calculate tree hash for file
+    if (!HashTreeFileSha256(fileName, leafSize, threadsCount, h)) {std::cerr << "Can not hash file: " << fileName << std::endl; return "";}
+
+    // Return calculated hash
+    Sha256Digest digest;
+    StateToDigest(h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7], digest.size(), digest.data());
+    return DigestToHex(digest);
+}
+
+bool VerifyTreeFileSha256(const std::string& fileName, const std::string& treeHash, const std::size_t& leafSize, const unsigned int& threadsCount) noexcept
+{
+    std::uint32_t h[8];
+    if (!HashTreeFileSha256(fileName, leafSize, threadsCount, h))
+        return false;
+
+    Sha256Digest digest;
+    StateToDigest(h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7], digest.size(), digest.data());
+    std::string res = DigestToHex(digest);
+
+    // Compare ignoring the case of hex digits
+    return res.length() == treeHash.length() && std::equal(res.begin(), res.end(), treeHash.begin(), [](char a, char b) { return a == std::tolower(static_cast<unsigned char>(b)); });
+}
@@ -0,0 +1,70 @@
+// This file is compiled with the instruction set flags for the ARMv8 crypto extensions,
+// so it must contain only the kernels, which are called after the runtime check of the processor support
+#include "Sha2Internal.h"
+
+#ifdef SHA2_ARM_KERNELS
+/**
+    \brief Sha256 hashing steps for a run of blocks using the ARMv8 crypto extensions
+
+    The state is kept in two vector registers in ABCD and EFGH order for the whole run of blocks.
+    Each block is processed with 16 pairs of sha256h and sha256h2 instructions, the message schedule is computed with sha256su0 and sha256su1
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] blocksCount the number of 64 byte blocks in data
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+*/
+void Sha256StepsArm(const char* data, const std::size_t& blocksCount, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7) noexcept
+{
+    // Load state
+    const std::uint32_t state[8] = { h0, h1, h2, h3, h4, h5, h6, h7 };
+    uint32x4_t abcd = vld1q_u32(state);
+    uint32x4_t efgh = vld1q_u32(state + 4);
+
+    for (std::size_t block = 0; block < blocksCount; ++block)
+    {
+        const std::uint8_t* blockData = reinterpret_cast<const std::uint8_t*>(data + (block << 6));
+
+        // Save state to add it after 64 rounds
+        uint32x4_t abcdSave = abcd;
+        uint32x4_t efghSave = efgh;
+
+        // Last 4 quads of message words converted from big endian
+        uint32x4_t words[4];
+        for (int i = 0; i < 4; ++i)
+            words[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blockData + (i << 4))));
+
+        // 16 quads of rounds
+        #pragma GCC unroll 16
+        for (int i = 0; i < 16; ++i)
+        {
+            uint32x4_t temp = vaddq_u32(words[i & 3], vld1q_u32(Sha256K + (i << 2)));
+
+            // Calculate the message words of the quad i + 4 in place of the used ones
+            if (i < 12)
+                words[i & 3] = vsha256su1q_u32(vsha256su0q_u32(words[i & 3], words[(i + 1) & 3]), words[(i + 2) & 3], words[(i + 3) & 3]);
+
+            uint32x4_t abcdPrevious = abcd;
+            abcd = vsha256hq_u32(abcd, efgh, temp);
+            efgh = vsha256h2q_u32(efgh, abcdPrevious, temp);
+        }
+
+        // Add saved state
+        abcd = vaddq_u32(abcd, abcdSave);
+        efgh = vaddq_u32(efgh, efghSave);
+    }
+
+    // Store state back
+    std::uint32_t result[8];
+    vst1q_u32(result, abcd);
+    vst1q_u32(result + 4, efgh);
+    h0 = result[0], h1 = result[1], h2 = result[2], h3 = result[3];
+    h4 = result[4], h5 = result[5], h6 = result[6], h7 = result[7];
+}
+#endif // SHA2_ARM_KERNELS
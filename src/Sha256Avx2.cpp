@@ -0,0 +1,142 @@
+// This file is compiled with the instruction set flags for AVX2,
+// so it must contain only the kernels, which are called after the runtime check of the processor support
+#include "Sha2Internal.h"
+
+#ifdef SHA2_X86_KERNELS
+/**
+    \brief Sha256 compression of 8 independent blocks using AVX2
+
+    \param [in, out] words the message words of the blocks, word i of all lanes in words[i]. Used as the ring buffer of the message schedule
+    \param [in, out] state internal state variables of the 8 messages. The state variable i of the lane j is stored in state[i * 8 + j]
+*/
+static inline void Sha256CompressAvx2x8(__m256i* words, std::uint32_t* state) noexcept
+{
+    // Temporary variables
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 8));
+    __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 16));
+    __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 24));
+    __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 32));
+    __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 40));
+    __m256i g = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 48));
+    __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 56));
+
+    // 64 rounds to calculate hash for data blocks
+    __m256i temp1, temp2, w15, w2;
+    #pragma GCC unroll 64
+    for (int i = 0; i < 64; ++i)
+    {
+        // Calculate next message word from the previous 16
+        if (i >= 16)
+        {
+            w15 = words[(i + 1) & 15];
+            w2 = words[(i + 14) & 15];
+            temp1 = _mm256_xor_si256(_mm256_xor_si256(_mm256_or_si256(_mm256_srli_epi32(w15, 7), _mm256_slli_epi32(w15, 25)), _mm256_or_si256(_mm256_srli_epi32(w15, 18), _mm256_slli_epi32(w15, 14))), _mm256_srli_epi32(w15, 3));
+            temp2 = _mm256_xor_si256(_mm256_xor_si256(_mm256_or_si256(_mm256_srli_epi32(w2, 17), _mm256_slli_epi32(w2, 15)), _mm256_or_si256(_mm256_srli_epi32(w2, 19), _mm256_slli_epi32(w2, 13))), _mm256_srli_epi32(w2, 10));
+            words[i & 15] = _mm256_add_epi32(_mm256_add_epi32(words[i & 15], temp1), _mm256_add_epi32(words[(i + 9) & 15], temp2));
+        }
+
+        temp1 = _mm256_xor_si256(_mm256_xor_si256(_mm256_or_si256(_mm256_srli_epi32(e, 6), _mm256_slli_epi32(e, 26)), _mm256_or_si256(_mm256_srli_epi32(e, 11), _mm256_slli_epi32(e, 21))), _mm256_or_si256(_mm256_srli_epi32(e, 25), _mm256_slli_epi32(e, 7)));
+        temp1 = _mm256_add_epi32(_mm256_add_epi32(h, temp1), _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g)));
+        temp1 = _mm256_add_epi32(temp1, _mm256_add_epi32(_mm256_set1_epi32(Sha256K[i]), words[i & 15]));
+        temp2 = _mm256_xor_si256(_mm256_xor_si256(_mm256_or_si256(_mm256_srli_epi32(a, 2), _mm256_slli_epi32(a, 30)), _mm256_or_si256(_mm256_srli_epi32(a, 13), _mm256_slli_epi32(a, 19))), _mm256_or_si256(_mm256_srli_epi32(a, 22), _mm256_slli_epi32(a, 10)));
+        temp2 = _mm256_add_epi32(temp2, _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b))));
+        h = g; g = f; f = e; e = _mm256_add_epi32(d, temp1); d = c; c = b; b = a; a = _mm256_add_epi32(temp1, temp2);
+    }
+
+    // Add temporary variables to hash
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state), _mm256_add_epi32(a, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state))));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 8), _mm256_add_epi32(b, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 8))));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 16), _mm256_add_epi32(c, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 16))));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 24), _mm256_add_epi32(d, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 24))));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 32), _mm256_add_epi32(e, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 32))));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 40), _mm256_add_epi32(f, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 40))));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 48), _mm256_add_epi32(g, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 48))));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 56), _mm256_add_epi32(h, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 56))));
+}
+
+/**
+    \brief Sha256 hashing step for 8 independent blocks using AVX2
+
+    Each of the 8 lanes of the ymm registers holds the state of a separate message
+
+    \param [in] blocks an array of 8 pointers to the 64 byte blocks to calculate the hash for
+    \param [in, out] state internal state variables of the 8 messages. The state variable i of the lane j is stored in state[i * 8 + j]
+*/
+void Sha256StepAvx2x8(const char* const* blocks, std::uint32_t* state) noexcept
+{
+    // Transposed message words
+    alignas(32) std::uint32_t transposed[16][8];
+    for (int lane = 0; lane < 8; ++lane)
+        for (int i = 0; i < 16; ++i)
+        {
+            memcpy(&transposed[i][lane], blocks[lane] + (i << 2), 4);
+            transposed[i][lane] = __builtin_bswap32(transposed[i][lane]);
+        }
+
+    // Ring buffer with the last 16 message words
+    __m256i words[16];
+    for (int i = 0; i < 16; ++i)
+        words[i] = _mm256_load_si256(reinterpret_cast<const __m256i*>(transposed[i]));
+
+    Sha256CompressAvx2x8(words, state);
+}
+
+/**
+    \brief Second pass of sha256d for 8 independent first pass results using AVX2
+
+    The message of the second pass is the 32 byte result of the first pass with the constant padding, so the message words
+    are the state variables themselves and need no transposing, and the constant padding words are folded into the rounds
+    and the message schedule by the compiler
+
+    \param [in, out] state the first pass states on input, the sha256d states on output. The state variable i of the lane j is stored in state[i * 8 + j]
+*/
+void Sha256dSecondPassAvx2x8(std::uint32_t* state) noexcept
+{
+    // Message words are the first pass result followed by the padding of the 32 byte message
+    __m256i words[16];
+    words[0] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state));
+    words[1] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 8));
+    words[2] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 16));
+    words[3] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 24));
+    words[4] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 32));
+    words[5] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 40));
+    words[6] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 48));
+    words[7] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 56));
+    words[8] = _mm256_set1_epi32(static_cast<int>(0x80000000));
+    for (int i = 9; i < 15; ++i)
+        words[i] = _mm256_setzero_si256();
+    words[15] = _mm256_set1_epi32(256);
+
+    // Hash the block from the begin hash values
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state), _mm256_set1_epi32(static_cast<int>(0x6a09e667)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 8), _mm256_set1_epi32(static_cast<int>(0xbb67ae85)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 16), _mm256_set1_epi32(static_cast<int>(0x3c6ef372)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 24), _mm256_set1_epi32(static_cast<int>(0xa54ff53a)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 32), _mm256_set1_epi32(static_cast<int>(0x510e527f)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 40), _mm256_set1_epi32(static_cast<int>(0x9b05688c)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 48), _mm256_set1_epi32(static_cast<int>(0x1f83d9ab)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 56), _mm256_set1_epi32(static_cast<int>(0x5be0cd19)));
+    Sha256CompressAvx2x8(words, state);
+}
+
+/**
+    \brief Padding block of 64 byte messages for 8 independent states using AVX2
+
+    Parents of the Merkle tree nodes are hashed from 64 byte messages, so the second block is always the same padding.
+    Its message words are constants and the whole message schedule is folded by the compiler
+
+    \param [in, out] state the states after the first block. The state variable i of the lane j is stored in state[i * 8 + j]
+*/
+void Sha256NodePaddingAvx2x8(std::uint32_t* state) noexcept
+{
+    // Message words of the padding of the 64 byte message
+    __m256i words[16];
+    words[0] = _mm256_set1_epi32(static_cast<int>(0x80000000));
+    for (int i = 1; i < 15; ++i)
+        words[i] = _mm256_setzero_si256();
+    words[15] = _mm256_set1_epi32(512);
+
+    Sha256CompressAvx2x8(words, state);
+}
+#endif // SHA2_X86_KERNELS
@@ -0,0 +1,148 @@
+// This file is compiled with the instruction set flags for AVX-512,
+// so it must contain only the kernels, which are called after the runtime check of the processor support
+#include "Sha2Internal.h"
+
+#ifdef SHA2_X86_KERNELS
+// Disable false positive warnings from the avx512 headers of some compilers
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+
+/**
+    \brief Sha256 compression of 16 independent blocks using AVX-512
+
+    \param [in, out] words the message words of the blocks, word i of all lanes in words[i]. Used as the ring buffer of the message schedule
+    \param [in, out] state internal state variables of the 16 messages. The state variable i of the lane j is stored in state[i * 16 + j]
+*/
+static inline void Sha256CompressAvx512x16(__m512i* words, std::uint32_t* state) noexcept
+{
+    // Temporary variables
+    __m512i a = _mm512_loadu_si512(state);
+    __m512i b = _mm512_loadu_si512(state + 16);
+    __m512i c = _mm512_loadu_si512(state + 32);
+    __m512i d = _mm512_loadu_si512(state + 48);
+    __m512i e = _mm512_loadu_si512(state + 64);
+    __m512i f = _mm512_loadu_si512(state + 80);
+    __m512i g = _mm512_loadu_si512(state + 96);
+    __m512i h = _mm512_loadu_si512(state + 112);
+
+    // 64 rounds to calculate hash for data blocks
+    // Ternary logic 0x96 is a ^ b ^ c, 0xca is choose and 0xe8 is majority
+    __m512i temp1, temp2, w15, w2;
+    #pragma GCC unroll 64
+    for (int i = 0; i < 64; ++i)
+    {
+        // Calculate next message word from the previous 16
+        if (i >= 16)
+        {
+            w15 = words[(i + 1) & 15];
+            w2 = words[(i + 14) & 15];
+            temp1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(w15, 7), _mm512_ror_epi32(w15, 18), _mm512_srli_epi32(w15, 3), 0x96);
+            temp2 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(w2, 17), _mm512_ror_epi32(w2, 19), _mm512_srli_epi32(w2, 10), 0x96);
+            words[i & 15] = _mm512_add_epi32(_mm512_add_epi32(words[i & 15], temp1), _mm512_add_epi32(words[(i + 9) & 15], temp2));
+        }
+
+        temp1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(e, 6), _mm512_ror_epi32(e, 11), _mm512_ror_epi32(e, 25), 0x96);
+        temp1 = _mm512_add_epi32(_mm512_add_epi32(h, temp1), _mm512_ternarylogic_epi32(e, f, g, 0xca));
+        temp1 = _mm512_add_epi32(temp1, _mm512_add_epi32(_mm512_set1_epi32(Sha256K[i]), words[i & 15]));
+        temp2 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(a, 2), _mm512_ror_epi32(a, 13), _mm512_ror_epi32(a, 22), 0x96);
+        temp2 = _mm512_add_epi32(temp2, _mm512_ternarylogic_epi32(a, b, c, 0xe8));
+        h = g; g = f; f = e; e = _mm512_add_epi32(d, temp1); d = c; c = b; b = a; a = _mm512_add_epi32(temp1, temp2);
+    }
+
+    // Add temporary variables to hash
+    _mm512_storeu_si512(state, _mm512_add_epi32(a, _mm512_loadu_si512(state)));
+    _mm512_storeu_si512(state + 16, _mm512_add_epi32(b, _mm512_loadu_si512(state + 16)));
+    _mm512_storeu_si512(state + 32, _mm512_add_epi32(c, _mm512_loadu_si512(state + 32)));
+    _mm512_storeu_si512(state + 48, _mm512_add_epi32(d, _mm512_loadu_si512(state + 48)));
+    _mm512_storeu_si512(state + 64, _mm512_add_epi32(e, _mm512_loadu_si512(state + 64)));
+    _mm512_storeu_si512(state + 80, _mm512_add_epi32(f, _mm512_loadu_si512(state + 80)));
+    _mm512_storeu_si512(state + 96, _mm512_add_epi32(g, _mm512_loadu_si512(state + 96)));
+    _mm512_storeu_si512(state + 112, _mm512_add_epi32(h, _mm512_loadu_si512(state + 112)));
+}
+
+/**
+    \brief Sha256 hashing step for 16 independent blocks using AVX-512
+
+    Each of the 16 lanes of the zmm registers holds the state of a separate message
+
+    \param [in] blocks an array of 16 pointers to the 64 byte blocks to calculate the hash for
+    \param [in, out] state internal state variables of the 16 messages. The state variable i of the lane j is stored in state[i * 16 + j]
+*/
+void Sha256StepAvx512x16(const char* const* blocks, std::uint32_t* state) noexcept
+{
+    // Transposed message words
+    alignas(64) std::uint32_t transposed[16][16];
+    for (int lane = 0; lane < 16; ++lane)
+        for (int i = 0; i < 16; ++i)
+        {
+            memcpy(&transposed[i][lane], blocks[lane] + (i << 2), 4);
+            transposed[i][lane] = __builtin_bswap32(transposed[i][lane]);
+        }
+
+    // Ring buffer with the last 16 message words
+    __m512i words[16];
+    for (int i = 0; i < 16; ++i)
+        words[i] = _mm512_load_si512(transposed[i]);
+
+    Sha256CompressAvx512x16(words, state);
+}
+
+/**
+    \brief Second pass of sha256d for 16 independent first pass results using AVX-512
+
+    The message of the second pass is the 32 byte result of the first pass with the constant padding, so the message words
+    are the state variables themselves and need no transposing, and the constant padding words are folded into the rounds
+    and the message schedule by the compiler
+
+    \param [in, out] state the first pass states on input, the sha256d states on output. The state variable i of the lane j is stored in state[i * 16 + j]
+*/
+void Sha256dSecondPassAvx512x16(std::uint32_t* state) noexcept
+{
+    // Message words are the first pass result followed by the padding of the 32 byte message
+    __m512i words[16];
+    words[0] = _mm512_loadu_si512(state);
+    words[1] = _mm512_loadu_si512(state + 16);
+    words[2] = _mm512_loadu_si512(state + 32);
+    words[3] = _mm512_loadu_si512(state + 48);
+    words[4] = _mm512_loadu_si512(state + 64);
+    words[5] = _mm512_loadu_si512(state + 80);
+    words[6] = _mm512_loadu_si512(state + 96);
+    words[7] = _mm512_loadu_si512(state + 112);
+    words[8] = _mm512_set1_epi32(static_cast<int>(0x80000000));
+    for (int i = 9; i < 15; ++i)
+        words[i] = _mm512_setzero_si512();
+    words[15] = _mm512_set1_epi32(256);
+
+    // Hash the block from the begin hash values
+    _mm512_storeu_si512(state, _mm512_set1_epi32(static_cast<int>(0x6a09e667)));
+    _mm512_storeu_si512(state + 16, _mm512_set1_epi32(static_cast<int>(0xbb67ae85)));
+    _mm512_storeu_si512(state + 32, _mm512_set1_epi32(static_cast<int>(0x3c6ef372)));
+    _mm512_storeu_si512(state + 48, _mm512_set1_epi32(static_cast<int>(0xa54ff53a)));
+    _mm512_storeu_si512(state + 64, _mm512_set1_epi32(static_cast<int>(0x510e527f)));
+    _mm512_storeu_si512(state + 80, _mm512_set1_epi32(static_cast<int>(0x9b05688c)));
+    _mm512_storeu_si512(state + 96, _mm512_set1_epi32(static_cast<int>(0x1f83d9ab)));
+    _mm512_storeu_si512(state + 112, _mm512_set1_epi32(static_cast<int>(0x5be0cd19)));
+    Sha256CompressAvx512x16(words, state);
+}
+
+/**
+    \brief Padding block of 64 byte messages for 16 independent states using AVX-512
+
+    Parents of the Merkle tree nodes are hashed from 64 byte messages, so the second block is always the same padding.
+    Its message words are constants and the whole message schedule is folded by the compiler
+
+    \param [in, out] state the states after the first block. The state variable i of the lane j is stored in state[i * 16 + j]
+*/
+void Sha256NodePaddingAvx512x16(std::uint32_t* state) noexcept
+{
+    // Message words of the padding of the 64 byte message
+    __m512i words[16];
+    words[0] = _mm512_set1_epi32(static_cast<int>(0x80000000));
+    for (int i = 1; i < 15; ++i)
+        words[i] = _mm512_setzero_si512();
+    words[15] = _mm512_set1_epi32(512);
+
+    Sha256CompressAvx512x16(words, state);
+}
+#pragma GCC diagnostic pop
+#endif // SHA2_X86_KERNELS
@@ -0,0 +1,74 @@
+// This file is compiled with the instruction set flags for the SHA extensions, SSSE3 and SSE4.1,
+// so it must contain only the kernels, which are called after the runtime check of the processor support
+#include "Sha2Internal.h"
+
+#ifdef SHA2_X86_KERNELS
+/**
+    \brief Sha256 hashing steps for a run of blocks using the Intel SHA extensions
+
+    The state is kept in two xmm registers in ABEF and CDGH order for the whole run of blocks.
+    Each block is processed with 32 sha256rnds2 instructions, the message schedule is computed with sha256msg1 and sha256msg2
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] blocksCount the number of 64 byte blocks in data
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+*/
+void Sha256StepsShaNi(const char* data, const std::size_t& blocksCount, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7) noexcept
+{
+    // Mask to convert big endian words to little endian
+    const __m128i byteSwapMask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // Load state and reorder it to ABEF and CDGH
+    __m128i abef = _mm_set_epi32(h0, h1, h4, h5);
+    __m128i cdgh = _mm_set_epi32(h2, h3, h6, h7);
+    __m128i temp;
+
+    for (std::size_t block = 0; block < blocksCount; ++block)
+    {
+        const __m128i* blockData = reinterpret_cast<const __m128i*>(data + (block << 6));
+
+        // Save state to add it after 64 rounds
+        __m128i abefSave = abef;
+        __m128i cdghSave = cdgh;
+
+        // Last 4 quads of message words
+        __m128i words[4];
+        for (int i = 0; i < 4; ++i)
+            words[i] = _mm_shuffle_epi8(_mm_loadu_si128(blockData + i), byteSwapMask);
+
+        // 16 quads of rounds
+        #pragma GCC unroll 16
+        for (int i = 0; i < 16; ++i)
+        {
+            // Calculate next 4 message words from the previous 16
+            if (i >= 4)
+            {
+                temp = _mm_add_epi32(_mm_sha256msg1_epu32(words[i & 3], words[(i + 1) & 3]), _mm_alignr_epi8(words[(i + 3) & 3], words[(i + 2) & 3], 4));
+                words[i & 3] = _mm_sha256msg2_epu32(temp, words[(i + 3) & 3]);
+            }
+
+            temp = _mm_add_epi32(words[i & 3], _mm_loadu_si128(reinterpret_cast<const __m128i*>(Sha256K + (i << 2))));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, temp);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(temp, 0x0e));
+        }
+
+        // Add saved state
+        abef = _mm_add_epi32(abef, abefSave);
+        cdgh = _mm_add_epi32(cdgh, cdghSave);
+    }
+
+    // Store state back
+    alignas(16) std::uint32_t state[8];
+    _mm_store_si128(reinterpret_cast<__m128i*>(state), abef);
+    _mm_store_si128(reinterpret_cast<__m128i*>(state + 4), cdgh);
+    h0 = state[3], h1 = state[2], h4 = state[1], h5 = state[0];
+    h2 = state[7], h3 = state[6], h6 = state[5], h7 = state[4];
+}
+#endif // SHA2_X86_KERNELS
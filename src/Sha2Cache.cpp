@@ -0,0 +1,373 @@
+#include "Sha2Internal.h"
+#include "Sha2Cache.h"
+
+#include <fstream>
+#include <atomic>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+
+// Header of the index file. The records follow the header
+struct DigestCacheHeader
+{
+    char magic[8];
+
+    // Byte order mark and the record size, index files are valid only on machines with the same layout
+    std::uint32_t byteOrder;
+    std::uint32_t recordSize;
+
+    std::uint64_t recordsCount;
+    std::uint8_t reserved[40];
+};
+
+static_assert(sizeof(DigestCacheHeader) == 64, "The records must be aligned in the mapped index file");
+
+// Magic bytes of the index file
+static const char DigestCacheMagic[8] = { 'S', 'H', 'A', '2', 'D', 'C', 'I', '1' };
+
+// Offsets and lengths of the hash sums in the records by the algorithm indices
+static const std::size_t DigestOffsets[6] = { 0, 32, 60, 124, 172, 200 };
+static const std::size_t DigestLens[6] = { 32, 28, 64, 48, 28, 32 };
+
+// Files modified less than this number of nanoseconds before hashing are not cached
+static const std::int64_t RacyInterval = 2000000000;
+
+// Installed cache of the file hashing functions
+static std::atomic<DigestCache*> installedCache(nullptr);
+
+DigestCache::~DigestCache()
+{
+    Unmap();
+}
+
+void DigestCache::Unmap() noexcept
+{
+#ifdef SHA2_POSIX_FILES
+    if (mapping != nullptr)
+        munmap(mapping, mappingLen);
+#endif // SHA2_POSIX_FILES
+
+    mapping = nullptr;
+    mappingLen = 0;
+    mappedRecords = nullptr;
+    mappedRecordsCount = 0;
+    isMappedRecordUsed.clear();
+}
+
+FileIdentity DigestCache::Identify(const std::string& fileName) noexcept
+{
+    FileIdentity res;
+
+#ifdef SHA2_POSIX_FILES
+    struct stat fileStat;
+    if (stat(fileName.c_str(), &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+        return res;
+
+    res.device = static_cast<std::uint64_t>(fileStat.st_dev);
+    res.inode = static_cast<std::uint64_t>(fileStat.st_ino);
+    res.size = static_cast<std::uint64_t>(fileStat.st_size);
+#ifdef __APPLE__
+    res.modificationTime = static_cast<std::int64_t>(fileStat.st_mtimespec.tv_sec) * 1000000000 + fileStat.st_mtimespec.tv_nsec;
+    res.changeTime = static_cast<std::int64_t>(fileStat.st_ctimespec.tv_sec) * 1000000000 + fileStat.st_ctimespec.tv_nsec;
+#else
+    res.modificationTime = static_cast<std::int64_t>(fileStat.st_mtim.tv_sec) * 1000000000 + fileStat.st_mtim.tv_nsec;
+    res.changeTime = static_cast<std::int64_t>(fileStat.st_ctim.tv_sec) * 1000000000 + fileStat.st_ctim.tv_nsec;
+#endif // __APPLE__
+    res.isValid = true;
+#else
+    (void)fileName;
+#endif // SHA2_POSIX_FILES
+
+    return res;
+}
+
+bool DigestCache::Load(const std::string& indexFileName) noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Unmap();
+    storedRecords.clear();
+
+#ifdef SHA2_POSIX_FILES
+    int fileDescriptor = open(indexFileName.c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+        return false;
+
+    struct stat fileStat;
+    if (fstat(fileDescriptor, &fileStat) != 0 || static_cast<std::uint64_t>(fileStat.st_size) < sizeof(DigestCacheHeader) ||
+        static_cast<std::uint64_t>(fileStat.st_size) > SIZE_MAX)
+    {
+        close(fileDescriptor);
+        return false;
+    }
+
+    std::size_t fileSize = fileStat.st_size;
+    void* mapped = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    close(fileDescriptor);
+    if (mapped == MAP_FAILED)
+        return false;
+
+    // Check the header
+    const DigestCacheHeader* header = static_cast<const DigestCacheHeader*>(mapped);
+    const Record* records = reinterpret_cast<const Record*>(static_cast<const char*>(mapped) + sizeof(DigestCacheHeader));
+    bool isValid = memcmp(header->magic, DigestCacheMagic, sizeof(DigestCacheMagic)) == 0 && header->byteOrder == 0x01020304 &&
+        header->recordSize == sizeof(Record) && header->recordsCount == (fileSize - sizeof(DigestCacheHeader)) / sizeof(Record) &&
+        (fileSize - sizeof(DigestCacheHeader)) % sizeof(Record) == 0;
+
+    // Check the order of the records, the lookups use binary search
+    for (std::size_t i = 1; isValid && i < header->recordsCount; ++i)
+        isValid = records[i - 1].device < records[i].device || (records[i - 1].device == records[i].device && records[i - 1].inode < records[i].inode);
+
+    if (!isValid)
+    {
+        munmap(mapped, fileSize);
+        return false;
+    }
+
+    madvise(mapped, fileSize, MADV_RANDOM);
+
+    mapping = mapped;
+    mappingLen = fileSize;
+    mappedRecords = records;
+    mappedRecordsCount = header->recordsCount;
+    isMappedRecordUsed.assign(mappedRecordsCount, false);
+    return true;
+#else
+    (void)indexFileName;
+    return false;
+#endif // SHA2_POSIX_FILES
+}
+
+bool DigestCache::Save(const std::string& indexFileName, const bool& isUnusedDropped) noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Merge the mapped and the stored records in the order of device and inode
+    std::vector<const Record*> records;
+    records.reserve(mappedRecordsCount + storedRecords.size());
+
+    std::size_t i = 0;
+    auto stored = storedRecords.begin();
+    while (i < mappedRecordsCount || stored != storedRecords.end())
+    {
+        const Record* mapped = i < mappedRecordsCount ? mappedRecords + i : nullptr;
+        if (mapped != nullptr && (stored == storedRecords.end() || std::make_pair(mapped->device, mapped->inode) < stored->first))
+        {
+            if (!isUnusedDropped || isMappedRecordUsed[i])
+                records.push_back(mapped);
+            ++i;
+            continue;
+        }
+
+        // The stored record replaces the mapped record of the same file
+        if (mapped != nullptr && std::make_pair(mapped->device, mapped->inode) == stored->first)
+            ++i;
+        records.push_back(&stored->second);
+        ++stored;
+    }
+
+    DigestCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, DigestCacheMagic, sizeof(DigestCacheMagic));
+    header.byteOrder = 0x01020304;
+    header.recordSize = sizeof(Record);
+    header.recordsCount = records.size();
+
+#ifdef SHA2_POSIX_FILES
+    // Write the temporary file with a unique name, so concurrent savers of the same index do not write the same file
+    std::string temporaryFileName = indexFileName + ".XXXXXX";
+    int fileDescriptor = mkstemp(&temporaryFileName[0]);
+    if (fileDescriptor < 0)
+        return false;
+
+    // The temporary file is created for the owner only, the replaced index keeps its permissions
+    struct stat indexStat;
+    if (stat(indexFileName.c_str(), &indexStat) == 0)
+        fchmod(fileDescriptor, indexStat.st_mode & 0777);
+
+    std::vector<char> buffer(reinterpret_cast<const char*>(&header), reinterpret_cast<const char*>(&header) + sizeof(header));
+    bool isWritten = true;
+    for (const Record* record : records)
+    {
+        buffer.insert(buffer.end(), reinterpret_cast<const char*>(record), reinterpret_cast<const char*>(record + 1));
+        if (buffer.size() >= CHUNK_SIZE)
+        {
+            isWritten = isWritten && WriteAll(fileDescriptor, buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+
+    // The content must be on the disk before the rename makes it the index
+    isWritten = isWritten && WriteAll(fileDescriptor, buffer.data(), buffer.size()) && fsync(fileDescriptor) == 0;
+    isWritten = close(fileDescriptor) == 0 && isWritten;
+    if (!isWritten || std::rename(temporaryFileName.c_str(), indexFileName.c_str()) != 0)
+    {
+        std::remove(temporaryFileName.c_str());
+        return false;
+    }
+
+    // Replace the index file durably. The mapping of the old file stays valid
+    return SyncParentDirectory(indexFileName);
+#else
+    // Write the temporary file with a unique name, the streams can not flush it to the disk
+    static std::atomic<std::uint64_t> savesCount(0);
+    std::string temporaryFileName = indexFileName + "." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "." +
+        std::to_string(savesCount.fetch_add(1)) + ".tmp";
+    std::ofstream file(temporaryFileName, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const Record* record : records)
+        file.write(reinterpret_cast<const char*>(record), sizeof(Record));
+
+    file.close();
+    if (!file)
+    {
+        std::remove(temporaryFileName.c_str());
+        return false;
+    }
+
+    // Replace the index file
+    return std::rename(temporaryFileName.c_str(), indexFileName.c_str()) == 0;
+#endif // SHA2_POSIX_FILES
+}
+
+std::size_t DigestCache::FindMapped(const std::uint64_t& device, const std::uint64_t& inode) const noexcept
+{
+    // Binary search in the mapped records
+    std::size_t begin = 0, end = mappedRecordsCount;
+    while (begin < end)
+    {
+        std::size_t middle = begin + (end - begin) / 2;
+        const Record& record = mappedRecords[middle];
+        if (record.device < device || (record.device == device && record.inode < inode))
+            begin = middle + 1;
+        else
+            end = middle;
+    }
+
+    if (begin < mappedRecordsCount && mappedRecords[begin].device == device && mappedRecords[begin].inode == inode)
+        return begin;
+
+    return mappedRecordsCount;
+}
+
+const DigestCache::Record* DigestCache::Find(const std::uint64_t& device, const std::uint64_t& inode, std::size_t& mappedIndex) const noexcept
+{
+    mappedIndex = mappedRecordsCount;
+
+    auto stored = storedRecords.find(std::make_pair(device, inode));
+    if (stored != storedRecords.end())
+        return &stored->second;
+
+    mappedIndex = FindMapped(device, inode);
+    return mappedIndex < mappedRecordsCount ? mappedRecords + mappedIndex : nullptr;
+}
+
+bool DigestCache::Lookup(const std::string& fileName, const Sha2Algorithm& algorithm, std::uint8_t* digest, FileIdentity& identity) noexcept
+{
+    identity = Identify(fileName);
+    if (!identity.isValid)
+        return false;
+
+    int index = static_cast<int>(algorithm);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::size_t mappedIndex;
+    const Record* record = Find(identity.device, identity.inode, mappedIndex);
+    if (record == nullptr || record->size != identity.size || record->modificationTime != identity.modificationTime ||
+        record->changeTime != identity.changeTime || (record->algorithms & (1u << index)) == 0)
+    {
+        ++missesCount;
+        return false;
+    }
+
+    memcpy(digest, record->digests + DigestOffsets[index], DigestLens[index]);
+    if (mappedIndex < mappedRecordsCount)
+        isMappedRecordUsed[mappedIndex] = true;
+    ++hitsCount;
+    return true;
+}
+
+void DigestCache::Store(const std::string& fileName, const FileIdentity& identity, const Sha2Algorithm& algorithm, const std::uint8_t* digest) noexcept
+{
+    // Check that the file was not changed while it was hashed
+    if (!(Identify(fileName) == identity))
+        return;
+
+    // Skip recently modified files, their later modifications may keep the same times
+    std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    if (now - identity.modificationTime < RacyInterval)
+        return;
+
+    int index = static_cast<int>(algorithm);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Keep the other hash sums of the same file version
+    Record record;
+    std::size_t mappedIndex;
+    const Record* found = Find(identity.device, identity.inode, mappedIndex);
+    if (found != nullptr && found->size == identity.size && found->modificationTime == identity.modificationTime && found->changeTime == identity.changeTime)
+        record = *found;
+    else
+    {
+        memset(&record, 0, sizeof(record));
+        record.device = identity.device;
+        record.inode = identity.inode;
+        record.size = identity.size;
+        record.modificationTime = identity.modificationTime;
+        record.changeTime = identity.changeTime;
+    }
+
+    record.algorithms |= 1u << index;
+    memcpy(record.digests + DigestOffsets[index], digest, DigestLens[index]);
+    storedRecords[std::make_pair(identity.device, identity.inode)] = record;
+}
+
+void DigestCache::Clear() noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Unmap();
+    storedRecords.clear();
+}
+
+std::size_t DigestCache::Size() const noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Count the mapped records which are not replaced by the stored ones
+    std::size_t res = mappedRecordsCount + storedRecords.size();
+    for (const auto& stored : storedRecords)
+        if (FindMapped(stored.first.first, stored.first.second) < mappedRecordsCount)
+            --res;
+
+    return res;
+}
+
+std::uint64_t DigestCache::HitsCount() const noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return hitsCount;
+}
+
+std::uint64_t DigestCache::MissesCount() const noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return missesCount;
+}
+
+void SetDigestCache(DigestCache* cache) noexcept
+{
+    installedCache.store(cache, std::memory_order_release);
+}
+
+DigestCache* GetDigestCache() noexcept
+{
+    return installedCache.load(std::memory_order_acquire);
+}
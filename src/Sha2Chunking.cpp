@@ -0,0 +1,324 @@
+#include "Sha2Chunking.h"
+
+#include <fstream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+// Table of random values of the gear rolling hash
+struct GearTable
+{
+    std::uint64_t values[256];
+};
+
+/**
+    \brief Function for generating the gear table with the splitmix64 generator
+
+    \return the gear table
+*/
+static constexpr GearTable GenerateGearTable() noexcept
+{
+    GearTable res{};
+    std::uint64_t state = 0x5348413243444331;
+
+    for (int i = 0; i < 256; ++i)
+    {
+        state += 0x9e3779b97f4a7c15;
+        std::uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        res.values[i] = z ^ (z >> 31);
+    }
+
+    return res;
+}
+
+static constexpr GearTable Gear = GenerateGearTable();
+
+// Number of stream segments in flight between the chunking and the hashing threads
+static constexpr std::size_t SegmentsCount = 4;
+
+// Begin hash values of sha256 and sha512/256
+static const std::uint32_t Sha256BeginHash[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+static const std::uint64_t Sha512_256BeginHash[8] = { 0x22312194fc2bf72c, 0x9f555fa3c84c64c2, 0x2393b86b6f53b151, 0x963877195940eabd, 0x96283ee2a88effe3, 0xbe5e1e2553863992, 0x2b0199fc2c85b8aa, 0x0eb72ddc81c52ca2 };
+
+/**
+    \brief Function for making the chunk sizes consistent
+
+    \param [in, out] minSize minimum chunk size, at least 1 and at most the maximum size
+    \param [in, out] averageSize average chunk size, between the minimum and the maximum size
+    \param [in, out] maxSize maximum chunk size, at least 1
+*/
+static void NormalizeChunkSizes(std::size_t& minSize, std::size_t& averageSize, std::size_t& maxSize) noexcept
+{
+    maxSize = std::max(maxSize, static_cast<std::size_t>(1));
+    minSize = std::min(std::max(minSize, static_cast<std::size_t>(1)), maxSize);
+    averageSize = std::min(std::max(averageSize, minSize), maxSize);
+}
+
+std::size_t FindChunkBoundary(const char* data, const std::size_t& dataLen, const std::size_t& minSize, const std::size_t& averageSize, const std::size_t& maxSize) noexcept
+{
+    if (dataLen <= minSize)
+        return dataLen;
+
+    // The stricter mask has two bits more than the average size needs, the looser one two bits less
+    int bits = 0;
+    while (bits < 62 && (static_cast<std::size_t>(2) << bits) <= averageSize)
+        ++bits;
+    bits = std::max(bits, 3);
+    const std::uint64_t strictMask = ~static_cast<std::uint64_t>(0) << (64 - (bits + 2));
+    const std::uint64_t looseMask = ~static_cast<std::uint64_t>(0) << (64 - (bits - 2));
+
+    const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(data);
+    std::size_t end = std::min(dataLen, maxSize);
+    std::size_t normalEnd = std::min(end, averageSize);
+    std::uint64_t fingerprint = 0;
+    std::size_t i = minSize;
+
+    // Skip the minimum size and find the cut point with the stricter mask before the average size
+    for (; i < normalEnd; ++i)
+    {
+        fingerprint = (fingerprint << 1) + Gear.values[bytes[i]];
+        if ((fingerprint & strictMask) == 0)
+            return i + 1;
+    }
+
+    // Find the cut point with the looser mask after the average size
+    for (; i < end; ++i)
+    {
+        fingerprint = (fingerprint << 1) + Gear.values[bytes[i]];
+        if ((fingerprint & looseMask) == 0)
+            return i + 1;
+    }
+
+    return end;
+}
+
+// Part of the stream with whole chunks, passed from the chunking thread to the hashing threads
+struct ChunkingSegment
+{
+    // Read data. Only the first dataLen bytes belong to the segment, the rest is the beginning of the next segment
+    std::vector<char> data;
+    std::size_t dataLen = 0;
+
+    // Position of the segment in the stream
+    std::uint64_t offset = 0;
+
+    // End positions of the chunks in the segment
+    std::vector<std::size_t> chunkEnds;
+};
+
+bool ChunkStreamSha256(std::istream& stream, const ContentChunkHandler& handler, Sha256Digest& digest, const bool& isSha512_256Calculated, const std::size_t& minSize, const std::size_t& averageSize, const std::size_t& maxSize) noexcept
+{
+    std::size_t minLen = minSize, averageLen = averageSize, maxLen = maxSize;
+    NormalizeChunkSizes(minLen, averageLen, maxLen);
+
+    // Segments are long enough to hold many chunks and the incomplete chunk from the previous segment.
+    // A maximum size which overflows the segment size makes the allocation fail instead of wrapping around to a short segment
+    std::size_t segmentSize = std::max(static_cast<std::size_t>(CHUNK_SIZE) * 16, maxLen > SIZE_MAX / 4 ? SIZE_MAX : maxLen * 4);
+    std::vector<ChunkingSegment> segments(SegmentsCount);
+
+    // Counters of the segments passed through every stage
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::uint64_t producedCount = 0, streamHashedCount = 0, chunksHashedCount = 0;
+    bool isFinished = false;
+
+    // Set if a stage failed with an exception, for example thrown by the handler. All stages stop then
+    bool isAborted = false;
+
+    // Wait for a segment to be produced, returns false after the last segment
+    auto waitSegment = [&](const std::uint64_t& index)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&]() { return index < producedCount || isFinished || isAborted; });
+        return index < producedCount && !isAborted;
+    };
+
+    auto markHashed = [&](std::uint64_t& counter, const std::uint64_t& index)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            counter = index + 1;
+        }
+        changed.notify_all();
+    };
+
+    auto abortChunking = [&]()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isAborted = true;
+        }
+        changed.notify_all();
+    };
+
+    // Hash the whole stream
+    Sha256Context context;
+    auto hashStream = [&]()
+    {
+        try
+        {
+            for (std::uint64_t i = 0; waitSegment(i); ++i)
+            {
+                const ChunkingSegment& segment = segments[i % SegmentsCount];
+                context.Update(segment.data.data(), segment.dataLen);
+                markHashed(streamHashedCount, i);
+            }
+        }
+        catch (...)
+        {
+            abortChunking();
+        }
+    };
+
+    // Hash the chunks in batches
+    auto hashChunks = [&]()
+    {
+        try
+        {
+            std::vector<const char*> data;
+            std::vector<std::size_t> dataLens;
+            std::vector<std::uint32_t> hashes;
+            std::vector<std::uint64_t> hashes512;
+            ContentChunk chunk;
+            memset(chunk.sha512_256.data(), 0, chunk.sha512_256.size());
+
+            for (std::uint64_t i = 0; waitSegment(i); ++i)
+            {
+                const ChunkingSegment& segment = segments[i % SegmentsCount];
+                std::size_t count = segment.chunkEnds.size();
+
+                data.resize(count);
+                dataLens.resize(count);
+                for (std::size_t j = 0; j < count; ++j)
+                {
+                    std::size_t begin = j == 0 ? 0 : segment.chunkEnds[j - 1];
+                    data[j] = segment.data.data() + begin;
+                    dataLens[j] = segment.chunkEnds[j] - begin;
+                }
+
+                hashes.resize(count * 8);
+                HashSha256Batch(data.data(), dataLens.data(), count, Sha256BeginHash, hashes.data());
+                if (isSha512_256Calculated)
+                {
+                    hashes512.resize(count * 8);
+                    HashSha512Batch(data.data(), dataLens.data(), count, Sha512_256BeginHash, hashes512.data());
+                }
+
+                // Pass the chunks to the handler
+                for (std::size_t j = 0; j < count; ++j)
+                {
+                    const std::uint32_t* h = hashes.data() + j * 8;
+                    chunk.offset = segment.offset + (data[j] - segment.data.data());
+                    chunk.length = dataLens[j];
+                    StateToDigest(h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7], chunk.sha256.size(), chunk.sha256.data());
+
+                    if (isSha512_256Calculated)
+                    {
+                        const std::uint64_t* h512 = hashes512.data() + j * 8;
+                        StateToDigest(h512[0], h512[1], h512[2], h512[3], h512[4], h512[5], h512[6], h512[7], chunk.sha512_256.size(), chunk.sha512_256.data());
+                    }
+
+                    handler(chunk);
+                }
+
+                markHashed(chunksHashedCount, i);
+            }
+        }
+        catch (...)
+        {
+            abortChunking();
+        }
+    };
+
+    std::thread streamHasher, chunksHasher;
+    bool isFailed = false;
+    try
+    {
+        streamHasher = std::thread(hashStream);
+        chunksHasher = std::thread(hashChunks);
+
+        // Read the stream and find the chunk boundaries
+        std::size_t tailLen = 0;
+        std::uint64_t offset = 0;
+        bool isEnd = false;
+        for (std::uint64_t i = 0; !isEnd; ++i)
+        {
+            // Wait until both hashing threads released the segment
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&]() { return isAborted || i < std::min(streamHashedCount, chunksHashedCount) + SegmentsCount; });
+                if (isAborted)
+                    break;
+            }
+
+            ChunkingSegment& segment = segments[i % SegmentsCount];
+            segment.data.resize(segmentSize);
+
+            // Move the incomplete chunk of the previous segment to the beginning
+            if (tailLen > 0)
+            {
+                const ChunkingSegment& previous = segments[(i + SegmentsCount - 1) % SegmentsCount];
+                memcpy(segment.data.data(), previous.data.data() + previous.dataLen, tailLen);
+            }
+
+            stream.read(segment.data.data() + tailLen, segmentSize - tailLen);
+            std::size_t available = tailLen + static_cast<std::size_t>(stream.gcount());
+            isEnd = !stream;
+            isFailed = stream.bad();
+
+            // Cut the chunks. Before the end of the stream the chunks are cut only if the maximum chunk size is available
+            std::size_t position = 0;
+            segment.chunkEnds.clear();
+            while (position < available && (isEnd || available - position >= maxLen))
+            {
+                position += FindChunkBoundary(segment.data.data() + position, available - position, minLen, averageLen, maxLen);
+                segment.chunkEnds.push_back(position);
+            }
+
+            segment.dataLen = position;
+            segment.offset = offset;
+            offset += position;
+            tailLen = available - position;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++producedCount;
+            }
+            changed.notify_all();
+        }
+    }
+    catch (...)
+    {
+        // The thread creation, the allocation of a segment or the stream failed
+        abortChunking();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isFinished = true;
+    }
+    changed.notify_all();
+
+    if (streamHasher.joinable())
+        streamHasher.join();
+    if (chunksHasher.joinable())
+        chunksHasher.join();
+
+    context.Final(digest.data());
+    return !isFailed && !isAborted;
+}
+
+bool ChunkFileSha256(const std::string& fileName, const ContentChunkHandler& handler, Sha256Digest& digest, const bool& isSha512_256Calculated, const std::size_t& minSize, const std::size_t& averageSize, const std::size_t& maxSize) noexcept
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    return ChunkStreamSha256(file, handler, digest, isSha512_256Calculated, minSize, averageSize, maxSize);
+}
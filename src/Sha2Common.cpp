@@ -0,0 +1,894 @@
+#include "Sha2Internal.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <filesystem>
+#include <cstdlib>
+#include <cstdio>
+#include <chrono>
+
+void BytesToHex(const std::uint8_t* data, const std::size_t& len, char* destination) noexcept
+{
+    std::size_t i = 0;
+
+#if defined(SHA2_X86_KERNELS) && defined(__SSE2__)
+    const __m128i lowMask = _mm_set1_epi8(0x0f);
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i letterOffset = _mm_set1_epi8('a' - '0' - 10);
+
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), lowMask);
+        __m128i low = _mm_and_si128(bytes, lowMask);
+
+        // Add '0' to all digits and the offset of 'a' to digits greater than 9
+        high = _mm_add_epi8(_mm_add_epi8(high, zero), _mm_and_si128(_mm_cmpgt_epi8(high, nine), letterOffset));
+        low = _mm_add_epi8(_mm_add_epi8(low, zero), _mm_and_si128(_mm_cmpgt_epi8(low, nine), letterOffset));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + (i << 1)), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + (i << 1) + 16), _mm_unpackhi_epi8(high, low));
+    }
+#endif // SHA2_X86_KERNELS && __SSE2__
+
+    const char digits[] = "0123456789abcdef";
+    for (; i < len; ++i)
+    {
+        destination[i << 1] = digits[data[i] >> 4];
+        destination[(i << 1) + 1] = digits[data[i] & 0b00001111];
+    }
+}
+
+#ifdef SHA2_X86_KERNELS
+/// \brief Check if the processor supports the Intel SHA extensions
+/// \return true if the sha256rnds2, sha256msg1 and sha256msg2 instructions can be used
+bool IsShaNiSupported() noexcept
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    // SSSE3 and SSE4.1 are required for byte shuffles and blends
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_SSSE3) || !(ecx & bit_SSE4_1))
+        return false;
+
+    // SHA extensions flag is the 29 bit of ebx in the 7 leaf
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return false;
+
+    return (ebx & (1u << 29)) != 0;
+}
+
+/// \brief Check if the operating system saves the given extended register states on context switches
+/// \param [in] mask the required bits of the XCR0 register
+/// \return true if all the bits from mask are set in XCR0
+bool IsXcr0Enabled(const std::uint32_t& mask) noexcept
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    // OSXSAVE flag is the 27 bit of ecx in the 1 leaf
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_OSXSAVE))
+        return false;
+
+    __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (eax & mask) == mask;
+}
+
+/// \brief Check if the processor and the operating system support AVX2
+/// \return true if 256 bit integer vector instructions can be used
+bool IsAvx2Supported() noexcept
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) || !(ebx & bit_AVX2))
+        return false;
+
+    // xmm and ymm registers states
+    return IsXcr0Enabled(0b00000110);
+}
+
+/// \brief Check if the processor and the operating system support AVX-512 foundation instructions
+/// \return true if 512 bit integer vector instructions can be used
+bool IsAvx512Supported() noexcept
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) || !(ebx & bit_AVX512F))
+        return false;
+
+    // xmm, ymm, opmask and zmm registers states
+    return IsXcr0Enabled(0b11100110);
+}
+#endif // SHA2_X86_KERNELS
+
+#ifdef SHA2_ARM_KERNELS
+/// \brief Check if the processor supports the sha256 instructions of the ARMv8 crypto extensions
+/// \return true if the sha256h, sha256h2, sha256su0 and sha256su1 instructions can be used
+bool IsArmSha256Supported() noexcept
+{
+    // SHA2 flag is the 6 bit of the hardware capabilities
+    return (getauxval(AT_HWCAP) & (1ul << 6)) != 0;
+}
+
+/// \brief Check if the processor supports the sha512 instructions of the ARMv8.2 crypto extensions
+/// \return true if the sha512h, sha512h2, sha512su0 and sha512su1 instructions can be used
+bool IsArmSha512Supported() noexcept
+{
+    // SHA512 flag is the 21 bit of the hardware capabilities
+    return (getauxval(AT_HWCAP) & (1ul << 21)) != 0;
+}
+#endif // SHA2_ARM_KERNELS
+
+#ifdef SHA2_POSIX_FILES
+// Jump buffer of the guarded read of the current thread, nullptr outside of the guarded reads
+static thread_local sigjmp_buf* MappedReadJump = nullptr;
+
+// Handler of SIGBUS installed before the first guarded read
+static struct sigaction PreviousBusAction;
+
+/**
+    \brief Handler of SIGBUS raised by reading the pages of a truncated mapped file
+
+    Faults outside of the guarded reads are passed to the previous handler. If it is the default action,
+    it is restored and the faulting instruction is repeated with it
+
+    \param [in] signal number of the signal
+    \param [in] info information about the fault
+    \param [in] context context of the interrupted thread
+*/
+static void HandleBusError(int signal, siginfo_t* info, void* context)
+{
+    if (MappedReadJump != nullptr)
+        siglongjmp(*MappedReadJump, 1);
+
+    if (PreviousBusAction.sa_flags & SA_SIGINFO)
+        PreviousBusAction.sa_sigaction(signal, info, context);
+    else if (PreviousBusAction.sa_handler != SIG_DFL && PreviousBusAction.sa_handler != SIG_IGN)
+        PreviousBusAction.sa_handler(signal);
+    else
+        sigaction(SIGBUS, &PreviousBusAction, nullptr);
+}
+
+bool RunGuardedMappedRead(void (*read)(void*), void* argument) noexcept
+{
+    static std::once_flag isInstalled;
+    std::call_once(isInstalled, []()
+    {
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = HandleBusError;
+        action.sa_flags = SA_SIGINFO;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGBUS, &action, &PreviousBusAction);
+    });
+
+    // Keep the jump buffer of an outer guarded read
+    sigjmp_buf jump;
+    sigjmp_buf* previousJump = MappedReadJump;
+    if (sigsetjmp(jump, 1) != 0)
+    {
+        MappedReadJump = previousJump;
+        return false;
+    }
+
+    MappedReadJump = &jump;
+    read(argument);
+    MappedReadJump = previousJump;
+    return true;
+}
+
+/**
+    \brief Function for writing the whole array to a file, the interrupted and partial writes are continued
+
+    \param [in] fileDescriptor descriptor of the file
+    \param [in] data a pointer to the array to write
+    \param [in] len data array length
+
+    \return true if the whole array was written
+*/
+bool WriteAll(const int& fileDescriptor, const char* data, std::size_t len) noexcept
+{
+    while (len > 0)
+    {
+        ssize_t written = write(fileDescriptor, data, len);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return false;
+
+        data += written;
+        len -= static_cast<std::size_t>(written);
+    }
+
+    return true;
+}
+
+/**
+    \brief Function for flushing the directory of a file to the disk, so a renamed file survives a crash
+
+    \param [in] fileName name of the file
+
+    \return true if the directory was flushed
+*/
+bool SyncParentDirectory(const std::string& fileName) noexcept
+{
+    std::size_t slash = fileName.rfind('/');
+    std::string directoryName = slash == std::string::npos ? "." : slash == 0 ? "/" : fileName.substr(0, slash);
+
+    int fileDescriptor = open(directoryName.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fileDescriptor < 0)
+        return false;
+
+    bool isSynced = fsync(fileDescriptor) == 0;
+    close(fileDescriptor);
+    return isSynced;
+}
+#endif // SHA2_POSIX_FILES
+
+bool ReplaceFileContent(const std::string& fileName, const std::string& content) noexcept
+{
+#ifdef SHA2_POSIX_FILES
+    // Write the temporary file with a unique name, so concurrent writers of the same file do not write the same temporary file
+    std::string temporaryFileName = fileName + ".XXXXXX";
+    int fileDescriptor = mkstemp(&temporaryFileName[0]);
+    if (fileDescriptor < 0)
+        return false;
+
+    // The temporary file is created for the owner only, the replaced file keeps its permissions
+    struct stat fileStat;
+    if (stat(fileName.c_str(), &fileStat) == 0)
+        fchmod(fileDescriptor, fileStat.st_mode & 0777);
+
+    // The content must be on the disk before the rename makes it the file
+    bool isWritten = WriteAll(fileDescriptor, content.data(), content.size()) && fsync(fileDescriptor) == 0;
+    isWritten = close(fileDescriptor) == 0 && isWritten;
+    if (!isWritten || std::rename(temporaryFileName.c_str(), fileName.c_str()) != 0)
+    {
+        std::remove(temporaryFileName.c_str());
+        return false;
+    }
+
+    return SyncParentDirectory(fileName);
+#else
+    // Write the temporary file with a unique name, the streams can not flush it to the disk
+    static std::atomic<std::uint64_t> writesCount(0);
+    std::string temporaryFileName = fileName + "." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "." +
+        std::to_string(writesCount.fetch_add(1)) + ".tmp";
+    std::ofstream file(temporaryFileName, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+
+    file.write(content.data(), content.size());
+    file.close();
+    if (!file)
+    {
+        std::remove(temporaryFileName.c_str());
+        return false;
+    }
+
+    return std::rename(temporaryFileName.c_str(), fileName.c_str()) == 0;
+#endif // SHA2_POSIX_FILES
+}
+
+std::string FileVersionTag(const std::string& fileName) noexcept
+{
+#ifdef SHA2_POSIX_FILES
+    struct stat fileStat;
+    if (stat(fileName.c_str(), &fileStat) != 0)
+        return "";
+
+#ifdef __APPLE__
+    std::int64_t modificationTime = static_cast<std::int64_t>(fileStat.st_mtimespec.tv_sec) * 1000000000 + fileStat.st_mtimespec.tv_nsec;
+#else
+    std::int64_t modificationTime = static_cast<std::int64_t>(fileStat.st_mtim.tv_sec) * 1000000000 + fileStat.st_mtim.tv_nsec;
+#endif // __APPLE__
+
+    return std::to_string(static_cast<std::uint64_t>(fileStat.st_dev)) + " " + std::to_string(static_cast<std::uint64_t>(fileStat.st_ino)) + " " +
+        std::to_string(static_cast<std::uint64_t>(fileStat.st_size)) + " " + std::to_string(modificationTime) + "\n";
+#else
+    // Without inodes the file is identified by its size and modification time
+    std::error_code error;
+    std::uintmax_t size = std::filesystem::file_size(fileName, error);
+    if (error)
+        return "";
+    auto modificationTime = std::filesystem::last_write_time(fileName, error);
+    if (error)
+        return "";
+
+    return std::to_string(size) + " " + std::to_string(modificationTime.time_since_epoch().count()) + "\n";
+#endif // SHA2_POSIX_FILES
+}
+
+#ifdef SHA2_IO_URING
+/// \brief Minimal io_uring instance for asynchronous file reading
+class IoUring
+{
+private:
+    // Descriptor of the ring
+    int ringFd = -1;
+
+    // Memory of the submission queue ring, the completion queue ring and the submission queue entries
+    void* sqRing = MAP_FAILED;
+    void* cqRing = MAP_FAILED;
+    void* sqesMemory = MAP_FAILED;
+    std::size_t sqRingSize = 0, cqRingSize = 0, sqesSize = 0;
+
+    // Pointers to the submission queue fields
+    unsigned* sqHead;
+    unsigned* sqTail;
+    unsigned* sqArray;
+    unsigned sqMask, sqEntries;
+    io_uring_sqe* sqes;
+
+    // Pointers to the completion queue fields
+    unsigned* cqHead;
+    unsigned* cqTail;
+    unsigned cqMask;
+    io_uring_cqe* cqes;
+
+    // Number of entries added to the submission queue but not submitted to the kernel
+    unsigned toSubmit = 0;
+
+public:
+    IoUring() = default;
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    ~IoUring()
+    {
+        if (sqesMemory != MAP_FAILED) munmap(sqesMemory, sqesSize);
+        if (cqRing != MAP_FAILED && cqRing != sqRing) munmap(cqRing, cqRingSize);
+        if (sqRing != MAP_FAILED) munmap(sqRing, sqRingSize);
+        if (ringFd >= 0) close(ringFd);
+    }
+
+    /**
+        \brief Method for creating the ring
+
+        \param [in] entries the minimal number of the submission queue entries
+
+        \return true if the ring was created, false if io_uring is not supported or not allowed
+    */
+    bool Setup(const unsigned int& entries) noexcept
+    {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+
+        ringFd = syscall(__NR_io_uring_setup, entries, &params);
+        if (ringFd < 0)
+            return false;
+
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+        // Both rings can be mapped with one call on new kernels
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+            sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+
+        sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+        if (sqRing == MAP_FAILED)
+            return false;
+
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+            cqRing = sqRing;
+        else
+            cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+
+        sqesMemory = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+        if (cqRing == MAP_FAILED || sqesMemory == MAP_FAILED)
+            return false;
+
+        char* sq = static_cast<char*>(sqRing);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqEntries = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+        sqes = static_cast<io_uring_sqe*>(sqesMemory);
+
+        char* cq = static_cast<char*>(cqRing);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        return true;
+    }
+
+    /**
+        \brief Method for adding the read request to the submission queue
+
+        \param [in] fd descriptor of the file to read
+        \param [in] vec the buffer to read to. Must be valid until the request is completed
+        \param [in] offset offset in the file to read from
+        \param [in] userData the value to identify the request on completion
+
+        \return true if the request was added, false if the submission queue is full
+    */
+    bool Read(const int& fd, const iovec* vec, const std::uint64_t& offset, const std::uint64_t& userData) noexcept
+    {
+        unsigned tail = *sqTail;
+        if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries)
+            return false;
+
+        unsigned index = tail & sqMask;
+        io_uring_sqe& sqe = sqes[index];
+        memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READV;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<std::uint64_t>(vec);
+        sqe.len = 1;
+        sqe.off = offset;
+        sqe.user_data = userData;
+
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        ++toSubmit;
+        return true;
+    }
+
+    /**
+        \brief Method for submitting the queued requests and waiting for one completion
+
+        \param [out] userData the value of the completed request
+        \param [out] res the result of the completed request. The number of read bytes or a negative error code
+
+        \return true if a request was completed, false on the ring error
+    */
+    bool Wait(std::uint64_t& userData, int& res) noexcept
+    {
+        while (true)
+        {
+            unsigned head = *cqHead;
+            if (head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE))
+            {
+                const io_uring_cqe& cqe = cqes[head & cqMask];
+                userData = cqe.user_data;
+                res = cqe.res;
+                __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+
+            int submitted = syscall(__NR_io_uring_enter, ringFd, toSubmit, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (submitted < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                return false;
+            }
+
+            toSubmit -= submitted;
+        }
+    }
+};
+
+/**
+    \brief A function for reading files with io_uring
+
+    Up to openFilesCount files are read at the same time and every file has depth chunks in flight,
+    so the kernel reads the next chunks while the handler processes the current one.
+    The chunks of every file are passed to the handler in order on the calling thread
+
+    \param [in] files the names of files to read
+    \param [in] chunkSize the size of the chunks
+    \param [in] depth the number of buffers of every file
+    \param [in] openFilesCount the number of files read at the same time
+    \param [in] handler the function to handle the chunks
+    \param [out] isFailed flags of the files that cannot be read. The handler is not called with the last chunk for such files
+
+    \return true if the files were read, false if io_uring cannot be used. In this case the handler was not called
+*/
+bool ReadFilesIoUring(const std::vector<std::string>& files, const std::size_t& chunkSize, const unsigned int& depth, const unsigned int& openFilesCount, const FileChunkHandler& handler, std::vector<bool>& isFailed)
+{
+    IoUring ring;
+    if (!ring.Setup(depth * openFilesCount))
+        return false;
+
+    // State of the file read in the slot
+    struct FileSlot
+    {
+        int fd = -1;
+        std::size_t index;
+        std::uint64_t size, readOffset, handleOffset;
+        unsigned int inFlight = 0;
+        bool isFailed;
+    };
+
+    // Buffer for one chunk of file
+    struct ChunkBuffer
+    {
+        std::vector<char> data;
+        iovec vec;
+        std::uint64_t offset;
+        std::size_t len, filled;
+        bool isUsed = false;
+    };
+
+    std::vector<FileSlot> slots(openFilesCount);
+    std::vector<ChunkBuffer> buffers(depth * openFilesCount);
+    for (ChunkBuffer& buffer : buffers)
+        buffer.data.resize(chunkSize);
+
+    // Index of the next file to open
+    std::size_t nextFile = 0;
+
+    // Submit reads to all free buffers of the slot
+    auto submitReads = [&](const std::size_t& slotIndex)
+    {
+        FileSlot& slot = slots[slotIndex];
+        for (std::size_t i = slotIndex * depth; i < (slotIndex + 1) * depth && slot.readOffset < slot.size; ++i)
+        {
+            ChunkBuffer& buffer = buffers[i];
+            if (buffer.isUsed)
+                continue;
+
+            buffer.isUsed = true;
+            buffer.offset = slot.readOffset;
+            buffer.len = std::min(static_cast<std::uint64_t>(chunkSize), slot.size - slot.readOffset);
+            buffer.filled = 0;
+            buffer.vec.iov_base = buffer.data.data();
+            buffer.vec.iov_len = buffer.len;
+            slot.readOffset += buffer.len;
+
+            ring.Read(slot.fd, &buffer.vec, buffer.offset, i);
+            ++slot.inFlight;
+        }
+    };
+
+    // Open the next readable file in the slot
+    auto openNext = [&](const std::size_t& slotIndex)
+    {
+        FileSlot& slot = slots[slotIndex];
+
+        while (nextFile < files.size())
+        {
+            slot.index = nextFile++;
+            slot.fd = open(files[slot.index].c_str(), O_RDONLY);
+            if (slot.fd < 0) { isFailed[slot.index] = true; continue; }
+
+            struct stat fileStat;
+            if (fstat(slot.fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+            {
+                // Pipes and devices cannot be read by offsets, so they are read synchronously
+                ssize_t len;
+                while ((len = read(slot.fd, buffers[slotIndex * depth].data.data(), chunkSize)) > 0)
+                    handler(slot.index, buffers[slotIndex * depth].data.data(), len, false);
+
+                if (len == 0)
+                    handler(slot.index, buffers[slotIndex * depth].data.data(), 0, true);
+                else
+                    isFailed[slot.index] = true;
+
+                close(slot.fd);
+                continue;
+            }
+
+            if (fileStat.st_size == 0)
+            {
+                handler(slot.index, buffers[slotIndex * depth].data.data(), 0, true);
+                close(slot.fd);
+                continue;
+            }
+
+            posix_fadvise(slot.fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+            slot.size = fileStat.st_size;
+            slot.readOffset = slot.handleOffset = 0;
+            slot.isFailed = false;
+            submitReads(slotIndex);
+            return true;
+        }
+
+        slot.fd = -1;
+        return false;
+    };
+
+    std::size_t activeSlots = 0;
+    for (std::size_t i = 0; i < slots.size(); ++i)
+        activeSlots += openNext(i);
+
+    while (activeSlots > 0)
+    {
+        std::uint64_t bufferIndex;
+        int res;
+        if (!ring.Wait(bufferIndex, res))
+        {
+            // Ring is broken, mark all unfinished files as failed
+            for (FileSlot& slot : slots)
+                if (slot.fd >= 0) { isFailed[slot.index] = true; close(slot.fd); }
+
+            for (; nextFile < files.size(); ++nextFile)
+                isFailed[nextFile] = true;
+
+            return true;
+        }
+
+        std::size_t slotIndex = bufferIndex / depth;
+        FileSlot& slot = slots[slotIndex];
+        ChunkBuffer& buffer = buffers[bufferIndex];
+        --slot.inFlight;
+
+        if (res <= 0)
+        {
+            // Read error or the file was truncated
+            slot.isFailed = true;
+            buffer.isUsed = false;
+        }
+        else if (buffer.filled + res < buffer.len)
+        {
+            // Short read, request the rest of the chunk
+            buffer.filled += res;
+            buffer.vec.iov_base = buffer.data.data() + buffer.filled;
+            buffer.vec.iov_len = buffer.len - buffer.filled;
+            ring.Read(slot.fd, &buffer.vec, buffer.offset + buffer.filled, bufferIndex);
+            ++slot.inFlight;
+            continue;
+        }
+        else
+            buffer.filled = buffer.len;
+
+        // Handle completed chunks in order
+        bool isHandled = true;
+        while (!slot.isFailed && isHandled)
+        {
+            isHandled = false;
+            for (std::size_t i = slotIndex * depth; i < (slotIndex + 1) * depth; ++i)
+            {
+                ChunkBuffer& chunk = buffers[i];
+                if (chunk.isUsed && chunk.filled == chunk.len && chunk.offset == slot.handleOffset)
+                {
+                    slot.handleOffset += chunk.len;
+                    handler(slot.index, chunk.data.data(), chunk.len, slot.handleOffset == slot.size);
+                    chunk.isUsed = false;
+                    isHandled = true;
+                }
+            }
+
+            submitReads(slotIndex);
+        }
+
+        // Switch slot to the next file
+        if ((slot.isFailed && slot.inFlight == 0) || (!slot.isFailed && slot.handleOffset == slot.size))
+        {
+            isFailed[slot.index] = slot.isFailed;
+            close(slot.fd);
+
+            for (std::size_t i = slotIndex * depth; i < (slotIndex + 1) * depth; ++i)
+                buffers[i].isUsed = false;
+
+            if (!openNext(slotIndex))
+                --activeSlots;
+        }
+    }
+
+    return true;
+}
+#endif // SHA2_IO_URING
+
+/**
+    \brief A function for reading files with a read ahead thread
+
+    The reader thread fills up to depth buffers in advance while the handler processes the chunks on the calling thread.
+    If the reader thread cannot be started, the files are read on the calling thread without the read ahead
+
+    \param [in] files the names of files to read
+    \param [in] chunkSize the size of the chunks
+    \param [in] depth the number of buffers
+    \param [in] handler the function to handle the chunks
+    \param [out] isFailed flags of the files that cannot be read. The handler is not called with the last chunk for such files
+*/
+void ReadFilesReadAhead(const std::vector<std::string>& files, const std::size_t& chunkSize, const unsigned int& depth, const FileChunkHandler& handler, std::vector<bool>& isFailed)
+{
+    // Chunk read by the reader thread
+    struct Chunk
+    {
+        std::size_t file, buffer, len;
+        bool isLast, isFailed;
+    };
+
+    std::vector<std::vector<char>> buffers(std::max(depth, 2u), std::vector<char>(chunkSize));
+    std::deque<std::size_t> freeBuffers;
+    std::deque<Chunk> readChunks;
+    std::mutex mutex;
+    std::condition_variable changed;
+
+    for (std::size_t i = 0; i < buffers.size(); ++i)
+        freeBuffers.push_back(i);
+
+    std::thread reader;
+    try
+    {
+        reader = std::thread([&]()
+        {
+            for (std::size_t file = 0; file < files.size(); ++file)
+            {
+                std::ifstream stream(files[file], std::ios_base::binary);
+                bool isLast = false;
+
+                while (!isLast)
+                {
+                    // Take free buffer
+                    std::size_t buffer;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        changed.wait(lock, [&]() { return !freeBuffers.empty(); });
+                        buffer = freeBuffers.front();
+                        freeBuffers.pop_front();
+                    }
+
+                    Chunk chunk = { file, buffer, 0, true, !stream.is_open() };
+                    if (!chunk.isFailed)
+                    {
+                        stream.read(buffers[buffer].data(), chunkSize);
+                        chunk.len = stream.gcount();
+                        chunk.isFailed = stream.bad();
+                        chunk.isLast = chunk.len < chunkSize;
+                    }
+
+                    isLast = chunk.isLast || chunk.isFailed;
+
+                    std::lock_guard<std::mutex> lock(mutex);
+                    readChunks.push_back(chunk);
+                    changed.notify_all();
+                }
+            }
+        });
+    }
+    catch (...)
+    {
+        // The reader thread cannot be started, so the files are read and handled on the calling thread
+        for (std::size_t file = 0; file < files.size(); ++file)
+        {
+            std::ifstream stream(files[file], std::ios_base::binary);
+            isFailed[file] = !stream.is_open();
+
+            for (bool isLast = false; !isLast && !isFailed[file];)
+            {
+                stream.read(buffers[0].data(), chunkSize);
+                std::size_t len = stream.gcount();
+                isFailed[file] = stream.bad();
+                isLast = len < chunkSize;
+
+                if (!isFailed[file])
+                    handler(file, buffers[0].data(), len, isLast);
+            }
+        }
+
+        return;
+    }
+
+    for (std::size_t handledFiles = 0; handledFiles < files.size();)
+    {
+        Chunk chunk;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&]() { return !readChunks.empty(); });
+            chunk = readChunks.front();
+            readChunks.pop_front();
+        }
+
+        if (chunk.isFailed)
+            isFailed[chunk.file] = true;
+        else
+            handler(chunk.file, buffers[chunk.buffer].data(), chunk.len, chunk.isLast);
+
+        handledFiles += chunk.isLast || chunk.isFailed;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        freeBuffers.push_back(chunk.buffer);
+        changed.notify_all();
+    }
+
+    reader.join();
+}
+
+/**
+    \brief A function for reading files with overlapping of reading and handling
+
+    io_uring is used on Linux if the kernel allows it, otherwise the files are read by a read ahead thread
+
+    \param [in] files the names of files to read
+    \param [in] chunkSize the size of the chunks
+    \param [in] depth the number of buffers of every file
+    \param [in] openFilesCount the number of files read at the same time with io_uring
+    \param [in] handler the function to handle the chunks. Called on the calling thread
+    \param [out] isFailed flags of the files that cannot be read
+*/
+void ReadFilesPipelined(const std::vector<std::string>& files, const std::size_t& chunkSize, const unsigned int& depth, const unsigned int& openFilesCount, const FileChunkHandler& handler, std::vector<bool>& isFailed)
+{
+    isFailed.assign(files.size(), false);
+
+#ifdef SHA2_IO_URING
+    if (ReadFilesIoUring(files, chunkSize, std::max(depth, 1u), std::max(openFilesCount, 1u), handler, isFailed))
+        return;
+#endif // SHA2_IO_URING
+
+    ReadFilesReadAhead(files, chunkSize, depth, handler, isFailed);
+}
+
+/// \brief Queue of the task indexes of one worker thread
+struct WorkerQueue
+{
+    // Mutex to protect tasks
+    std::mutex mutex;
+
+    // Indexes of the tasks
+    std::deque<std::size_t> tasks;
+};
+
+/**
+    \brief A function for running independent tasks on several threads with work stealing
+
+    Tasks are distributed between the queues of the workers in turn. Every worker takes tasks from the front of its own queue
+    and when it is empty steals tasks from the back of the other queues, so long tasks on one thread do not delay the remaining tasks.
+    The calling thread is used as one of the workers, the function returns when all tasks are done
+
+    \param [in] tasksCount the number of tasks
+    \param [in] threadsCount the number of worker threads
+    \param [in] task the function to run for every task index
+*/
+void RunWorkStealing(const std::size_t& tasksCount, const unsigned int& threadsCount, const std::function<void(const std::size_t&)>& task)
+{
+    std::vector<WorkerQueue> queues(std::max(threadsCount, 1u));
+
+    // Distribute tasks between workers
+    for (std::size_t i = 0; i < tasksCount; ++i)
+        queues[i % queues.size()].tasks.push_back(i);
+
+    auto worker = [&](const std::size_t& workerIndex)
+    {
+        while (true)
+        {
+            bool isFound = false;
+            std::size_t taskIndex;
+
+            // Take task from own queue or steal it from other queues
+            for (std::size_t i = 0; i < queues.size() && !isFound; ++i)
+            {
+                WorkerQueue& queue = queues[(workerIndex + i) % queues.size()];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+
+                if (queue.tasks.empty())
+                    continue;
+
+                isFound = true;
+                if (i == 0)
+                {
+                    taskIndex = queue.tasks.front();
+                    queue.tasks.pop_front();
+                }
+                else
+                {
+                    taskIndex = queue.tasks.back();
+                    queue.tasks.pop_back();
+                }
+            }
+
+            // Tasks are never added, so all queues are empty forever
+            if (!isFound)
+                return;
+
+            task(taskIndex);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < queues.size(); ++i)
+        threads.emplace_back(worker, i);
+
+    worker(0);
+
+    for (std::thread& thread : threads)
+        thread.join();
+}
@@ -0,0 +1,336 @@
+#ifndef SHA2_INTERNAL_H
+#define SHA2_INTERNAL_H
+
+#include "Sha2.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+// The hashing functions count their calls only if the metrics are enabled
+#ifdef SHA2_METRICS
+#include <atomic>
+#include <chrono>
+#endif // SHA2_METRICS
+
+// Check if the files can be mapped to memory
+#if defined(__unix__) || defined(__APPLE__)
+#define SHA2_POSIX_FILES
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <cerrno>
+#include <csignal>
+#include <csetjmp>
+#endif
+
+// Check if the files can be read with io_uring
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define SHA2_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+// Check if the x86 hardware accelerated kernels can be compiled
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SHA2_X86_KERNELS
+#include <immintrin.h>
+#include <cpuid.h>
+#endif
+
+// Check if the ARMv8 crypto extensions kernels can be compiled. They are built only on request until they are checked on the hardware
+#if defined(SHA2_ENABLE_ARM_KERNELS) && defined(__aarch64__) && defined(__GNUC__) && defined(__linux__)
+#define SHA2_ARM_KERNELS
+#include <arm_neon.h>
+#include <sys/auxv.h>
+#endif
+
+/// \brief Type of the functions for handling the chunks of files read by the pipeline. The arguments are file index, chunk data, chunk length and the flag of the last chunk
+typedef std::function<void(const std::size_t&, const char*, const std::size_t&, const bool&)> FileChunkHandler;
+
+/// \brief A function for reading files with overlapping of reading and handling
+void ReadFilesPipelined(const std::vector<std::string>& files, const std::size_t& chunkSize, const unsigned int& depth, const unsigned int& openFilesCount, const FileChunkHandler& handler, std::vector<bool>& isFailed);
+
+#ifdef SHA2_POSIX_FILES
+/**
+    \brief A function for reading the pages of a mapped file with protection against the truncation of the file
+
+    If the file is truncated during the reading, the access past its new end raises SIGBUS. The signal is caught and the reading
+    is stopped instead of killing the process. The read function must not own objects with destructors, they are skipped by the stop
+
+    \param [in] read the function reading the mapped pages
+    \param [in] argument the argument of the read function
+
+    \return true if the read function returned, false if the file was truncated
+*/
+bool RunGuardedMappedRead(void (*read)(void*), void* argument) noexcept;
+
+/// \brief A function for writing the whole array to a file, the interrupted and partial writes are continued
+bool WriteAll(const int& fileDescriptor, const char* data, std::size_t len) noexcept;
+
+/// \brief A function for flushing the directory of a file to the disk, so a renamed file survives a crash
+bool SyncParentDirectory(const std::string& fileName) noexcept;
+#endif // SHA2_POSIX_FILES
+
+/**
+    \brief A function for replacing the content of a file atomically
+
+    The content is written to a temporary file with a unique name, flushed to the disk and renamed to the file,
+    so the file has either the old or the new content after a crash
+
+    \param [in] fileName name of the file
+    \param [in] content new content of the file
+
+    \return true if the file was replaced
+*/
+bool ReplaceFileContent(const std::string& fileName, const std::string& content) noexcept;
+
+/**
+    \brief A function for getting the tag of the file version, the tag changes if the file is replaced or modified
+
+    \param [in] fileName name of the file
+
+    \return a line with the device, inode, size and modification time of the file, or an empty string if the file does not exist
+*/
+std::string FileVersionTag(const std::string& fileName) noexcept;
+
+#ifdef SHA2_X86_KERNELS
+/// \brief Check if the processor supports the Intel SHA extensions
+bool IsShaNiSupported() noexcept;
+
+/// \brief Check if the operating system saves the given extended register states on context switches
+bool IsXcr0Enabled(const std::uint32_t& mask) noexcept;
+
+/// \brief Check if the processor and the operating system support AVX2
+bool IsAvx2Supported() noexcept;
+
+/// \brief Check if the processor and the operating system support AVX-512 foundation instructions
+bool IsAvx512Supported() noexcept;
+#endif // SHA2_X86_KERNELS
+
+#ifdef SHA2_ARM_KERNELS
+/// \brief Check if the processor supports the sha256 instructions of the ARMv8 crypto extensions
+bool IsArmSha256Supported() noexcept;
+
+/// \brief Check if the processor supports the sha512 instructions of the ARMv8.2 crypto extensions
+bool IsArmSha512Supported() noexcept;
+#endif // SHA2_ARM_KERNELS
+
+/// \brief A function for running independent tasks on several threads with work stealing
+void RunWorkStealing(const std::size_t& tasksCount, const unsigned int& threadsCount, const std::function<void(const std::size_t&)>& task);
+
+/// \brief Type of the functions for calculating sha256 hashing steps for a run of blocks
+typedef void (*Sha256StepsFunction)(const char*, const std::size_t&, std::uint32_t&, std::uint32_t&, std::uint32_t&, std::uint32_t&, std::uint32_t&, std::uint32_t&, std::uint32_t&, std::uint32_t&);
+
+/// \brief Sha256 hashing steps for a run of blocks
+void Sha256StepsScalar(const char* data, const std::size_t& blocksCount, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7) noexcept;
+
+#ifdef SHA2_X86_KERNELS
+/// \brief Sha256 hashing steps for a run of blocks using the Intel SHA extensions
+void Sha256StepsShaNi(const char* data, const std::size_t& blocksCount, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7) noexcept;
+
+/// \brief Sha256 hashing step for 8 independent blocks using AVX2
+void Sha256StepAvx2x8(const char* const* blocks, std::uint32_t* state) noexcept;
+
+/// \brief Sha256 hashing step for 16 independent blocks using AVX-512
+void Sha256StepAvx512x16(const char* const* blocks, std::uint32_t* state) noexcept;
+
+/// \brief Second pass of sha256d for 8 independent first pass results using AVX2
+void Sha256dSecondPassAvx2x8(std::uint32_t* state) noexcept;
+
+/// \brief Second pass of sha256d for 16 independent first pass results using AVX-512
+void Sha256dSecondPassAvx512x16(std::uint32_t* state) noexcept;
+
+/// \brief Padding block of 64 byte messages for 8 independent states using AVX2
+void Sha256NodePaddingAvx2x8(std::uint32_t* state) noexcept;
+
+/// \brief Padding block of 64 byte messages for 16 independent states using AVX-512
+void Sha256NodePaddingAvx512x16(std::uint32_t* state) noexcept;
+
+/// \brief A function for calculating the hash sums of many messages in parallel SIMD lanes
+void HashSha256Lanes(const int& lanesCount, void (*step)(const char* const*, std::uint32_t*), const char* const* data, const std::size_t* dataLens, const std::size_t& count, const std::uint32_t* beginHash, std::uint32_t* hashes) noexcept;
+#endif // SHA2_X86_KERNELS
+
+#ifdef SHA2_ARM_KERNELS
+/// \brief Sha256 hashing steps for a run of blocks using the ARMv8 crypto extensions
+void Sha256StepsArm(const char* data, const std::size_t& blocksCount, std::uint32_t& h0, std::uint32_t& h1, std::uint32_t& h2, std::uint32_t& h3, std::uint32_t& h4, std::uint32_t& h5, std::uint32_t& h6, std::uint32_t& h7) noexcept;
+#endif // SHA2_ARM_KERNELS
+
+/// \brief Type of the functions for calculating sha512 hashing steps for a run of blocks
+typedef void (*Sha512StepsFunction)(const char*, const std::size_t&, std::uint64_t&, std::uint64_t&, std::uint64_t&, std::uint64_t&, std::uint64_t&, std::uint64_t&, std::uint64_t&, std::uint64_t&);
+
+/// \brief Sha512 hashing steps for a run of blocks
+void Sha512StepsScalar(const char* data, const std::size_t& blocksCount, std::uint64_t& h0, std::uint64_t& h1, std::uint64_t& h2, std::uint64_t& h3, std::uint64_t& h4, std::uint64_t& h5, std::uint64_t& h6, std::uint64_t& h7) noexcept;
+
+#ifdef SHA2_ARM_KERNELS
+/// \brief Sha512 hashing steps for a run of blocks using the ARMv8.2 crypto extensions
+void Sha512StepsArm(const char* data, const std::size_t& blocksCount, std::uint64_t& h0, std::uint64_t& h1, std::uint64_t& h2, std::uint64_t& h3, std::uint64_t& h4, std::uint64_t& h5, std::uint64_t& h6, std::uint64_t& h7) noexcept;
+#endif // SHA2_ARM_KERNELS
+
+#ifdef SHA2_X86_KERNELS
+/// \brief Sha512 hashing step for 4 independent blocks using AVX2
+void Sha512StepAvx2x4(const char* const* blocks, std::uint64_t* state) noexcept;
+
+/// \brief Sha512 hashing step for 8 independent blocks using AVX-512
+void Sha512StepAvx512x8(const char* const* blocks, std::uint64_t* state) noexcept;
+
+/// \brief A function for calculating the hash sums of many messages in parallel SIMD lanes
+void HashSha512Lanes(const int& lanesCount, void (*step)(const char* const*, std::uint64_t*), const char* const* data, const std::size_t* dataLens, const std::size_t& count, const std::uint64_t* beginHash, std::uint64_t* hashes) noexcept;
+#endif // SHA2_X86_KERNELS
+
+/// \brief Names of the kernels selected for single sha256 messages
+const char* Sha256SingleKernelName() noexcept;
+
+/// \brief Names of the kernels selected for batches of sha256 messages
+const char* Sha256BatchKernelName() noexcept;
+
+/// \brief Names of the kernels selected for single sha512 messages
+const char* Sha512SingleKernelName() noexcept;
+
+/// \brief Names of the kernels selected for batches of sha512 messages
+const char* Sha512BatchKernelName() noexcept;
+
+/// \brief Families of the hashing functions in the metrics
+enum class Sha2MetricsFamily
+{
+    Sha256,
+    Sha512
+};
+
+#ifdef SHA2_METRICS
+/// \brief Counters of one family of one thread. Only the owning thread writes them, other threads read them for the snapshots
+struct Sha2ThreadCounters
+{
+    std::atomic<std::uint64_t> bytesCount{ 0 };
+    std::atomic<std::uint64_t> blocksCount{ 0 };
+    std::atomic<std::uint64_t> callsCount{ 0 };
+    std::atomic<std::uint64_t> callsBytes{ 0 };
+    std::atomic<std::uint64_t> callsBySize[9] = {};
+    std::atomic<std::uint64_t> latencySamplesCount{ 0 };
+    std::atomic<std::uint64_t> latencySum{ 0 };
+    std::atomic<std::uint64_t> latencyBuckets[13] = {};
+    std::atomic<std::uint64_t> fileReadTime{ 0 };
+    std::atomic<std::uint64_t> fileHashTime{ 0 };
+
+    // Counter of the short calls for the latency sampling
+    std::uint32_t shortCallsCount = 0;
+};
+
+/// \brief A function for getting the counters of the current thread
+Sha2ThreadCounters& GetThreadCounters(const Sha2MetricsFamily& family) noexcept;
+
+/// \brief Increase the counter of the current thread. The counter has a single writer, so no atomic read-modify-write is needed
+inline void IncreaseCounter(std::atomic<std::uint64_t>& counter, const std::uint64_t& value) noexcept
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+#endif // SHA2_METRICS
+
+/// \brief Get the time for the metrics in nanoseconds, 0 if the metrics are disabled
+inline std::uint64_t Sha2MetricsTime() noexcept
+{
+#ifdef SHA2_METRICS
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+    return 0;
+#endif // SHA2_METRICS
+}
+
+/// \brief Count the blocks compressed by the kernels
+inline void RecordSha2Blocks(const Sha2MetricsFamily& family, const std::uint64_t& blocksCount) noexcept
+{
+#ifdef SHA2_METRICS
+    IncreaseCounter(GetThreadCounters(family).blocksCount, blocksCount);
+#else
+    (void)family;
+    (void)blocksCount;
+#endif // SHA2_METRICS
+}
+
+/// \brief Count the bytes of the hashed messages
+inline void RecordSha2Bytes(const Sha2MetricsFamily& family, const std::uint64_t& bytesCount) noexcept
+{
+#ifdef SHA2_METRICS
+    IncreaseCounter(GetThreadCounters(family).bytesCount, bytesCount);
+#else
+    (void)family;
+    (void)bytesCount;
+#endif // SHA2_METRICS
+}
+
+/**
+    \brief Count the one-shot hashing call and start measuring its latency if it is sampled
+
+    \param [in] family family of the hashing function
+    \param [in] dataLen length of the message
+
+    \return the start time of the sampled call, 0 if the call is not sampled
+*/
+inline std::uint64_t StartSha2Call(const Sha2MetricsFamily& family, const std::size_t& dataLen) noexcept
+{
+#ifdef SHA2_METRICS
+    Sha2ThreadCounters& counters = GetThreadCounters(family);
+
+    std::size_t bucket = 0;
+    while (bucket < 8 && dataLen > Sha2SizeBuckets[bucket])
+        ++bucket;
+
+    IncreaseCounter(counters.bytesCount, dataLen);
+    IncreaseCounter(counters.callsCount, 1);
+    IncreaseCounter(counters.callsBytes, dataLen);
+    IncreaseCounter(counters.callsBySize[bucket], 1);
+
+    // The clock costs as much as hashing a short message, so only every 64th short call is measured
+    if (dataLen < 4096 && (++counters.shortCallsCount & 63) != 0)
+        return 0;
+
+    return Sha2MetricsTime();
+#else
+    (void)family;
+    (void)dataLen;
+    return 0;
+#endif // SHA2_METRICS
+}
+
+/// \brief Finish measuring the latency of the call started with the StartSha2Call function
+inline void FinishSha2Call(const Sha2MetricsFamily& family, const std::uint64_t& startTime) noexcept
+{
+#ifdef SHA2_METRICS
+    if (startTime == 0)
+        return;
+
+    std::uint64_t latency = Sha2MetricsTime() - startTime;
+    std::size_t bucket = 0;
+    while (bucket < 12 && latency > Sha2LatencyBuckets[bucket])
+        ++bucket;
+
+    Sha2ThreadCounters& counters = GetThreadCounters(family);
+    IncreaseCounter(counters.latencySamplesCount, 1);
+    IncreaseCounter(counters.latencySum, latency);
+    IncreaseCounter(counters.latencyBuckets[bucket], 1);
+#else
+    (void)family;
+    (void)startTime;
+#endif // SHA2_METRICS
+}
+
+/// \brief Count the time of the file hashing spent in the reads and in the hashing in nanoseconds
+inline void RecordSha2FileTimes(const Sha2MetricsFamily& family, const std::uint64_t& readTime, const std::uint64_t& hashTime) noexcept
+{
+#ifdef SHA2_METRICS
+    Sha2ThreadCounters& counters = GetThreadCounters(family);
+    IncreaseCounter(counters.fileReadTime, readTime);
+    IncreaseCounter(counters.fileHashTime, hashTime);
+#else
+    (void)family;
+    (void)readTime;
+    (void)hashTime;
+#endif // SHA2_METRICS
+}
+
+#endif // SHA2_INTERNAL_H
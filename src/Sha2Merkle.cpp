@@ -0,0 +1,393 @@
+#include "Sha2Internal.h"
+#include "Sha2Merkle.h"
+
+#include <algorithm>
+
+// The pairs of children are read from the arrays of nodes as one message
+static_assert(sizeof(Sha256Digest) == 32 && sizeof(Sha512Digest) == 64, "The nodes must be stored without gaps");
+
+void MerkleTreeSha256::Allocate(const std::size_t& leavesCount)
+{
+    // Sizes of the levels from the leaves to the root
+    levelOffsets.assign(1, 0);
+    std::size_t offset = 0;
+    for (std::size_t count = leavesCount; count > 0; count = count > 1 ? (count + 1) >> 1 : 0)
+    {
+        offset += count;
+        levelOffsets.push_back(offset);
+    }
+
+    nodes.resize(offset);
+}
+
+void MerkleTreeSha256::BuildLevels(const unsigned int& threadsCount)
+{
+    for (std::size_t level = 0; level + 2 < levelOffsets.size(); ++level)
+    {
+        const std::size_t count = levelOffsets[level + 1] - levelOffsets[level];
+        const std::uint8_t* children = reinterpret_cast<const std::uint8_t*>(nodes.data() + levelOffsets[level]);
+        std::uint8_t* parents = reinterpret_cast<std::uint8_t*>(nodes.data() + levelOffsets[level + 1]);
+        std::size_t parentsCount = count >> 1;
+
+        // Hash the parents, large levels in parallel threads
+        std::size_t tasksCount = (parentsCount + MERKLE_TASK_SIZE - 1) / MERKLE_TASK_SIZE;
+        if (tasksCount > 1 && threadsCount > 1)
+        {
+            RunWorkStealing(tasksCount, static_cast<unsigned int>(std::min(static_cast<std::size_t>(threadsCount), tasksCount)), [&](const std::size_t& task)
+            {
+                std::size_t first = task * MERKLE_TASK_SIZE;
+                HashSha256Nodes(children + first * 64, std::min(parentsCount - first, static_cast<std::size_t>(MERKLE_TASK_SIZE)), parents + first * 32);
+            });
+        }
+        else
+            HashSha256Nodes(children, parentsCount, parents);
+
+        // Move unpaired node to the next level
+        if (count & 1)
+            nodes[levelOffsets[level + 1] + parentsCount] = nodes[levelOffsets[level] + count - 1];
+    }
+}
+
+void MerkleTreeSha256::UpdatePath(std::size_t index) noexcept
+{
+    for (std::size_t level = 0; level + 2 < levelOffsets.size(); ++level)
+    {
+        const std::size_t count = levelOffsets[level + 1] - levelOffsets[level];
+        std::size_t left = index & ~static_cast<std::size_t>(1);
+        Sha256Digest& parent = nodes[levelOffsets[level + 1] + (index >> 1)];
+
+        if (left + 1 < count)
+            HashSha256Nodes(nodes[levelOffsets[level] + left].data(), 1, parent.data());
+        else
+            parent = nodes[levelOffsets[level] + index];
+
+        index >>= 1;
+    }
+}
+
+void MerkleTreeSha256::Build(const char* const* leaves, const std::size_t* leafLens, const std::size_t& count, const unsigned int& threadsCount)
+{
+    // Begin hash values
+    const std::uint32_t beginHash[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+    Allocate(count);
+
+    // Hash the records in batches, large trees in parallel threads
+    std::size_t tasksCount = (count + MERKLE_TASK_SIZE - 1) / MERKLE_TASK_SIZE;
+    auto hashLeaves = [&](const std::size_t& task)
+    {
+        std::size_t first = task * MERKLE_TASK_SIZE;
+        std::size_t batchCount = std::min(count - first, static_cast<std::size_t>(MERKLE_TASK_SIZE));
+
+        std::vector<std::uint32_t> hashes(batchCount * 8);
+        HashSha256Batch(leaves + first, leafLens + first, batchCount, beginHash, hashes.data());
+
+        for (std::size_t i = 0; i < batchCount; ++i)
+        {
+            const std::uint32_t* h = hashes.data() + i * 8;
+            StateToDigest(h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7], 32, nodes[first + i].data());
+        }
+    };
+
+    if (tasksCount > 1 && threadsCount > 1)
+        RunWorkStealing(tasksCount, static_cast<unsigned int>(std::min(static_cast<std::size_t>(threadsCount), tasksCount)), hashLeaves);
+    else
+        for (std::size_t task = 0; task < tasksCount; ++task)
+            hashLeaves(task);
+
+    BuildLevels(threadsCount);
+}
+
+void MerkleTreeSha256::Build(const std::vector<std::string>& leaves, const unsigned int& threadsCount)
+{
+    std::vector<const char*> data(leaves.size());
+    std::vector<std::size_t> dataLens(leaves.size());
+    for (std::size_t i = 0; i < leaves.size(); ++i)
+    {
+        data[i] = leaves[i].c_str();
+        dataLens[i] = leaves[i].length();
+    }
+
+    Build(data.data(), dataLens.data(), leaves.size(), threadsCount);
+}
+
+void MerkleTreeSha256::BuildFromDigests(const Sha256Digest* digests, const std::size_t& count, const unsigned int& threadsCount)
+{
+    Allocate(count);
+    std::copy(digests, digests + count, nodes.begin());
+    BuildLevels(threadsCount);
+}
+
+void MerkleTreeSha256::Update(const std::size_t& index, const char* data, const std::size_t& dataLen) noexcept
+{
+    UpdateDigest(index, Sha256Binary(data, dataLen));
+}
+
+void MerkleTreeSha256::Update(const std::size_t& index, const std::string& str) noexcept
+{
+    UpdateDigest(index, Sha256Binary(str));
+}
+
+void MerkleTreeSha256::UpdateDigest(const std::size_t& index, const Sha256Digest& digest) noexcept
+{
+    nodes[index] = digest;
+    UpdatePath(index);
+}
+
+Sha256Digest MerkleTreeSha256::Root() const noexcept
+{
+    if (nodes.empty())
+        return Sha256Binary("", 0);
+
+    return nodes.back();
+}
+
+std::size_t MerkleTreeSha256::LeavesCount() const noexcept
+{
+    return levelOffsets.size() > 1 ? levelOffsets[1] : 0;
+}
+
+const Sha256Digest& MerkleTreeSha256::Leaf(const std::size_t& index) const noexcept
+{
+    return nodes[index];
+}
+
+MerkleProofSha256 MerkleTreeSha256::Proof(const std::size_t& index) const
+{
+    MerkleProofSha256 res;
+    res.index = index;
+    res.leavesCount = LeavesCount();
+
+    std::size_t position = index;
+    for (std::size_t level = 0; level + 2 < levelOffsets.size(); ++level)
+    {
+        // The unpaired last node has no sibling
+        std::size_t sibling = position ^ 1;
+        if (sibling < levelOffsets[level + 1] - levelOffsets[level])
+            res.siblings.push_back(nodes[levelOffsets[level] + sibling]);
+
+        position >>= 1;
+    }
+
+    return res;
+}
+
+bool MerkleTreeSha256::VerifyProof(const Sha256Digest& leaf, const MerkleProofSha256& proof, const std::size_t& leavesCount, const Sha256Digest& root) noexcept
+{
+    // The shape of the tree is taken from the trusted number of leaves, the proof can only repeat it
+    if (proof.leavesCount != leavesCount || proof.index >= leavesCount)
+        return false;
+
+    // Pair of children in the order of the tree
+    Sha256Digest children[2];
+    Sha256Digest node = leaf;
+    std::size_t used = 0;
+
+    for (std::size_t count = leavesCount, position = proof.index; count > 1; count = (count + 1) >> 1, position >>= 1)
+    {
+        if ((position ^ 1) >= count)
+            continue;
+
+        if (used == proof.siblings.size())
+            return false;
+
+        children[position & 1] = node;
+        children[(position & 1) ^ 1] = proof.siblings[used++];
+        HashSha256Nodes(children[0].data(), 1, node.data());
+    }
+
+    return used == proof.siblings.size() && node == root;
+}
+
+void MerkleTreeSha512::Allocate(const std::size_t& leavesCount)
+{
+    // Sizes of the levels from the leaves to the root
+    levelOffsets.assign(1, 0);
+    std::size_t offset = 0;
+    for (std::size_t count = leavesCount; count > 0; count = count > 1 ? (count + 1) >> 1 : 0)
+    {
+        offset += count;
+        levelOffsets.push_back(offset);
+    }
+
+    nodes.resize(offset);
+}
+
+void MerkleTreeSha512::BuildLevels(const unsigned int& threadsCount)
+{
+    for (std::size_t level = 0; level + 2 < levelOffsets.size(); ++level)
+    {
+        const std::size_t count = levelOffsets[level + 1] - levelOffsets[level];
+        const std::uint8_t* children = reinterpret_cast<const std::uint8_t*>(nodes.data() + levelOffsets[level]);
+        std::uint8_t* parents = reinterpret_cast<std::uint8_t*>(nodes.data() + levelOffsets[level + 1]);
+        std::size_t parentsCount = count >> 1;
+
+        // Hash the parents, large levels in parallel threads
+        std::size_t tasksCount = (parentsCount + MERKLE_TASK_SIZE - 1) / MERKLE_TASK_SIZE;
+        if (tasksCount > 1 && threadsCount > 1)
+        {
+            RunWorkStealing(tasksCount, static_cast<unsigned int>(std::min(static_cast<std::size_t>(threadsCount), tasksCount)), [&](const std::size_t& task)
+            {
+                std::size_t first = task * MERKLE_TASK_SIZE;
+                HashSha512Nodes(children + first * 128, std::min(parentsCount - first, static_cast<std::size_t>(MERKLE_TASK_SIZE)), parents + first * 64);
+            });
+        }
+        else
+            HashSha512Nodes(children, parentsCount, parents);
+
+        // Move unpaired node to the next level
+        if (count & 1)
+            nodes[levelOffsets[level + 1] + parentsCount] = nodes[levelOffsets[level] + count - 1];
+    }
+}
+
+void MerkleTreeSha512::UpdatePath(std::size_t index) noexcept
+{
+    for (std::size_t level = 0; level + 2 < levelOffsets.size(); ++level)
+    {
+        const std::size_t count = levelOffsets[level + 1] - levelOffsets[level];
+        std::size_t left = index & ~static_cast<std::size_t>(1);
+        Sha512Digest& parent = nodes[levelOffsets[level + 1] + (index >> 1)];
+
+        if (left + 1 < count)
+            HashSha512Nodes(nodes[levelOffsets[level] + left].data(), 1, parent.data());
+        else
+            parent = nodes[levelOffsets[level] + index];
+
+        index >>= 1;
+    }
+}
+
+void MerkleTreeSha512::Build(const char* const* leaves, const std::size_t* leafLens, const std::size_t& count, const unsigned int& threadsCount)
+{
+    // Begin hash values
+    const std::uint64_t beginHash[8] = { 0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1, 0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179 };
+
+    Allocate(count);
+
+    // Hash the records in batches, large trees in parallel threads
+    std::size_t tasksCount = (count + MERKLE_TASK_SIZE - 1) / MERKLE_TASK_SIZE;
+    auto hashLeaves = [&](const std::size_t& task)
+    {
+        std::size_t first = task * MERKLE_TASK_SIZE;
+        std::size_t batchCount = std::min(count - first, static_cast<std::size_t>(MERKLE_TASK_SIZE));
+
+        std::vector<std::uint64_t> hashes(batchCount * 8);
+        HashSha512Batch(leaves + first, leafLens + first, batchCount, beginHash, hashes.data());
+
+        for (std::size_t i = 0; i < batchCount; ++i)
+        {
+            const std::uint64_t* h = hashes.data() + i * 8;
+            StateToDigest(h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7], 64, nodes[first + i].data());
+        }
+    };
+
+    if (tasksCount > 1 && threadsCount > 1)
+        RunWorkStealing(tasksCount, static_cast<unsigned int>(std::min(static_cast<std::size_t>(threadsCount), tasksCount)), hashLeaves);
+    else
+        for (std::size_t task = 0; task < tasksCount; ++task)
+            hashLeaves(task);
+
+    BuildLevels(threadsCount);
+}
+
+void MerkleTreeSha512::Build(const std::vector<std::string>& leaves, const unsigned int& threadsCount)
+{
+    std::vector<const char*> data(leaves.size());
+    std::vector<std::size_t> dataLens(leaves.size());
+    for (std::size_t i = 0; i < leaves.size(); ++i)
+    {
+        data[i] = leaves[i].c_str();
+        dataLens[i] = leaves[i].length();
+    }
+
+    Build(data.data(), dataLens.data(), leaves.size(), threadsCount);
+}
+
+void MerkleTreeSha512::BuildFromDigests(const Sha512Digest* digests, const std::size_t& count, const unsigned int& threadsCount)
+{
+    Allocate(count);
+    std::copy(digests, digests + count, nodes.begin());
+    BuildLevels(threadsCount);
+}
+
+void MerkleTreeSha512::Update(const std::size_t& index, const char* data, const std::size_t& dataLen) noexcept
+{
+    UpdateDigest(index, Sha512Binary(data, dataLen));
+}
+
+void MerkleTreeSha512::Update(const std::size_t& index, const std::string& str) noexcept
+{
+    UpdateDigest(index, Sha512Binary(str));
+}
+
+void MerkleTreeSha512::UpdateDigest(const std::size_t& index, const Sha512Digest& digest) noexcept
+{
+    nodes[index] = digest;
+    UpdatePath(index);
+}
+
+Sha512Digest MerkleTreeSha512::Root() const noexcept
+{
+    if (nodes.empty())
+        return Sha512Binary("", 0);
+
+    return nodes.back();
+}
+
+std::size_t MerkleTreeSha512::LeavesCount() const noexcept
+{
+    return levelOffsets.size() > 1 ? levelOffsets[1] : 0;
+}
+
+const Sha512Digest& MerkleTreeSha512::Leaf(const std::size_t& index) const noexcept
+{
+    return nodes[index];
+}
+
+MerkleProofSha512 MerkleTreeSha512::Proof(const std::size_t& index) const
+{
+    MerkleProofSha512 res;
+    res.index = index;
+    res.leavesCount = LeavesCount();
+
+    std::size_t position = index;
+    for (std::size_t level = 0; level + 2 < levelOffsets.size(); ++level)
+    {
+        // The unpaired last node has no sibling
+        std::size_t sibling = position ^ 1;
+        if (sibling < levelOffsets[level + 1] - levelOffsets[level])
+            res.siblings.push_back(nodes[levelOffsets[level] + sibling]);
+
+        position >>= 1;
+    }
+
+    return res;
+}
+
+bool MerkleTreeSha512::VerifyProof(const Sha512Digest& leaf, const MerkleProofSha512& proof, const std::size_t& leavesCount, const Sha512Digest& root) noexcept
+{
+    // The shape of the tree is taken from the trusted number of leaves, the proof can only repeat it
+    if (proof.leavesCount != leavesCount || proof.index >= leavesCount)
+        return false;
+
+    // Pair of children in the order of the tree
+    Sha512Digest children[2];
+    Sha512Digest node = leaf;
+    std::size_t used = 0;
+
+    for (std::size_t count = leavesCount, position = proof.index; count > 1; count = (count + 1) >> 1, position >>= 1)
+    {
+        if ((position ^ 1) >= count)
+            continue;
+
+        if (used == proof.siblings.size())
+            return false;
+
+        children[position & 1] = node;
+        children[(position & 1) ^ 1] = proof.siblings[used++];
+        HashSha512Nodes(children[0].data(), 1, node.data());
+    }
+
+    return used == proof.siblings.size() && node == root;
+}
@@ -0,0 +1,278 @@
+#include "Sha2Internal.h"
+#include "Sha2Metrics.h"
+
+#include <mutex>
+#include <algorithm>
+#include <cstdio>
+
+#ifdef SHA2_METRICS
+// Counters of all families of one thread
+struct Sha2ThreadMetrics
+{
+    Sha2ThreadCounters families[2];
+
+    Sha2ThreadMetrics() noexcept;
+    ~Sha2ThreadMetrics();
+};
+
+// Counters of all living threads and the sums of the counters of the finished threads
+struct Sha2MetricsRegistry
+{
+    std::mutex mutex;
+    std::vector<const Sha2ThreadMetrics*> threads;
+    Sha2FamilyMetrics finished[2];
+
+    // Sums at the last reset, they are subtracted from the snapshots
+    Sha2FamilyMetrics baseline[2];
+};
+
+/**
+    \brief Function for getting the registry of the thread counters
+
+    The registry is never destroyed, so the threads finishing after the end of main can still fold their counters into it
+
+    \return the registry
+*/
+static Sha2MetricsRegistry& GetRegistry() noexcept
+{
+    static Sha2MetricsRegistry* registry = new Sha2MetricsRegistry;
+    return *registry;
+}
+
+/**
+    \brief Function for adding the counters of a thread to the sums
+
+    \param [in] counters the counters of the thread
+    \param [in, out] sums the sums of the counters
+*/
+static void AddThreadCounters(const Sha2ThreadCounters& counters, Sha2FamilyMetrics& sums) noexcept
+{
+    sums.bytesCount += counters.bytesCount.load(std::memory_order_relaxed);
+    sums.blocksCount += counters.blocksCount.load(std::memory_order_relaxed);
+    sums.callsCount += counters.callsCount.load(std::memory_order_relaxed);
+    sums.callsBytes += counters.callsBytes.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < 9; ++i)
+        sums.callsBySize[i] += counters.callsBySize[i].load(std::memory_order_relaxed);
+
+    sums.latencySamplesCount += counters.latencySamplesCount.load(std::memory_order_relaxed);
+    sums.latencySum += counters.latencySum.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < 13; ++i)
+        sums.latencyBuckets[i] += counters.latencyBuckets[i].load(std::memory_order_relaxed);
+
+    sums.fileReadTime += counters.fileReadTime.load(std::memory_order_relaxed);
+    sums.fileHashTime += counters.fileHashTime.load(std::memory_order_relaxed);
+}
+
+/**
+    \brief Function for subtracting the counters at the last reset
+
+    \param [in] baseline the counters at the last reset
+    \param [in, out] sums the sums of the counters
+*/
+static void SubtractBaseline(const Sha2FamilyMetrics& baseline, Sha2FamilyMetrics& sums) noexcept
+{
+    sums.bytesCount -= baseline.bytesCount;
+    sums.blocksCount -= baseline.blocksCount;
+    sums.callsCount -= baseline.callsCount;
+    sums.callsBytes -= baseline.callsBytes;
+    for (std::size_t i = 0; i < 9; ++i)
+        sums.callsBySize[i] -= baseline.callsBySize[i];
+
+    sums.latencySamplesCount -= baseline.latencySamplesCount;
+    sums.latencySum -= baseline.latencySum;
+    for (std::size_t i = 0; i < 13; ++i)
+        sums.latencyBuckets[i] -= baseline.latencyBuckets[i];
+
+    sums.fileReadTime -= baseline.fileReadTime;
+    sums.fileHashTime -= baseline.fileHashTime;
+}
+
+/**
+    \brief Function for summing the counters of all threads. The registry must be locked
+
+    \param [in] registry the registry of the thread counters
+    \param [out] sums the sums of the counters of both families
+*/
+static void SumCounters(const Sha2MetricsRegistry& registry, Sha2FamilyMetrics* sums) noexcept
+{
+    for (std::size_t family = 0; family < 2; ++family)
+    {
+        sums[family] = registry.finished[family];
+        for (const Sha2ThreadMetrics* thread : registry.threads)
+            AddThreadCounters(thread->families[family], sums[family]);
+    }
+}
+
+Sha2ThreadMetrics::Sha2ThreadMetrics() noexcept
+{
+    Sha2MetricsRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    // If the registry can not grow, the counters of the thread are missed by the snapshots until the thread finishes
+    try
+    {
+        registry.threads.push_back(this);
+    }
+    catch (...)
+    {
+    }
+}
+
+Sha2ThreadMetrics::~Sha2ThreadMetrics()
+{
+    Sha2MetricsRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    // Keep the counters of the finished thread
+    for (std::size_t family = 0; family < 2; ++family)
+        AddThreadCounters(families[family], registry.finished[family]);
+
+    auto thread = std::find(registry.threads.begin(), registry.threads.end(), this);
+    if (thread != registry.threads.end())
+        registry.threads.erase(thread);
+}
+
+Sha2ThreadCounters& GetThreadCounters(const Sha2MetricsFamily& family) noexcept
+{
+    thread_local Sha2ThreadMetrics metrics;
+    return metrics.families[static_cast<int>(family)];
+}
+#endif // SHA2_METRICS
+
+Sha2Metrics GetSha2Metrics() noexcept
+{
+    Sha2Metrics res;
+
+#ifdef SHA2_METRICS
+    res.isEnabled = true;
+
+    Sha2MetricsRegistry& registry = GetRegistry();
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        Sha2FamilyMetrics sums[2];
+        SumCounters(registry, sums);
+        SubtractBaseline(registry.baseline[0], sums[0]);
+        SubtractBaseline(registry.baseline[1], sums[1]);
+
+        res.sha256 = sums[0];
+        res.sha512 = sums[1];
+    }
+#endif // SHA2_METRICS
+
+    res.sha256.singleKernel = Sha256SingleKernelName();
+    res.sha256.batchKernel = Sha256BatchKernelName();
+    res.sha512.singleKernel = Sha512SingleKernelName();
+    res.sha512.batchKernel = Sha512BatchKernelName();
+    return res;
+}
+
+void ResetSha2Metrics() noexcept
+{
+#ifdef SHA2_METRICS
+    // The counters are written without read-modify-write by their threads, so they are not zeroed but remembered
+    Sha2MetricsRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    SumCounters(registry, registry.baseline);
+#endif // SHA2_METRICS
+}
+
+/**
+    \brief Function for writing a counter of both families in the Prometheus text format
+
+    \param [in, out] res the metrics text
+    \param [in] name name of the metric
+    \param [in] help description of the metric
+    \param [in] sha256 value of the sha256 family
+    \param [in] sha512 value of the sha512 family
+*/
+static void ExportCounter(std::string& res, const std::string& name, const std::string& help, const std::string& sha256, const std::string& sha512)
+{
+    res += "# HELP " + name + " " + help + "\n";
+    res += "# TYPE " + name + " counter\n";
+    res += name + "{family=\"sha256\"} " + sha256 + "\n";
+    res += name + "{family=\"sha512\"} " + sha512 + "\n";
+}
+
+/**
+    \brief Function for converting nanoseconds to seconds in text form
+
+    \param [in] nanoseconds the time in nanoseconds
+
+    \return the time in seconds
+*/
+static std::string NanosecondsToSeconds(const std::uint64_t& nanoseconds)
+{
+    char res[32];
+    snprintf(res, sizeof(res), "%.9g", static_cast<double>(nanoseconds) / 1e9);
+    return res;
+}
+
+/**
+    \brief Function for writing the histogram of one family in the Prometheus text format
+
+    \param [in, out] res the metrics text
+    \param [in] name name of the metric
+    \param [in] family name of the family
+    \param [in] bounds upper bounds of the buckets as text, the last bucket has no bound
+    \param [in] counts number of values in every bucket
+    \param [in] bucketsCount number of the buckets
+    \param [in] sum sum of the values as text
+*/
+static void ExportHistogram(std::string& res, const std::string& name, const std::string& family, const std::string* bounds, const std::uint64_t* counts, const std::size_t& bucketsCount, const std::string& sum)
+{
+    // The buckets of the Prometheus histograms are cumulative
+    std::uint64_t count = 0;
+    for (std::size_t i = 0; i < bucketsCount; ++i)
+    {
+        count += counts[i];
+        res += name + "_bucket{family=\"" + family + "\",le=\"" + (i + 1 < bucketsCount ? bounds[i] : "+Inf") + "\"} " + std::to_string(count) + "\n";
+    }
+
+    res += name + "_sum{family=\"" + family + "\"} " + sum + "\n";
+    res += name + "_count{family=\"" + family + "\"} " + std::to_string(count) + "\n";
+}
+
+std::string ExportSha2Metrics()
+{
+    Sha2Metrics metrics = GetSha2Metrics();
+    const Sha2FamilyMetrics* families[2] = { &metrics.sha256, &metrics.sha512 };
+    const char* names[2] = { "sha256", "sha512" };
+    std::string res;
+
+    res += "# HELP sha2_metrics_enabled Whether the library was built with the hashing metrics\n";
+    res += "# TYPE sha2_metrics_enabled gauge\n";
+    res += std::string("sha2_metrics_enabled ") + (metrics.isEnabled ? "1" : "0") + "\n";
+
+    res += "# HELP sha2_kernel_info Kernels selected for single messages and for batches of messages\n";
+    res += "# TYPE sha2_kernel_info gauge\n";
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        res += std::string("sha2_kernel_info{family=\"") + names[i] + "\",path=\"single\",kernel=\"" + families[i]->singleKernel + "\"} 1\n";
+        res += std::string("sha2_kernel_info{family=\"") + names[i] + "\",path=\"batch\",kernel=\"" + families[i]->batchKernel + "\"} 1\n";
+    }
+
+    ExportCounter(res, "sha2_hashed_bytes_total", "Bytes of the hashed messages", std::to_string(metrics.sha256.bytesCount), std::to_string(metrics.sha512.bytesCount));
+    ExportCounter(res, "sha2_compressed_blocks_total", "Blocks compressed by the kernels including the padding blocks", std::to_string(metrics.sha256.blocksCount), std::to_string(metrics.sha512.blocksCount));
+    ExportCounter(res, "sha2_file_read_seconds_total", "Time of the file hashing spent in waiting for the reads", NanosecondsToSeconds(metrics.sha256.fileReadTime), NanosecondsToSeconds(metrics.sha512.fileReadTime));
+    ExportCounter(res, "sha2_file_hash_seconds_total", "Time of the file hashing spent in the hashing", NanosecondsToSeconds(metrics.sha256.fileHashTime), NanosecondsToSeconds(metrics.sha512.fileHashTime));
+
+    // Bounds of the histograms in the units of the metrics
+    std::string sizeBounds[8], latencyBounds[12];
+    for (std::size_t i = 0; i < 8; ++i)
+        sizeBounds[i] = std::to_string(Sha2SizeBuckets[i]);
+    for (std::size_t i = 0; i < 12; ++i)
+        latencyBounds[i] = NanosecondsToSeconds(Sha2LatencyBuckets[i]);
+
+    res += "# HELP sha2_message_size_bytes Message sizes of the one-shot hashing calls\n";
+    res += "# TYPE sha2_message_size_bytes histogram\n";
+    for (std::size_t i = 0; i < 2; ++i)
+        ExportHistogram(res, "sha2_message_size_bytes", names[i], sizeBounds, families[i]->callsBySize, 9, std::to_string(families[i]->callsBytes));
+
+    res += "# HELP sha2_call_duration_seconds Latencies of the sampled one-shot hashing calls\n";
+    res += "# TYPE sha2_call_duration_seconds histogram\n";
+    for (std::size_t i = 0; i < 2; ++i)
+        ExportHistogram(res, "sha2_call_duration_seconds", names[i], latencyBounds, families[i]->latencyBuckets, 13, NanosecondsToSeconds(families[i]->latencySum));
+
+    return res;
+}
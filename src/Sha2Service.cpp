@@ -0,0 +1,371 @@
+#include "Sha2Service.h"
+
+#include <algorithm>
+
+// Maximum number of small jobs hashed in one batch
+static constexpr std::size_t MaxBatchSize = 16;
+
+// Begin hash values of the algorithms by their indices in the jobs
+static const std::uint32_t Sha256BeginHashes[2][8] = {
+    { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 },
+    { 0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4 }
+};
+static const std::uint64_t Sha512BeginHashes[4][8] = {
+    { 0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1, 0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179 },
+    { 0xcbbb9d5dc1059ed8, 0x629a292a367cd507, 0x9159015a3070dd17, 0x152fecd8f70e5939, 0x67332667ffc00b31, 0x8eb44a8768581511, 0xdb0c2e0d64f98fa7, 0x47b5481dbefa4fa4 },
+    { 0x8c3d37c819544da2, 0x73e1996689dcd4d6, 0x1dfab7ae32ff9c82, 0x679dd514582f9fcf, 0x0f6d2b697bd44da8, 0x77e36f7304c48942, 0x3f9d85a86a1d36c8, 0x1112e6ad91d692a1 },
+    { 0x22312194fc2bf72c, 0x9f555fa3c84c64c2, 0x2393b86b6f53b151, 0x963877195940eabd, 0x96283ee2a88effe3, 0xbe5e1e2553863992, 0x2b0199fc2c85b8aa, 0x0eb72ddc81c52ca2 }
+};
+
+// Hash sum lengths of the algorithms by their indices in the jobs
+static const std::size_t DigestLens[6] = { 32, 28, 64, 48, 28, 32 };
+
+/**
+    \brief Function for raising an atomic maximum
+
+    \param [in, out] maximum the atomic maximum
+    \param [in] value the value to compare with
+*/
+static void UpdateMax(std::atomic<std::uint64_t>& maximum, const std::uint64_t& value) noexcept
+{
+    std::uint64_t current = maximum.load(std::memory_order_relaxed);
+    while (current < value && !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed));
+}
+
+/**
+    \brief Function for getting the time passed since a moment in nanoseconds
+
+    \param [in] since the moment
+
+    \return the passed time
+*/
+static std::uint64_t NanosecondsSince(const std::chrono::steady_clock::time_point& since) noexcept
+{
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - since).count());
+}
+
+Sha2Service::Sha2Service(const unsigned int& threadsCount, const std::size_t& queueCapacity, const std::size_t& smallJobSize) :
+    smallJobSize(smallJobSize), smallJobs(queueCapacity), largeJobs(queueCapacity)
+{
+    for (unsigned int i = 0; i < std::max(threadsCount, 1u); ++i)
+        workers.emplace_back(&Sha2Service::Work, this);
+}
+
+Sha2Service::~Sha2Service()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isStopping.store(true);
+    }
+    wakeUp.notify_all();
+
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+void Sha2Service::Complete(Job& job, const HashingResult& result, QueueCounters& counters) noexcept
+{
+    // The latency does not include the time spent in the user callback
+    std::uint64_t latency = NanosecondsSince(job.submitTime);
+
+    // The worker must survive the exceptions of the user callback
+    try
+    {
+        if (job.callback)
+            job.callback(result);
+        else if (job.promise)
+            job.promise->set_value(result);
+    }
+    catch (...)
+    {
+    }
+
+    counters.totalLatency.fetch_add(latency, std::memory_order_relaxed);
+    UpdateMax(counters.maxLatency, latency);
+    counters.completedCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Sha2Service::HashBatch(Job* jobs, const std::size_t& count) noexcept
+{
+    const char* data[MaxBatchSize];
+    std::size_t dataLens[MaxBatchSize];
+    std::size_t indices[MaxBatchSize];
+
+    // Hash the jobs of every algorithm with one batch call
+    for (int algorithm = 0; algorithm < 6; ++algorithm)
+    {
+        std::size_t groupSize = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (jobs[i].algorithm != algorithm)
+                continue;
+
+            indices[groupSize] = i;
+            data[groupSize] = jobs[i].data != nullptr ? jobs[i].data : jobs[i].ownedData.data();
+            dataLens[groupSize] = jobs[i].dataLen;
+            ++groupSize;
+        }
+
+        if (groupSize == 0)
+            continue;
+
+        HashingResult results[MaxBatchSize];
+        if (algorithm < 2)
+        {
+            std::uint32_t hashes[MaxBatchSize * 8];
+            HashSha256Batch(data, dataLens, groupSize, Sha256BeginHashes[algorithm], hashes);
+            for (std::size_t i = 0; i < groupSize; ++i)
+            {
+                const std::uint32_t* h = hashes + i * 8;
+                results[i].digestLen = DigestLens[algorithm];
+                StateToDigest(h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7], results[i].digestLen, results[i].digest.data());
+            }
+        }
+        else
+        {
+            std::uint64_t hashes[MaxBatchSize * 8];
+            HashSha512Batch(data, dataLens, groupSize, Sha512BeginHashes[algorithm - 2], hashes);
+            for (std::size_t i = 0; i < groupSize; ++i)
+            {
+                const std::uint64_t* h = hashes + i * 8;
+                results[i].digestLen = DigestLens[algorithm];
+                StateToDigest(h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7], results[i].digestLen, results[i].digest.data());
+            }
+        }
+
+        for (std::size_t i = 0; i < groupSize; ++i)
+            Complete(jobs[indices[i]], results[i], smallCounters);
+
+        batchesCount.fetch_add(1, std::memory_order_relaxed);
+        batchedJobsCount.fetch_add(groupSize, std::memory_order_relaxed);
+    }
+}
+
+void Sha2Service::Work() noexcept
+{
+    Job jobs[MaxBatchSize];
+    Job largeJob;
+
+    while (true)
+    {
+        // Take the waiting small jobs and hash them in batches
+        std::size_t count = 0;
+        while (count < MaxBatchSize && smallJobs.TryPop(jobs[count]))
+        {
+            std::uint64_t waitTime = NanosecondsSince(jobs[count].submitTime);
+            smallCounters.totalWaitTime.fetch_add(waitTime, std::memory_order_relaxed);
+            UpdateMax(smallCounters.maxWaitTime, waitTime);
+            ++count;
+        }
+
+        if (count > 0)
+        {
+            HashBatch(jobs, count);
+            for (std::size_t i = 0; i < count; ++i)
+                jobs[i] = Job();
+        }
+
+        // Take one large job, so the small jobs are checked again between the large ones
+        bool isLargeJobTaken = largeJobs.TryPop(largeJob);
+        if (isLargeJobTaken)
+        {
+            std::uint64_t waitTime = NanosecondsSince(largeJob.submitTime);
+            largeCounters.totalWaitTime.fetch_add(waitTime, std::memory_order_relaxed);
+            UpdateMax(largeCounters.maxWaitTime, waitTime);
+
+            const char* data = largeJob.data != nullptr ? largeJob.data : largeJob.ownedData.data();
+            HashingResult result;
+            result.digestLen = DigestLens[largeJob.algorithm];
+            if (largeJob.algorithm < 2)
+            {
+                const std::uint32_t* beginHash = Sha256BeginHashes[largeJob.algorithm];
+                std::uint32_t h0 = beginHash[0], h1 = beginHash[1], h2 = beginHash[2], h3 = beginHash[3], h4 = beginHash[4], h5 = beginHash[5], h6 = beginHash[6], h7 = beginHash[7];
+                HashSha256(data, largeJob.dataLen, h0, h1, h2, h3, h4, h5, h6, h7);
+                StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, result.digestLen, result.digest.data());
+            }
+            else
+            {
+                const std::uint64_t* beginHash = Sha512BeginHashes[largeJob.algorithm - 2];
+                std::uint64_t h0 = beginHash[0], h1 = beginHash[1], h2 = beginHash[2], h3 = beginHash[3], h4 = beginHash[4], h5 = beginHash[5], h6 = beginHash[6], h7 = beginHash[7];
+                HashSha512(data, largeJob.dataLen, h0, h1, h2, h3, h4, h5, h6, h7);
+                StateToDigest(h0, h1, h2, h3, h4, h5, h6, h7, result.digestLen, result.digest.data());
+            }
+
+            Complete(largeJob, result, largeCounters);
+            largeJob = Job();
+        }
+
+        if (count > 0 || isLargeJobTaken)
+            continue;
+
+        // Sleep until new jobs are submitted. The fence pairs with the fence in Enqueue,
+        // so either the worker sees the new job or the producer sees the sleeping worker
+        sleepingCount.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this] { return smallJobs.Size() > 0 || largeJobs.Size() > 0 || isStopping.load(); });
+        }
+        sleepingCount.fetch_sub(1);
+
+        if (isStopping.load() && smallJobs.Size() == 0 && largeJobs.Size() == 0)
+            return;
+    }
+}
+
+bool Sha2Service::Enqueue(Job& job, const bool& isBlocking) noexcept
+{
+    bool isSmall = job.dataLen <= smallJobSize;
+    BoundedMpmcQueue<Job>& queue = isSmall ? smallJobs : largeJobs;
+    QueueCounters& counters = isSmall ? smallCounters : largeCounters;
+
+    // Wait for a free place or reject the job
+    job.submitTime = std::chrono::steady_clock::now();
+    while (!queue.TryPush(job))
+    {
+        if (!isBlocking || isStopping.load(std::memory_order_relaxed))
+        {
+            counters.rejectedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    counters.submittedCount.fetch_add(1, std::memory_order_relaxed);
+
+    // Wake up a worker if there are sleeping ones
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepingCount.load(std::memory_order_relaxed) > 0)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        wakeUp.notify_one();
+    }
+
+    return true;
+}
+
+std::future<HashingResult> Sha2Service::Submit(const char* data, const std::size_t& dataLen, const Sha256Variant& variant)
+{
+    Job job;
+    job.data = data;
+    job.dataLen = dataLen;
+    job.algorithm = static_cast<int>(variant);
+
+    std::future<HashingResult> res = job.promise.emplace().get_future();
+    if (!Enqueue(job, true))
+        job.promise->set_value(HashingResult{ {}, 0 });
+
+    return res;
+}
+
+std::future<HashingResult> Sha2Service::Submit(const char* data, const std::size_t& dataLen, const Sha512Variant& variant)
+{
+    Job job;
+    job.data = data;
+    job.dataLen = dataLen;
+    job.algorithm = 2 + static_cast<int>(variant);
+
+    std::future<HashingResult> res = job.promise.emplace().get_future();
+    if (!Enqueue(job, true))
+        job.promise->set_value(HashingResult{ {}, 0 });
+
+    return res;
+}
+
+std::future<HashingResult> Sha2Service::Submit(std::string data, const Sha256Variant& variant)
+{
+    Job job;
+    job.dataLen = data.length();
+    job.ownedData = std::move(data);
+    job.algorithm = static_cast<int>(variant);
+
+    std::future<HashingResult> res = job.promise.emplace().get_future();
+    if (!Enqueue(job, true))
+        job.promise->set_value(HashingResult{ {}, 0 });
+
+    return res;
+}
+
+std::future<HashingResult> Sha2Service::Submit(std::string data, const Sha512Variant& variant)
+{
+    Job job;
+    job.dataLen = data.length();
+    job.ownedData = std::move(data);
+    job.algorithm = 2 + static_cast<int>(variant);
+
+    std::future<HashingResult> res = job.promise.emplace().get_future();
+    if (!Enqueue(job, true))
+        job.promise->set_value(HashingResult{ {}, 0 });
+
+    return res;
+}
+
+bool Sha2Service::Submit(const char* data, const std::size_t& dataLen, const Sha256Variant& variant, const HashingCallback& callback, const bool& isBlocking) noexcept
+{
+    // The job and the copy of the callback are allocated, an allocation failure rejects the job
+    try
+    {
+        Job job;
+        job.data = data;
+        job.dataLen = dataLen;
+        job.algorithm = static_cast<int>(variant);
+        job.callback = callback;
+
+        return Enqueue(job, isBlocking);
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool Sha2Service::Submit(const char* data, const std::size_t& dataLen, const Sha512Variant& variant, const HashingCallback& callback, const bool& isBlocking) noexcept
+{
+    // The job and the copy of the callback are allocated, an allocation failure rejects the job
+    try
+    {
+        Job job;
+        job.data = data;
+        job.dataLen = dataLen;
+        job.algorithm = 2 + static_cast<int>(variant);
+        job.callback = callback;
+
+        return Enqueue(job, isBlocking);
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+/**
+    \brief Function for reading the metrics of a queue
+
+    \param [in] queue the queue
+    \param [in] counters the metrics of the queue
+
+    \return the metrics at some moment during the call
+*/
+template <typename Queue, typename Counters>
+static HashingQueueStats ReadQueueStats(const Queue& queue, const Counters& counters) noexcept
+{
+    HashingQueueStats res;
+    res.submittedCount = counters.submittedCount.load(std::memory_order_relaxed);
+    res.rejectedCount = counters.rejectedCount.load(std::memory_order_relaxed);
+    res.completedCount = counters.completedCount.load(std::memory_order_relaxed);
+    res.depth = queue.Size();
+    res.totalWaitTime = counters.totalWaitTime.load(std::memory_order_relaxed);
+    res.maxWaitTime = counters.maxWaitTime.load(std::memory_order_relaxed);
+    res.totalLatency = counters.totalLatency.load(std::memory_order_relaxed);
+    res.maxLatency = counters.maxLatency.load(std::memory_order_relaxed);
+    return res;
+}
+
+HashingServiceStats Sha2Service::Stats() const noexcept
+{
+    HashingServiceStats res;
+    res.small = ReadQueueStats(smallJobs, smallCounters);
+    res.large = ReadQueueStats(largeJobs, largeCounters);
+    res.batchesCount = batchesCount.load(std::memory_order_relaxed);
+    res.batchedJobsCount = batchedJobsCount.load(std::memory_order_relaxed);
+    return res;
+}
@@ -0,0 +1,82 @@
+// This file is compiled with the instruction set flags for the ARMv8.2 crypto extensions,
+// so it must contain only the kernels, which are called after the runtime check of the processor support
+#include "Sha2Internal.h"
+
+#ifdef SHA2_ARM_KERNELS
+/**
+    \brief Sha512 hashing steps for a run of blocks using the ARMv8.2 crypto extensions
+
+    The state is kept in four vector registers with the AB, CD, EF and GH pairs for the whole run of blocks.
+    Each pair of rounds is processed with sha512h and sha512h2 instructions, after it the roles of the registers are rotated by one,
+    so the registers return to their roles after 8 rounds. The message schedule is computed with sha512su0 and sha512su1
+
+    \param [in] data a pointer to the array to calculate the hash for
+    \param [in] blocksCount the number of 128 byte blocks in data
+    \param [in, out] h0 internal state variable 0
+    \param [in, out] h1 internal state variable 1
+    \param [in, out] h2 internal state variable 2
+    \param [in, out] h3 internal state variable 3
+    \param [in, out] h4 internal state variable 4
+    \param [in, out] h5 internal state variable 5
+    \param [in, out] h6 internal state variable 6
+    \param [in, out] h7 internal state variable 7
+*/
+void Sha512StepsArm(const char* data, const std::size_t& blocksCount, std::uint64_t& h0, std::uint64_t& h1, std::uint64_t& h2, std::uint64_t& h3, std::uint64_t& h4, std::uint64_t& h5, std::uint64_t& h6, std::uint64_t& h7) noexcept
+{
+    // Load state as AB, CD, EF and GH pairs
+    const std::uint64_t state[8] = { h0, h1, h2, h3, h4, h5, h6, h7 };
+    uint64x2_t pairs[4];
+    for (int i = 0; i < 4; ++i)
+        pairs[i] = vld1q_u64(state + (i << 1));
+
+    for (std::size_t block = 0; block < blocksCount; ++block)
+    {
+        const std::uint8_t* blockData = reinterpret_cast<const std::uint8_t*>(data + (block << 7));
+
+        // Save state to add it after 80 rounds
+        uint64x2_t pairsSave[4];
+        for (int i = 0; i < 4; ++i)
+            pairsSave[i] = pairs[i];
+
+        // Last 8 pairs of message words converted from big endian
+        uint64x2_t words[8];
+        for (int i = 0; i < 8; ++i)
+            words[i] = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(blockData + (i << 4))));
+
+        // 40 pairs of rounds
+        #pragma GCC unroll 40
+        for (int i = 0; i < 40; ++i)
+        {
+            // Registers with the state pairs in the current roles
+            uint64x2_t& ab = pairs[(0 - i) & 3];
+            uint64x2_t& cd = pairs[(1 - i) & 3];
+            uint64x2_t& ef = pairs[(2 - i) & 3];
+            uint64x2_t& gh = pairs[(3 - i) & 3];
+
+            // Message words with constants in the order of the rounds added to the GH pair
+            uint64x2_t temp = vaddq_u64(words[i & 7], vld1q_u64(Sha512K + (i << 1)));
+            temp = vaddq_u64(vextq_u64(temp, temp, 1), gh);
+
+            // Calculate the message words of the pair i + 8 in place of the used ones
+            if (i < 32)
+                words[i & 7] = vsha512su1q_u64(vsha512su0q_u64(words[i & 7], words[(i + 1) & 7]), words[(i + 7) & 7], vextq_u64(words[(i + 4) & 7], words[(i + 5) & 7], 1));
+
+            // The first half of both rounds gives the new EF pair, the second half gives the new AB pair in place of GH
+            temp = vsha512hq_u64(temp, vextq_u64(ef, gh, 1), vextq_u64(cd, ef, 1));
+            gh = vsha512h2q_u64(temp, cd, ab);
+            cd = vaddq_u64(cd, temp);
+        }
+
+        // Add saved state
+        for (int i = 0; i < 4; ++i)
+            pairs[i] = vaddq_u64(pairs[i], pairsSave[i]);
+    }
+
+    // Store state back
+    std::uint64_t result[8];
+    for (int i = 0; i < 4; ++i)
+        vst1q_u64(result + (i << 1), pairs[i]);
+    h0 = result[0], h1 = result[1], h2 = result[2], h3 = result[3];
+    h4 = result[4], h5 = result[5], h6 = result[6], h7 = result[7];
+}
+#endif // SHA2_ARM_KERNELS
@@ -0,0 +1,73 @@
+// This file is compiled with the instruction set flags for AVX2,
+// so it must contain only the kernels, which are called after the runtime check of the processor support
+#include "Sha2Internal.h"
+
+#ifdef SHA2_X86_KERNELS
+/**
+    \brief Sha512 hashing step for 4 independent blocks using AVX2
+
+    Each of the 4 lanes of the ymm registers holds the state of a separate message
+
+    \param [in] blocks an array of 4 pointers to the 128 byte blocks to calculate the hash for
+    \param [in, out] state internal state variables of the 4 messages. The state variable i of the lane j is stored in state[i * 4 + j]
+*/
+void Sha512StepAvx2x4(const char* const* blocks, std::uint64_t* state) noexcept
+{
+    // Transposed message words
+    alignas(32) std::uint64_t transposed[16][4];
+    for (int lane = 0; lane < 4; ++lane)
+        for (int i = 0; i < 16; ++i)
+        {
+            memcpy(&transposed[i][lane], blocks[lane] + (i << 3), 8);
+            transposed[i][lane] = __builtin_bswap64(transposed[i][lane]);
+        }
+
+    // Ring buffer with the last 16 message words
+    __m256i words[16];
+    for (int i = 0; i < 16; ++i)
+        words[i] = _mm256_load_si256(reinterpret_cast<const __m256i*>(transposed[i]));
+
+    // Temporary variables
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 4));
+    __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 8));
+    __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 12));
+    __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 16));
+    __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 20));
+    __m256i g = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 24));
+    __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 28));
+
+    // 80 rounds to calculate hash for data blocks
+    __m256i temp1, temp2, w15, w2;
+    #pragma GCC unroll 80
+    for (int i = 0; i < 80; ++i)
+    {
+        // Calculate next message word from the previous 16
+        if (i >= 16)
+        {
+            w15 = words[(i + 1) & 15];
+            w2 = words[(i + 14) & 15];
+            temp1 = _mm256_xor_si256(_mm256_xor_si256(_mm256_or_si256(_mm256_srli_epi64(w15, 1), _mm256_slli_epi64(w15, 63)), _mm256_or_si256(_mm256_srli_epi64(w15, 8), _mm256_slli_epi64(w15, 56))), _mm256_srli_epi64(w15, 7));
+            temp2 = _mm256_xor_si256(_mm256_xor_si256(_mm256_or_si256(_mm256_srli_epi64(w2, 19), _mm256_slli_epi64(w2, 45)), _mm256_or_si256(_mm256_srli_epi64(w2, 61), _mm256_slli_epi64(w2, 3))), _mm256_srli_epi64(w2, 6));
+            words[i & 15] = _mm256_add_epi64(_mm256_add_epi64(words[i & 15], temp1), _mm256_add_epi64(words[(i + 9) & 15], temp2));
+        }
+
+        temp1 = _mm256_xor_si256(_mm256_xor_si256(_mm256_or_si256(_mm256_srli_epi64(e, 14), _mm256_slli_epi64(e, 50)), _mm256_or_si256(_mm256_srli_epi64(e, 18), _mm256_slli_epi64(e, 46))), _mm256_or_si256(_mm256_srli_epi64(e, 41), _mm256_slli_epi64(e, 23)));
+        temp1 = _mm256_add_epi64(_mm256_add_epi64(h, temp1), _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g)));
+        temp1 = _mm256_add_epi64(temp1, _mm256_add_epi64(_mm256_set1_epi64x(Sha512K[i]), words[i & 15]));
+        temp2 = _mm256_xor_si256(_mm256_xor_si256(_mm256_or_si256(_mm256_srli_epi64(a, 28), _mm256_slli_epi64(a, 36)), _mm256_or_si256(_mm256_srli_epi64(a, 34), _mm256_slli_epi64(a, 30))), _mm256_or_si256(_mm256_srli_epi64(a, 39), _mm256_slli_epi64(a, 25)));
+        temp2 = _mm256_add_epi64(temp2, _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b))));
+        h = g; g = f; f = e; e = _mm256_add_epi64(d, temp1); d = c; c = b; b = a; a = _mm256_add_epi64(temp1, temp2);
+    }
+
+    // Add temporary variables to hash
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state), _mm256_add_epi64(a, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state))));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 4), _mm256_add_epi64(b, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 4))));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 8), _mm256_add_epi64(c, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 8))));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 12), _mm256_add_epi64(d, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 12))));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 16), _mm256_add_epi64(e, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 16))));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 20), _mm256_add_epi64(f, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 20))));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 24), _mm256_add_epi64(g, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 24))));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 28), _mm256_add_epi64(h, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 28))));
+}
+#endif // SHA2_X86_KERNELS
@@ -0,0 +1,78 @@
+// This file is compiled with the instruction set flags for AVX-512,
+// so it must contain only the kernels, which are called after the runtime check of the processor support
+#include "Sha2Internal.h"
+
+#ifdef SHA2_X86_KERNELS
+/**
+    \brief Sha512 hashing step for 8 independent blocks using AVX-512
+
+    Each of the 8 lanes of the zmm registers holds the state of a separate message
+
+    \param [in] blocks an array of 8 pointers to the 128 byte blocks to calculate the hash for
+    \param [in, out] state internal state variables of the 8 messages. The state variable i of the lane j is stored in state[i * 8 + j]
+*/
+// Disable false positive warnings from the avx512 headers of some compilers
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+void Sha512StepAvx512x8(const char* const* blocks, std::uint64_t* state) noexcept
+{
+    // Transposed message words
+    alignas(64) std::uint64_t transposed[16][8];
+    for (int lane = 0; lane < 8; ++lane)
+        for (int i = 0; i < 16; ++i)
+        {
+            memcpy(&transposed[i][lane], blocks[lane] + (i << 3), 8);
+            transposed[i][lane] = __builtin_bswap64(transposed[i][lane]);
+        }
+
+    // Ring buffer with the last 16 message words
+    __m512i words[16];
+    for (int i = 0; i < 16; ++i)
+        words[i] = _mm512_load_si512(transposed[i]);
+
+    // Temporary variables
+    __m512i a = _mm512_loadu_si512(state);
+    __m512i b = _mm512_loadu_si512(state + 8);
+    __m512i c = _mm512_loadu_si512(state + 16);
+    __m512i d = _mm512_loadu_si512(state + 24);
+    __m512i e = _mm512_loadu_si512(state + 32);
+    __m512i f = _mm512_loadu_si512(state + 40);
+    __m512i g = _mm512_loadu_si512(state + 48);
+    __m512i h = _mm512_loadu_si512(state + 56);
+
+    // 80 rounds to calculate hash for data blocks
+    // Ternary logic 0x96 is a ^ b ^ c, 0xca is choose and 0xe8 is majority
+    __m512i temp1, temp2, w15, w2;
+    #pragma GCC unroll 80
+    for (int i = 0; i < 80; ++i)
+    {
+        // Calculate next message word from the previous 16
+        if (i >= 16)
+        {
+            w15 = words[(i + 1) & 15];
+            w2 = words[(i + 14) & 15];
+            temp1 = _mm512_ternarylogic_epi64(_mm512_ror_epi64(w15, 1), _mm512_ror_epi64(w15, 8), _mm512_srli_epi64(w15, 7), 0x96);
+            temp2 = _mm512_ternarylogic_epi64(_mm512_ror_epi64(w2, 19), _mm512_ror_epi64(w2, 61), _mm512_srli_epi64(w2, 6), 0x96);
+            words[i & 15] = _mm512_add_epi64(_mm512_add_epi64(words[i & 15], temp1), _mm512_add_epi64(words[(i + 9) & 15], temp2));
+        }
+
+        temp1 = _mm512_ternarylogic_epi64(_mm512_ror_epi64(e, 14), _mm512_ror_epi64(e, 18), _mm512_ror_epi64(e, 41), 0x96);
+        temp1 = _mm512_add_epi64(_mm512_add_epi64(h, temp1), _mm512_ternarylogic_epi64(e, f, g, 0xca));
+        temp1 = _mm512_add_epi64(temp1, _mm512_add_epi64(_mm512_set1_epi64(Sha512K[i]), words[i & 15]));
+        temp2 = _mm512_ternarylogic_epi64(_mm512_ror_epi64(a, 28), _mm512_ror_epi64(a, 34), _mm512_ror_epi64(a, 39), 0x96);
+        temp2 = _mm512_add_epi64(temp2, _mm512_ternarylogic_epi64(a, b, c, 0xe8));
+        h = g; g = f; f = e; e = _mm512_add_epi64(d, temp1); d = c; c = b; b = a; a = _mm512_add_epi64(temp1, temp2);
+    }
+
+    // Add temporary variables to hash
+    _mm512_storeu_si512(state, _mm512_add_epi64(a, _mm512_loadu_si512(state)));
+    _mm512_storeu_si512(state + 8, _mm512_add_epi64(b, _mm512_loadu_si512(state + 8)));
+    _mm512_storeu_si512(state + 16, _mm512_add_epi64(c, _mm512_loadu_si512(state + 16)));
+    _mm512_storeu_si512(state + 24, _mm512_add_epi64(d, _mm512_loadu_si512(state + 24)));
+    _mm512_storeu_si512(state + 32, _mm512_add_epi64(e, _mm512_loadu_si512(state + 32)));
+    _mm512_storeu_si512(state + 40, _mm512_add_epi64(f, _mm512_loadu_si512(state + 40)));
+    _mm512_storeu_si512(state + 48, _mm512_add_epi64(g, _mm512_loadu_si512(state + 48)));
+    _mm512_storeu_si512(state + 56, _mm512_add_epi64(h, _mm512_loadu_si512(state + 56)));
+}
+#pragma GCC diagnostic pop
+#endif // SHA2_X86_KERNELS
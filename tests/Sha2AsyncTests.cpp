@@ -0,0 +1,141 @@
+#include "Sha2.h"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+
+// Number of the failed checks
+static int FailedChecks = 0;
+
+/// \brief Macro for checking that the actual value is equal to the expected one, the failure is printed and counted
+#define CHECK_EQUAL(actual, ...) CheckEqual((actual), (__VA_ARGS__), #actual, __FILE__, __LINE__)
+
+template <typename Actual, typename Expected>
+void CheckEqual(const Actual& actual, const Expected& expected, const char* expression, const char* file, const int& line)
+{
+    if (actual == expected)
+        return;
+
+    std::cerr << file << ":" << line << ": " << expression << " is not equal to the expected value" << std::endl;
+    ++FailedChecks;
+}
+
+/**
+    \brief A function for generating the deterministic pseudo random test data
+
+    \param [in] len the length of the data
+    \param [in] seed the seed of the generator
+
+    \return the data
+*/
+static std::string TestData(const std::size_t& len, std::uint32_t seed)
+{
+    std::string res(len, '\0');
+    for (std::size_t i = 0; i < len; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;
+        res[i] = static_cast<char>(seed >> 24);
+    }
+
+    return res;
+}
+
+/// \brief Stream buffer which fails the read after giving all of its data
+class FailingBuffer : public std::streambuf
+{
+private:
+    std::string data;
+
+public:
+    FailingBuffer(const std::string& data) : data(data)
+    {
+        setg(&this->data[0], &this->data[0], &this->data[0] + this->data.size());
+    }
+
+protected:
+    int_type underflow() override
+    {
+        throw std::runtime_error("read failure");
+    }
+};
+
+/// \brief Coroutine awaiting the hash sums of both families of the same stream data
+static Sha2Task<std::string> HashBothFamilies(std::string data, Sha2Executor executor)
+{
+    std::istringstream sha256Stream(data), sha512Stream(data);
+    std::string sha256 = co_await AsyncStreamSha256(sha256Stream, executor, Sha256Variant::Sha256, 4096);
+    std::string sha512 = co_await AsyncStreamSha512(sha512Stream, executor, Sha512Variant::Sha512, 4096);
+    co_return sha256 + sha512;
+}
+
+int main()
+{
+    const std::string data = TestData(100000, 2020);
+
+    // step 1. Awaiting without an executor completes inside the Start method
+    std::string res;
+    HashBothFamilies(data, {}).Start([&res](std::string hash) { res = std::move(hash); });
+    CHECK_EQUAL(res, Sha256(data) + Sha512(data));
+
+    // step 2. The deferring executor resumes the coroutines from the queue of the caller
+    std::deque<std::coroutine_handle<>> queue;
+    std::size_t resumesCount = 0;
+    res.clear();
+    HashBothFamilies(data, [&queue](std::coroutine_handle<> handle) { queue.push_back(handle); }).Start([&res](std::string hash) { res = std::move(hash); });
+    CHECK_EQUAL(res.empty(), true);
+    while (!queue.empty())
+    {
+        std::coroutine_handle<> handle = queue.front();
+        queue.pop_front();
+        handle.resume();
+        ++resumesCount;
+    }
+    CHECK_EQUAL(res, Sha256(data) + Sha512(data));
+    CHECK_EQUAL(resumesCount > 10, true);
+
+    // step 3. The executor resuming inline does not nest a call for every chunk, the stream has 200000 chunks
+    const std::string longData = TestData(64 * 200000, 2021);
+    std::istringstream longStream(longData);
+    res.clear();
+    AsyncStreamSha256(longStream, [](std::coroutine_handle<> handle) { handle.resume(); }, Sha256Variant::Sha256, 64).Start([&res](std::string hash) { res = std::move(hash); });
+    CHECK_EQUAL(res, Sha256(longData));
+
+    // step 4. Read errors give empty hash sums instead of the hash sums of the data read before them
+    FailingBuffer sha256Buffer(data), sha512Buffer(data);
+    std::istream sha256Stream(&sha256Buffer), sha512Stream(&sha512Buffer);
+    res = "not empty";
+    AsyncStreamSha256(sha256Stream, [](std::coroutine_handle<> handle) { handle.resume(); }, Sha256Variant::Sha256, 4096).Start([&res](std::string hash) { res = std::move(hash); });
+    CHECK_EQUAL(res, "");
+    res = "not empty";
+    AsyncStreamSha512(sha512Stream, {}, Sha512Variant::Sha512, 4096).Start([&res](std::string hash) { res = std::move(hash); });
+    CHECK_EQUAL(res, "");
+
+    // step 5. Files
+    const std::string fileName = "sha2_async_tests_file.bin";
+    {
+        std::ofstream file(fileName, std::ios::binary);
+        file.write(data.data(), data.size());
+    }
+    res.clear();
+    AsyncFileSha512(fileName, {}, Sha512Variant::Sha384).Start([&res](std::string hash) { res = std::move(hash); });
+    CHECK_EQUAL(res, Sha384(data));
+    std::remove(fileName.c_str());
+
+    res = "not empty";
+    AsyncFileSha256(fileName).Start([&res](std::string hash) { res = std::move(hash); });
+    CHECK_EQUAL(res, "");
+
+    if (FailedChecks > 0)
+    {
+        std::cerr << FailedChecks << " checks failed" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,1265 @@
+#include "Sha2.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <stdexcept>
+#include <chrono>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <time.h>
+#endif // __unix__ || __APPLE__
+
+// Number of the failed checks
+static int FailedChecks = 0;
+
+/// \brief Macro for checking that the actual value is equal to the expected one, the failure is printed and counted. The expected value can contain commas
+#define CHECK_EQUAL(actual, ...) CheckEqual((actual), (__VA_ARGS__), #actual, __FILE__, __LINE__)
+
+template <typename Actual, typename Expected>
+void CheckEqual(const Actual& actual, const Expected& expected, const char* expression, const char* file, const int& line)
+{
+    if (actual == expected)
+        return;
+
+    std::cerr << file << ":" << line << ": " << expression << " is not equal to the expected value" << std::endl;
+    ++FailedChecks;
+}
+
+/// \brief Known answer vector of all algorithms for the same message
+struct KnownAnswer
+{
+    std::string message;
+    const char* sha224;
+    const char* sha256;
+    const char* sha384;
+    const char* sha512;
+    const char* sha512_224;
+    const char* sha512_256;
+};
+
+/// \brief A function for getting the FIPS 180-4 known answer vectors, the hash sums were calculated with a reference implementation
+static std::vector<KnownAnswer> KnownAnswers()
+{
+    return {
+        { "",
+          "d14a028c2a3a2bc9476102bb288234c415a2b01f828ea62ac5b3e42f",
+          "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+          "38b060a751ac96384cd9327eb1b1e36a21fdb71114be07434c0cc7bf63f6e1da274edebfe76f65fbd51ad2f14898b95b",
+          "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e",
+          "6ed0dd02806fa89e25de060c19d3ac86cabb87d6a0ddd05c333b84f4",
+          "c672b8d1ef56ed28ab87c3622c5114069bdd3ad7b8f9737498d0c01ecef0967a" },
+        { "abc",
+          "23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7",
+          "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+          "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed8086072ba1e7cc2358baeca134c825a7",
+          "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f",
+          "4634270f707b6a54daae7530460842e20e37ed265ceee9a43e8924aa",
+          "53048e2681941ef99b2e29b76b4c7dabe4c2d0c634fc6d46e0e2f13107e7af23" },
+        { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+          "75388b16512776cc5dba5da1fd890150b0c6455cb4f58b1952522525",
+          "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+          "3391fdddfc8dc7393707a65b1b4709397cf8b1d162af05abfe8f450de5f36bc6b0455a8520bc4e6f5fe95b1fe3c8452b",
+          "204a8fc6dda82f0a0ced7beb8e08a41657c16ef468b228a8279be331a703c33596fd15c13b1b07f9aa1d3bea57789ca031ad85c7a71dd70354ec631238ca3445",
+          "e5302d6d54bb242275d1e7622d68df6eb02dedd13f564c13dbda2174",
+          "bde8e1f9f19bb9fd3406c90ec6bc47bd36d8ada9f11880dbc8a22a7078b6a461" },
+        { "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+          "c97ca9a559850ce97a04a96def6d99a9e0e0e2ab14e6b8df265fc0b3",
+          "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1",
+          "09330c33f71147e83d192fc782cd1b4753111b173b3b05d22fa08086e3b0f712fcc7c71a557e2db966c3e9fa91746039",
+          "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909",
+          "23fec5bb94d60b23308192640b0c453335d664734fe40e7268674af9",
+          "3928e184fb8690f840da3988121d31be65cb9d3ef83ee6146feac861e19b563a" },
+        { std::string(1000000, 'a'),
+          "20794655980c91d8bbb4c1ea97618a4bf03f42581948b2ee4ee7ad67",
+          "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0",
+          "9d0e1809716474cb086e834e310a4a1ced149e9c00f248527972cec5704c2a5b07b8b3dc38ecc4ebae97ddd87f3d8985",
+          "e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973ebde0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b",
+          "37ab331d76f0d36de422bd0edeb22a28accd487b7a8453ae965dd287",
+          "9a59a052930187a97038cae692f30708aa6491923ef5194394dc68d56c74fb21" },
+    };
+}
+
+/**
+    \brief A function for generating the deterministic pseudo random test data
+
+    \param [in] len the length of the data
+    \param [in] seed the seed of the generator
+
+    \return the data
+*/
+static std::string TestData(const std::size_t& len, std::uint32_t seed)
+{
+    std::string res(len, '\0');
+    for (std::size_t i = 0; i < len; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;
+        res[i] = static_cast<char>(seed >> 24);
+    }
+
+    return res;
+}
+
+/**
+    \brief A function for generating the messages for the kernels checks
+
+    Every length from 0 to 300 bytes crosses the padding boundaries of both families, the longer messages make the lanes finish at different blocks
+
+    \return the messages
+*/
+static std::vector<std::string> KernelMessages()
+{
+    std::vector<std::string> res;
+    for (std::size_t len = 0; len <= 300; ++len)
+        res.push_back(TestData(len, static_cast<std::uint32_t>(len)));
+
+    for (const std::size_t len : { 1000, 4095, 4096, 65537 })
+        res.push_back(TestData(len, static_cast<std::uint32_t>(len)));
+
+    return res;
+}
+
+/// \brief Checking the one-shot, incremental and constexpr hashing against the known answer vectors
+static void TestKnownAnswers()
+{
+    for (const KnownAnswer& answer : KnownAnswers())
+    {
+        CHECK_EQUAL(Sha224(answer.message), answer.sha224);
+        CHECK_EQUAL(Sha256(answer.message), answer.sha256);
+        CHECK_EQUAL(Sha384(answer.message), answer.sha384);
+        CHECK_EQUAL(Sha512(answer.message), answer.sha512);
+        CHECK_EQUAL(Sha512_224(answer.message), answer.sha512_224);
+        CHECK_EQUAL(Sha512_256(answer.message), answer.sha512_256);
+
+        // Data passed to the contexts in parts of different lengths
+        Sha256Context sha224Context(Sha256Variant::Sha224), sha256Context;
+        Sha512Context sha384Context(Sha512Variant::Sha384), sha512Context, sha512_224Context(Sha512Variant::Sha512_224), sha512_256Context(Sha512Variant::Sha512_256);
+        for (std::size_t offset = 0, partLen = 1; offset < answer.message.size(); offset += partLen, partLen = partLen * 3 % 257 + 1)
+        {
+            const std::size_t len = std::min(partLen, answer.message.size() - offset);
+            sha224Context.Update(answer.message.data() + offset, len);
+            sha256Context.Update(answer.message.data() + offset, len);
+            sha384Context.Update(answer.message.data() + offset, len);
+            sha512Context.Update(answer.message.data() + offset, len);
+            sha512_224Context.Update(answer.message.data() + offset, len);
+            sha512_256Context.Update(answer.message.data() + offset, len);
+        }
+
+        CHECK_EQUAL(sha224Context.Final(), answer.sha224);
+        CHECK_EQUAL(sha256Context.Final(), answer.sha256);
+        CHECK_EQUAL(sha384Context.Final(), answer.sha384);
+        CHECK_EQUAL(sha512Context.Final(), answer.sha512);
+        CHECK_EQUAL(sha512_224Context.Final(), answer.sha512_224);
+        CHECK_EQUAL(sha512_256Context.Final(), answer.sha512_256);
+    }
+
+    // Hash sums calculated at compile time
+    constexpr Sha256Digest sha256Digest = ConstexprSha256("abc");
+    constexpr Sha512Digest sha512Digest = ConstexprSha512("abc");
+    CHECK_EQUAL(DigestToHex(sha256Digest), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    CHECK_EQUAL(DigestToHex(sha512Digest), "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+    CHECK_EQUAL(DigestToHex(ConstexprSha224("abc")), "23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7");
+    CHECK_EQUAL(DigestToHex(ConstexprSha384("abc")), "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed8086072ba1e7cc2358baeca134c825a7");
+    CHECK_EQUAL(DigestToHex(ConstexprSha512_224("abc")), "4634270f707b6a54daae7530460842e20e37ed265ceee9a43e8924aa");
+    CHECK_EQUAL(DigestToHex(ConstexprSha512_256("abc")), "53048e2681941ef99b2e29b76b4c7dabe4c2d0c634fc6d46e0e2f13107e7af23");
+}
+
+/// \brief Checking every kernel supported by the processor and the batch dispatch against the portable scalar kernel
+static void TestKernels()
+{
+    // step 1. Message pointers and lengths
+    const std::vector<std::string> messages = KernelMessages();
+    std::vector<const char*> data;
+    std::vector<std::size_t> dataLens;
+    for (const std::string& message : messages)
+    {
+        data.push_back(message.data());
+        dataLens.push_back(message.size());
+    }
+
+    // The number of messages is odd, so it is not a multiple of the lanes count of any kernel
+    const std::size_t count = messages.size();
+
+    // step 2. Sha256 kernels
+    const std::uint32_t sha256BeginHash[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+    const std::vector<Sha256Kernel> sha256Kernels = GetSha256Kernels();
+    std::vector<std::uint32_t> sha256Expected(count * 8);
+    sha256Kernels[0].hash(data.data(), dataLens.data(), count, sha256BeginHash, sha256Expected.data());
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::uint32_t h[8];
+        memcpy(h, sha256BeginHash, sizeof(h));
+        HashSha256(data[i], dataLens[i], h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7]);
+        CHECK_EQUAL(std::vector<std::uint32_t>(h, h + 8), std::vector<std::uint32_t>(sha256Expected.begin() + i * 8, sha256Expected.begin() + i * 8 + 8));
+    }
+
+    for (const Sha256Kernel& kernel : sha256Kernels)
+    {
+        std::vector<std::uint32_t> hashes(count * 8);
+        kernel.hash(data.data(), dataLens.data(), count, sha256BeginHash, hashes.data());
+        if (hashes != sha256Expected)
+            std::cerr << "sha256 kernel " << kernel.name << " failed" << std::endl;
+        CHECK_EQUAL(hashes, sha256Expected);
+    }
+
+    std::vector<std::uint32_t> sha256BatchHashes(count * 8);
+    HashSha256Batch(data.data(), dataLens.data(), count, sha256BeginHash, sha256BatchHashes.data());
+    CHECK_EQUAL(sha256BatchHashes, sha256Expected);
+
+    // step 3. Sha512 kernels
+    const std::uint64_t sha512BeginHash[8] = { 0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1, 0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179 };
+    const std::vector<Sha512Kernel> sha512Kernels = GetSha512Kernels();
+    std::vector<std::uint64_t> sha512Expected(count * 8);
+    sha512Kernels[0].hash(data.data(), dataLens.data(), count, sha512BeginHash, sha512Expected.data());
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::uint64_t h[8];
+        memcpy(h, sha512BeginHash, sizeof(h));
+        HashSha512(data[i], dataLens[i], h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7]);
+        CHECK_EQUAL(std::vector<std::uint64_t>(h, h + 8), std::vector<std::uint64_t>(sha512Expected.begin() + i * 8, sha512Expected.begin() + i * 8 + 8));
+    }
+
+    for (const Sha512Kernel& kernel : sha512Kernels)
+    {
+        std::vector<std::uint64_t> hashes(count * 8);
+        kernel.hash(data.data(), dataLens.data(), count, sha512BeginHash, hashes.data());
+        if (hashes != sha512Expected)
+            std::cerr << "sha512 kernel " << kernel.name << " failed" << std::endl;
+        CHECK_EQUAL(hashes, sha512Expected);
+    }
+
+    std::vector<std::uint64_t> sha512BatchHashes(count * 8);
+    HashSha512Batch(data.data(), dataLens.data(), count, sha512BeginHash, sha512BatchHashes.data());
+    CHECK_EQUAL(sha512BatchHashes, sha512Expected);
+
+    // step 4. String batches against the single message functions
+    const std::vector<std::string> sha256Batch = Sha256Batch(messages), sha224Batch = Sha224Batch(messages);
+    const std::vector<std::string> sha512Batch = Sha512Batch(messages), sha384Batch = Sha384Batch(messages);
+    const std::vector<std::string> sha512_224Batch = Sha512_224Batch(messages), sha512_256Batch = Sha512_256Batch(messages);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        CHECK_EQUAL(sha256Batch[i], Sha256(messages[i]));
+        CHECK_EQUAL(sha224Batch[i], Sha224(messages[i]));
+        CHECK_EQUAL(sha512Batch[i], Sha512(messages[i]));
+        CHECK_EQUAL(sha384Batch[i], Sha384(messages[i]));
+        CHECK_EQUAL(sha512_224Batch[i], Sha512_224(messages[i]));
+        CHECK_EQUAL(sha512_256Batch[i], Sha512_256(messages[i]));
+    }
+}
+
+/// \brief Checking the hmac functions against the RFC 4231 test cases 2 and 6
+static void TestHmac()
+{
+    const std::string key2 = "Jefe", data2 = "what do ya want for nothing?";
+    CHECK_EQUAL(HmacSha224(key2, data2), "a30e01098bc6dbbf45690f3a7e9e6d0f8bbea2a39e6148008fd05e44");
+    CHECK_EQUAL(HmacSha256(key2, data2), "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+    CHECK_EQUAL(HmacSha384(key2, data2), "af45d2e376484031617f78d2b58a6b1b9c7ef464f5a01b47e42ec3736322445e8e2240ca5e69e2c78b3239ecfab21649");
+    CHECK_EQUAL(HmacSha512(key2, data2), "164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea2505549758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737");
+    CHECK_EQUAL(HmacSha512_224(key2, data2), "4a530b31a79ebcce36916546317c45f247d83241dfb818fd37254bde");
+    CHECK_EQUAL(HmacSha512_256(key2, data2), "6df7b24630d5ccb2ee335407081a87188c221489768fa2020513b2d593359456");
+
+    // The key is longer than the block of both families
+    const std::string key6(131, '\xaa'), data6 = "Test Using Larger Than Block-Size Key - Hash Key First";
+    CHECK_EQUAL(HmacSha224(key6, data6), "95e9a0db962095adaebe9b2d6f0dbce2d499f112f2d2b7273fa6870e");
+    CHECK_EQUAL(HmacSha256(key6, data6), "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54");
+    CHECK_EQUAL(HmacSha384(key6, data6), "4ece084485813e9088d2c63a041bc5b44f9ef1012a2b588f3cd11f05033ac4c60c2ef6ab4030fe8296248df163f44952");
+    CHECK_EQUAL(HmacSha512(key6, data6), "80b24263c7c1a3ebb71493c1dd7be8b49b46d1f41b4aeec1121b013783f8f3526b56d037e05f2598bd0fd2215d6a1e5295e64f73f63f0aec8b915a985d786598");
+    CHECK_EQUAL(HmacSha512_224(key6, data6), "29bef8ce88b54d4226c3c7718ea9e32ace2429026f089e38cea9aeda");
+    CHECK_EQUAL(HmacSha512_256(key6, data6), "87123c45f7c537a404f8f47cdbedda1fc9bec60eeb971982ce7ef10e774e6539");
+}
+
+/// \brief Checking the pbkdf2 functions against the known answer vectors and the batch functions against the single password ones
+static void TestPbkdf2()
+{
+    CHECK_EQUAL(Pbkdf2HmacSha256("password", "salt", 4096, 40), "c5e478d59288c841aa530db6845c4c8d962893a001ce4e11a4963873aa98134af7ad98c1b458ce3f");
+    CHECK_EQUAL(Pbkdf2HmacSha512("password", "salt", 4096, 40), "d197b1b33db0143e018b12f3d1d1479e6cdebdcc97c5c0f87f6902e072f457b5143f30602641b3d5");
+    CHECK_EQUAL(Pbkdf2HmacSha256("passwordPASSWORDpassword", "saltSALTsaltSALTsaltSALTsaltSALTsalt", 1000, 80), "4610df202292270a7613e4723f6e8d1e513fb62caba8fb8a0168293411f2896cc4daad9e2b12273c5a47e8e735d3aa03e1f5d105b6f6346dcc0c828d599378e4e7eb005f09c785a3e7b516d42d3277ba");
+    CHECK_EQUAL(Pbkdf2HmacSha512("passwordPASSWORDpassword", "saltSALTsaltSALTsaltSALTsaltSALTsalt", 1000, 80), "0e28f3efa802a2f0cd3b4ace5e3d9afadb7c2dccc5ef10eedb8a6564dfb0c9a63b6f46b1e150587b9fe7875cfaf999d00b454bb7d74295c60df1bbe5f8f36da188271db22110efda5cc9eeafb0ab2969");
+
+    // Passwords of different lengths, the number is not a multiple of the lanes count
+    std::vector<std::string> passwords;
+    for (std::size_t i = 0; i < 37; ++i)
+        passwords.push_back(TestData(i * 7 % 150, static_cast<std::uint32_t>(i)));
+
+    const std::vector<std::string> sha256Keys = Pbkdf2HmacSha256Batch(passwords, "salt", 100, 40);
+    const std::vector<std::string> sha512Keys = Pbkdf2HmacSha512Batch(passwords, "salt", 100, 80);
+    CHECK_EQUAL(sha256Keys.size(), passwords.size());
+    CHECK_EQUAL(sha512Keys.size(), passwords.size());
+    for (std::size_t i = 0; i < passwords.size() && i < sha256Keys.size() && i < sha512Keys.size(); ++i)
+    {
+        CHECK_EQUAL(sha256Keys[i], Pbkdf2HmacSha256(passwords[i], "salt", 100, 40));
+        CHECK_EQUAL(sha512Keys[i], Pbkdf2HmacSha512(passwords[i], "salt", 100, 80));
+    }
+
+    // Keys of mixed variants give the same derived keys as the keys derived one by one
+    const Sha512Variant sha512Variants[] = { Sha512Variant::Sha512, Sha512Variant::Sha384, Sha512Variant::Sha512_224, Sha512Variant::Sha512_256 };
+    std::vector<HmacSha256Key> sha256MixedKeys;
+    std::vector<HmacSha512Key> sha512MixedKeys;
+    for (std::size_t i = 0; i < passwords.size(); ++i)
+    {
+        sha256MixedKeys.emplace_back(passwords[i].data(), passwords[i].size(), i % 3 == 0 ? Sha256Variant::Sha224 : Sha256Variant::Sha256);
+        sha512MixedKeys.emplace_back(passwords[i].data(), passwords[i].size(), sha512Variants[i * 7 % 4]);
+    }
+
+    std::vector<std::uint8_t> sha256DerivedKeys(passwords.size() * 70), sha512DerivedKeys(passwords.size() * 150);
+    Pbkdf2Sha256(sha256MixedKeys.data(), sha256MixedKeys.size(), "salt", 4, 50, 70, sha256DerivedKeys.data());
+    Pbkdf2Sha512(sha512MixedKeys.data(), sha512MixedKeys.size(), "salt", 4, 50, 150, sha512DerivedKeys.data());
+    for (std::size_t i = 0; i < passwords.size(); ++i)
+    {
+        std::vector<std::uint8_t> sha256DerivedKey(70), sha512DerivedKey(150);
+        Pbkdf2HmacSha256Binary(passwords[i].data(), passwords[i].size(), "salt", 4, 50, 70, sha256DerivedKey.data(), sha256MixedKeys[i].Variant());
+        Pbkdf2HmacSha512Binary(passwords[i].data(), passwords[i].size(), "salt", 4, 50, 150, sha512DerivedKey.data(), sha512MixedKeys[i].Variant());
+        CHECK_EQUAL(std::vector<std::uint8_t>(sha256DerivedKeys.begin() + i * 70, sha256DerivedKeys.begin() + (i + 1) * 70), sha256DerivedKey);
+        CHECK_EQUAL(std::vector<std::uint8_t>(sha512DerivedKeys.begin() + i * 150, sha512DerivedKeys.begin() + (i + 1) * 150), sha512DerivedKey);
+    }
+}
+
+/// \brief Checking the file hashing with different chunk sizes against the hashing of the same data in memory
+static void TestFiles()
+{
+    // step 1. File which is not a multiple of the page size
+    const std::string data = TestData(3 * 1024 * 1024 + 17, 2024);
+    const std::string fileName = "sha2_tests_file.bin";
+    {
+        std::ofstream file(fileName, std::ios::binary);
+        file.write(data.data(), data.size());
+    }
+
+    // step 2. Mapped or read files
+    for (const std::size_t chunkSize : { 64, 4096, 1000000, CHUNK_SIZE })
+    {
+        CHECK_EQUAL(FileSha256(fileName, chunkSize), Sha256(data));
+        CHECK_EQUAL(FileSha224(fileName, chunkSize), Sha224(data));
+        CHECK_EQUAL(FileSha512(fileName, chunkSize), Sha512(data));
+        CHECK_EQUAL(FileSha384(fileName, chunkSize), Sha384(data));
+    }
+
+    // step 3. Streams
+    std::uint32_t h[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+    std::istringstream stream(data);
+    HashFileSha256(stream, 4096, h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7]);
+    Sha256Digest digest;
+    StateToDigest(h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7], digest.size(), digest.data());
+    CHECK_EQUAL(DigestToHex(digest), Sha256(data));
+
+    // step 4. Tree hashes do not depend on the number of threads
+    const std::string sha256Tree = TreeFileSha256(fileName, 65536, 1), sha512Tree = TreeFileSha512(fileName, 65536, 1);
+    CHECK_EQUAL(sha256Tree.size(), static_cast<std::size_t>(64));
+    CHECK_EQUAL(sha512Tree.size(), static_cast<std::size_t>(128));
+    CHECK_EQUAL(TreeFileSha256(fileName, 65536, 4), sha256Tree);
+    CHECK_EQUAL(TreeFileSha512(fileName, 65536, 4), sha512Tree);
+    CHECK_EQUAL(VerifyTreeFileSha256(fileName, sha256Tree, 65536, 3), true);
+    CHECK_EQUAL(VerifyTreeFileSha512(fileName, sha512Tree, 65536, 3), true);
+    CHECK_EQUAL(VerifyTreeFileSha256(fileName, sha256Tree, 4096, 3), false);
+    std::string upperSha512Tree = sha512Tree;
+    std::transform(upperSha512Tree.begin(), upperSha512Tree.end(), upperSha512Tree.begin(), [](char c) { return static_cast<char>(std::toupper(static_cast<unsigned char>(c))); });
+    CHECK_EQUAL(VerifyTreeFileSha512(fileName, upperSha512Tree, 65536, 2), true);
+
+    // step 5. Pipelined reading of several files, the empty file, the file of whole chunks and the missing file among them
+    const std::string emptyFileName = "sha2_tests_empty.bin", chunksFileName = "sha2_tests_chunks.bin", missingFileName = "sha2_tests_missing.bin";
+    std::ofstream(emptyFileName, std::ios::binary).close();
+    {
+        std::ofstream file(chunksFileName, std::ios::binary);
+        file.write(data.data(), 8 * 4096);
+    }
+    const std::vector<std::string> pipelinedFiles = { fileName, emptyFileName, missingFileName, chunksFileName, fileName };
+    for (const std::size_t chunkSize : { 100, 4096, CHUNK_SIZE })
+    {
+        const std::vector<std::string> sha256Hashes = PipelinedFilesSha256(pipelinedFiles, Sha256Variant::Sha224, chunkSize, 2, 2);
+        const std::vector<std::string> sha512Hashes = PipelinedFilesSha512(pipelinedFiles, Sha512Variant::Sha512, chunkSize, 3, 4);
+        CHECK_EQUAL(sha256Hashes, std::vector<std::string>{ FileSha224(fileName), Sha224(""), "", Sha224(data.substr(0, 8 * 4096)), FileSha224(fileName) });
+        CHECK_EQUAL(sha512Hashes, std::vector<std::string>{ FileSha512(fileName), Sha512(""), "", Sha512(data.substr(0, 8 * 4096)), FileSha512(fileName) });
+        CHECK_EQUAL(PipelinedFileSha256(chunksFileName, chunkSize), FileSha256(chunksFileName));
+        CHECK_EQUAL(PipelinedFileSha512(fileName, chunkSize), Sha512(data));
+    }
+    std::remove(emptyFileName.c_str());
+    std::remove(chunksFileName.c_str());
+
+    // step 6. Missing files
+    std::remove(fileName.c_str());
+    Sha256Digest missingSha256Digest;
+    Sha512Digest missingSha512Digest;
+    CHECK_EQUAL(FileSha256Binary(fileName, missingSha256Digest), false);
+    CHECK_EQUAL(FileSha512Binary(fileName, missingSha512Digest), false);
+
+    // step 7. Directories can be opened as streams, but not read
+    CHECK_EQUAL(FileSha256Binary(".", missingSha256Digest), false);
+    CHECK_EQUAL(FileSha512Binary(".", missingSha512Digest), false);
+}
+
+/**
+    \brief A function for calculating the root of a Merkle tree level by level with the one-shot hash function
+
+    \tparam Digest type of the hash sums
+    \tparam Hash the one-shot hash function
+
+    \param [in] records the records of the leaves
+
+    \return the root
+*/
+template <typename Digest, Digest (*Hash)(const char*, const std::size_t&) noexcept>
+static Digest ReferenceMerkleRoot(const std::vector<std::string>& records)
+{
+    if (records.empty())
+        return Hash("", 0);
+
+    std::vector<Digest> level;
+    for (const std::string& record : records)
+        level.push_back(Hash(record.data(), record.size()));
+
+    while (level.size() > 1)
+    {
+        std::vector<Digest> next;
+        for (std::size_t i = 0; i + 1 < level.size(); i += 2)
+        {
+            std::string children(reinterpret_cast<const char*>(level[i].data()), level[i].size());
+            children.append(reinterpret_cast<const char*>(level[i + 1].data()), level[i + 1].size());
+            next.push_back(Hash(children.data(), children.size()));
+        }
+
+        // The unpaired last node is moved to the next level
+        if (level.size() & 1)
+            next.push_back(level.back());
+        level.swap(next);
+    }
+
+    return level[0];
+}
+
+/**
+    \brief Checking a Merkle tree against the reference root, the updates against the rebuilds and the proofs
+
+    \tparam Tree type of the tree
+    \tparam Digest type of the hash sums
+    \tparam Hash the one-shot hash function
+*/
+template <typename Tree, typename Digest, Digest (*Hash)(const char*, const std::size_t&) noexcept>
+static void TestMerkleTree()
+{
+    for (const std::size_t count : { 0, 1, 2, 3, 4, 5, 7, 16, 17, 33, 1000 })
+    {
+        std::vector<std::string> records;
+        for (std::size_t i = 0; i < count; ++i)
+            records.push_back(TestData(i % 200 + 1, static_cast<std::uint32_t>(count * 1000 + i)));
+
+        // step 1. Trees built by one and by many threads
+        Tree tree, parallelTree;
+        tree.Build(records, 1);
+        parallelTree.Build(records, 4);
+        CHECK_EQUAL(tree.LeavesCount(), count);
+        CHECK_EQUAL(tree.Root(), ReferenceMerkleRoot<Digest, Hash>(records));
+        CHECK_EQUAL(parallelTree.Root(), tree.Root());
+        if (count == 0)
+            continue;
+
+        // step 2. Updated leaf against the rebuilt tree
+        const std::size_t updated = count / 2;
+        records[updated] = "updated record";
+        tree.Update(updated, records[updated]);
+        CHECK_EQUAL(tree.Root(), ReferenceMerkleRoot<Digest, Hash>(records));
+
+        // step 3. Proofs of all leaves, tampered proofs are rejected
+        const Digest root = tree.Root();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto proof = tree.Proof(i);
+            CHECK_EQUAL(Tree::VerifyProof(tree.Leaf(i), proof, count, root), true);
+            CHECK_EQUAL(Tree::VerifyProof(tree.Leaf(i), proof, count + 1, root), false);
+
+            if (!proof.siblings.empty())
+            {
+                auto tampered = proof;
+                tampered.siblings[0][0] ^= 1;
+                CHECK_EQUAL(Tree::VerifyProof(tree.Leaf(i), tampered, count, root), false);
+
+                tampered = proof;
+                tampered.siblings.pop_back();
+                CHECK_EQUAL(Tree::VerifyProof(tree.Leaf(i), tampered, count, root), false);
+            }
+
+            if (count > 1)
+            {
+                auto moved = proof;
+                moved.index = (i + 1) % count;
+                CHECK_EQUAL(Tree::VerifyProof(tree.Leaf(i), moved, count, root), false);
+            }
+        }
+    }
+
+    // step 4. Inner nodes presented as leaves of a smaller tree
+    std::vector<std::string> records = { "a", "b", "c", "d" };
+    Tree tree;
+    tree.Build(records, 1);
+
+    std::string children01(reinterpret_cast<const char*>(tree.Leaf(0).data()), tree.Leaf(0).size());
+    children01.append(reinterpret_cast<const char*>(tree.Leaf(1).data()), tree.Leaf(1).size());
+    std::string children23(reinterpret_cast<const char*>(tree.Leaf(2).data()), tree.Leaf(2).size());
+    children23.append(reinterpret_cast<const char*>(tree.Leaf(3).data()), tree.Leaf(3).size());
+    const Digest node01 = Hash(children01.data(), children01.size()), node23 = Hash(children23.data(), children23.size());
+    std::string children(reinterpret_cast<const char*>(node01.data()), node01.size());
+    children.append(reinterpret_cast<const char*>(node23.data()), node23.size());
+
+    auto singleLeafProof = tree.Proof(0);
+    singleLeafProof.leavesCount = 1;
+    singleLeafProof.siblings.clear();
+    CHECK_EQUAL(Tree::VerifyProof(Hash(children.data(), children.size()), singleLeafProof, 4, tree.Root()), false);
+
+    auto twoLeavesProof = tree.Proof(0);
+    twoLeavesProof.leavesCount = 2;
+    twoLeavesProof.siblings.assign(1, node23);
+    CHECK_EQUAL(Tree::VerifyProof(node01, twoLeavesProof, 4, tree.Root()), false);
+}
+
+/// \brief Checking the Merkle trees and the node hashing functions, the counts of nodes do not fill whole groups of lanes
+static void TestMerkle()
+{
+    TestMerkleTree<MerkleTreeSha256, Sha256Digest, Sha256Binary>();
+    TestMerkleTree<MerkleTreeSha512, Sha512Digest, Sha512Binary>();
+
+    for (std::size_t count = 1; count <= 40; ++count)
+    {
+        const std::string sha256Children = TestData(count * 64, static_cast<std::uint32_t>(count));
+        std::vector<std::uint8_t> sha256Parents(count * 32);
+        HashSha256Nodes(reinterpret_cast<const std::uint8_t*>(sha256Children.data()), count, sha256Parents.data());
+
+        const std::string sha512Children = TestData(count * 128, static_cast<std::uint32_t>(count));
+        std::vector<std::uint8_t> sha512Parents(count * 64);
+        HashSha512Nodes(reinterpret_cast<const std::uint8_t*>(sha512Children.data()), count, sha512Parents.data());
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Sha256Digest sha256Parent = Sha256Binary(sha256Children.data() + i * 64, 64);
+            const Sha512Digest sha512Parent = Sha512Binary(sha512Children.data() + i * 128, 128);
+            CHECK_EQUAL(memcmp(sha256Parents.data() + i * 32, sha256Parent.data(), 32), 0);
+            CHECK_EQUAL(memcmp(sha512Parents.data() + i * 64, sha512Parent.data(), 64), 0);
+        }
+    }
+}
+
+/// \brief Checking the lock-free queue with one thread and with several producers and consumers
+static void TestQueue()
+{
+    // step 1. The capacity is rounded up to a power of two, the order is first in first out
+    BoundedMpmcQueue<int> queue(5);
+    CHECK_EQUAL(queue.Capacity(), static_cast<std::size_t>(8));
+    for (int i = 0; i < 8; ++i)
+    {
+        int value = i;
+        CHECK_EQUAL(queue.TryPush(value), true);
+    }
+
+    int value = -1;
+    CHECK_EQUAL(queue.Size(), static_cast<std::size_t>(8));
+    for (int i = 0; i < 8; ++i)
+    {
+        CHECK_EQUAL(queue.TryPop(value), true);
+        CHECK_EQUAL(value, i);
+    }
+    CHECK_EQUAL(queue.TryPop(value), false);
+
+    // step 2. The element is not moved from if the queue is full, the capacity of one is rounded up to two
+    BoundedMpmcQueue<std::unique_ptr<int>> pointers(1);
+    std::unique_ptr<int> rejected(new int(8));
+    std::unique_ptr<int> accepted(new int(0)), other(new int(1));
+    CHECK_EQUAL(pointers.TryPush(accepted), true);
+    CHECK_EQUAL(pointers.TryPush(other), true);
+    CHECK_EQUAL(pointers.TryPush(rejected), false);
+    CHECK_EQUAL(rejected != nullptr && *rejected == 8, true);
+
+    // step 3. Every element pushed by several producers is popped once by several consumers
+    const int producersCount = 4, consumersCount = 4, perProducerCount = 20000;
+    BoundedMpmcQueue<int> sharedQueue(64);
+    std::vector<std::atomic<int>> popCounts(producersCount * perProducerCount);
+    std::atomic<int> poppedCount(0);
+    std::vector<std::thread> threads;
+    for (int producer = 0; producer < producersCount; ++producer)
+        threads.emplace_back([&sharedQueue, producer, perProducerCount]()
+        {
+            for (int i = 0; i < perProducerCount; ++i)
+            {
+                int element = producer * perProducerCount + i;
+                while (!sharedQueue.TryPush(element))
+                    std::this_thread::yield();
+            }
+        });
+    for (int consumer = 0; consumer < consumersCount; ++consumer)
+        threads.emplace_back([&sharedQueue, &popCounts, &poppedCount, producersCount, perProducerCount]()
+        {
+            while (poppedCount.load() < producersCount * perProducerCount)
+            {
+                int element;
+                if (!sharedQueue.TryPop(element))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                popCounts[element].fetch_add(1);
+                poppedCount.fetch_add(1);
+            }
+        });
+    for (std::thread& thread : threads)
+        thread.join();
+
+    CHECK_EQUAL(std::count_if(popCounts.begin(), popCounts.end(), [](const std::atomic<int>& count) { return count.load() == 1; }), producersCount * perProducerCount);
+}
+
+/// \brief Checking the hashing service against the one-shot functions, the rejection of the jobs and the completion of the jobs on destruction
+static void TestService()
+{
+    // step 1. Futures and callbacks of the small and the large jobs of all algorithms
+    std::vector<std::string> messages;
+    for (const std::size_t len : { 0, 3, 55, 56, 64, 1000, 16384, 16385, 100000 })
+        messages.push_back(TestData(len, static_cast<std::uint32_t>(len)));
+
+    {
+        Sha2Service service(3, 16, 16384);
+        std::vector<std::future<HashingResult>> futures;
+        for (const std::string& message : messages)
+        {
+            futures.push_back(service.Submit(message.data(), message.size()));
+            futures.push_back(service.Submit(message, Sha256Variant::Sha224));
+            futures.push_back(service.Submit(message.data(), message.size(), Sha512Variant::Sha512));
+            futures.push_back(service.Submit(message, Sha512Variant::Sha384));
+        }
+        for (std::size_t i = 0; i < messages.size(); ++i)
+        {
+            CHECK_EQUAL(futures[i * 4].get().Hex(), Sha256(messages[i]));
+            CHECK_EQUAL(futures[i * 4 + 1].get().Hex(), Sha224(messages[i]));
+            CHECK_EQUAL(futures[i * 4 + 2].get().Hex(), Sha512(messages[i]));
+            CHECK_EQUAL(futures[i * 4 + 3].get().Hex(), Sha384(messages[i]));
+        }
+
+        std::vector<std::string> sha256Results(messages.size()), sha512Results(messages.size());
+        std::atomic<std::size_t> completedCount(0);
+        for (std::size_t i = 0; i < messages.size(); ++i)
+        {
+            CHECK_EQUAL(service.Submit(messages[i].data(), messages[i].size(), Sha256Variant::Sha256,
+                [&sha256Results, &completedCount, i](const HashingResult& result) { sha256Results[i] = result.Hex(); completedCount.fetch_add(1); }), true);
+            CHECK_EQUAL(service.Submit(messages[i].data(), messages[i].size(), Sha512Variant::Sha512,
+                [&sha512Results, &completedCount, i](const HashingResult& result) { sha512Results[i] = result.Hex(); completedCount.fetch_add(1); }), true);
+        }
+        while (completedCount.load() < messages.size() * 2)
+            std::this_thread::yield();
+        for (std::size_t i = 0; i < messages.size(); ++i)
+        {
+            CHECK_EQUAL(sha256Results[i], Sha256(messages[i]));
+            CHECK_EQUAL(sha512Results[i], Sha512(messages[i]));
+        }
+    }
+
+    // step 2. The non-blocking submission is rejected while the only worker is busy and the queue is full
+    {
+        Sha2Service service(1, 2, 16384);
+        std::atomic<bool> isStarted(false), isReleased(false);
+        CHECK_EQUAL(service.Submit("a", 1, Sha256Variant::Sha256, [&isStarted, &isReleased](const HashingResult&)
+        {
+            isStarted.store(true);
+            while (!isReleased.load())
+                std::this_thread::yield();
+        }), true);
+        while (!isStarted.load())
+            std::this_thread::yield();
+
+        auto ignore = [](const HashingResult&) {};
+        CHECK_EQUAL(service.Submit("b", 1, Sha256Variant::Sha256, ignore, false), true);
+        CHECK_EQUAL(service.Submit("c", 1, Sha256Variant::Sha256, ignore, false), true);
+        CHECK_EQUAL(service.Submit("d", 1, Sha256Variant::Sha256, ignore, false), false);
+        CHECK_EQUAL(service.Stats().small.rejectedCount, static_cast<std::uint64_t>(1));
+        isReleased.store(true);
+    }
+
+    // step 3. The destructor completes the submitted jobs, the exceptions of the callbacks are ignored
+    std::atomic<std::size_t> completedCount(0);
+    {
+        Sha2Service service(2, 64, 16384);
+        for (std::size_t i = 0; i < 200; ++i)
+            service.Submit(messages[i % messages.size()].data(), messages[i % messages.size()].size(), Sha256Variant::Sha256, [&completedCount, i](const HashingResult&)
+            {
+                completedCount.fetch_add(1);
+                if (i % 7 == 0)
+                    throw std::runtime_error("callback failure");
+            });
+    }
+    CHECK_EQUAL(completedCount.load(), static_cast<std::size_t>(200));
+}
+
+/// \brief Checking the sha256d functions against the known answers and the midstate batch against the scalar midstate function
+static void TestSha256d()
+{
+    // step 1. Known answers, the hash sum of the Bitcoin genesis block header is shown reversed by the block explorers
+    CHECK_EQUAL(Sha256d(""), "5df6e0e2761359d30a8275058e299fcc0381534545f55cf43e41983f5d4c9456");
+    CHECK_EQUAL(Sha256d("abc"), "4f8b42c22dd3729b519ba6f68d2da7cc5b2d606d05daed5ad5128cc03e6c6358");
+
+    const char genesisHex[] = "0100000000000000000000000000000000000000000000000000000000000000000000003ba3edfd7a7b12b27ac72c3e67768f617fc81bc3888a51323a9fb8aa4b1e5e4a29ab5f49ffff001d1dac2b7c";
+    std::string genesis(80, '\0');
+    for (std::size_t i = 0; i < genesis.size(); ++i)
+        genesis[i] = static_cast<char>(std::stoi(std::string(genesisHex + i * 2, 2), nullptr, 16));
+
+    const std::string genesisHash = "6fe28c0ab6f1b372c1a6a246ae63f74f931e8365e15a089c68d6190000000000";
+    CHECK_EQUAL(Sha256d(genesis), genesisHash);
+    CHECK_EQUAL(DigestToHex(Sha256dBinary(genesis)), genesisHash);
+
+    // step 2. The midstate of the first 64 bytes and the 16 byte tail give the same hash sum
+    std::uint32_t midstate[8];
+    Sha256Midstate(genesis.data(), midstate[0], midstate[1], midstate[2], midstate[3], midstate[4], midstate[5], midstate[6], midstate[7]);
+    CHECK_EQUAL(DigestToHex(Sha256dFromMidstate(midstate[0], midstate[1], midstate[2], midstate[3], midstate[4], midstate[5], midstate[6], midstate[7], genesis.data() + 64, 16)), genesisHash);
+
+    // step 3. Batches against the whole messages for the tails crossing the padding boundaries, the counts do not fill whole groups of lanes
+    const std::string block = TestData(64, 256);
+    Sha256Midstate(block.data(), midstate[0], midstate[1], midstate[2], midstate[3], midstate[4], midstate[5], midstate[6], midstate[7]);
+    for (const std::size_t tailLen : { 0, 16, 55, 56, 63, 64, 100 })
+    {
+        for (const std::size_t count : { 1, 2, 7, 15, 17, 33 })
+        {
+            const std::string tails = TestData(tailLen * count, static_cast<std::uint32_t>(tailLen * 100 + count));
+            std::vector<std::uint8_t> digests(count * 32);
+            Sha256dFromMidstateBatch(midstate, tails.data(), tailLen, count, digests.data());
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const Sha256Digest expected = Sha256dBinary(block + tails.substr(i * tailLen, tailLen));
+                CHECK_EQUAL(memcmp(digests.data() + i * 32, expected.data(), 32), 0);
+            }
+        }
+    }
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+/**
+    \brief A function for setting the modification time of a file
+
+    \param [in] fileName name of the file
+    \param [in] secondsAgo the number of seconds between the modification time and now
+*/
+static void SetModificationTime(const std::string& fileName, const int& secondsAgo)
+{
+    struct timespec times[2];
+    clock_gettime(CLOCK_REALTIME, &times[0]);
+    times[0].tv_sec -= secondsAgo;
+    times[1] = times[0];
+    utimensat(AT_FDCWD, fileName.c_str(), times, 0);
+}
+
+/// \brief Checking the hits and misses of the digest cache after the changes of the file identity, the saving and the loading of the index
+static void TestCache()
+{
+    // step 1. The cached hash sum differs from the real one, so the hits of the file functions can be told from hashing
+    const std::string fileName = "sha2_tests_cache.bin", indexFileName = "sha2_tests_cache.index";
+    {
+        std::ofstream file(fileName, std::ios::binary);
+        file << "cached data";
+    }
+    SetModificationTime(fileName, 100);
+
+    Sha256Digest cached, found;
+    cached.fill(0x5a);
+
+    DigestCache cache;
+    FileIdentity identity;
+    CHECK_EQUAL(cache.Lookup(fileName, Sha2Algorithm::Sha256, found.data(), identity), false);
+    CHECK_EQUAL(identity.isValid, true);
+    cache.Store(fileName, identity, Sha2Algorithm::Sha256, cached.data());
+
+    // step 2. Hit while the file is unchanged, the other algorithms are not cached
+    CHECK_EQUAL(cache.Lookup(fileName, Sha2Algorithm::Sha256, found.data(), identity), true);
+    CHECK_EQUAL(found, cached);
+    CHECK_EQUAL(cache.Lookup(fileName, Sha2Algorithm::Sha512_256, found.data(), identity), false);
+    CHECK_EQUAL(cache.HitsCount(), static_cast<std::uint64_t>(1));
+    CHECK_EQUAL(cache.MissesCount(), static_cast<std::uint64_t>(2));
+
+    SetDigestCache(&cache);
+    CHECK_EQUAL(FileSha256(fileName), DigestToHex(cached));
+    SetDigestCache(nullptr);
+    CHECK_EQUAL(FileSha256(fileName), Sha256("cached data"));
+
+    // step 3. Save and load the index. Loading into a new cache and replacing the loaded records
+    CHECK_EQUAL(cache.Save(indexFileName), true);
+    DigestCache loadedCache;
+    CHECK_EQUAL(loadedCache.Load(indexFileName), true);
+    CHECK_EQUAL(loadedCache.Size(), static_cast<std::size_t>(1));
+    CHECK_EQUAL(loadedCache.Lookup(fileName, Sha2Algorithm::Sha256, found.data(), identity), true);
+    CHECK_EQUAL(found, cached);
+
+    // step 4. Miss after the change of the modification time
+    SetModificationTime(fileName, 200);
+    CHECK_EQUAL(loadedCache.Lookup(fileName, Sha2Algorithm::Sha256, found.data(), identity), false);
+    loadedCache.Store(fileName, identity, Sha2Algorithm::Sha256, cached.data());
+    CHECK_EQUAL(loadedCache.Lookup(fileName, Sha2Algorithm::Sha256, found.data(), identity), true);
+
+    // step 5. Miss after the change of the size with the same modification time
+    struct stat fileStat;
+    stat(fileName.c_str(), &fileStat);
+    {
+        std::ofstream file(fileName, std::ios::binary | std::ios::app);
+        file << "!";
+    }
+#ifdef __APPLE__
+    struct timespec times[2] = { fileStat.st_atimespec, fileStat.st_mtimespec };
+#else
+    struct timespec times[2] = { fileStat.st_atim, fileStat.st_mtim };
+#endif // __APPLE__
+    utimensat(AT_FDCWD, fileName.c_str(), times, 0);
+    CHECK_EQUAL(loadedCache.Lookup(fileName, Sha2Algorithm::Sha256, found.data(), identity), false);
+    loadedCache.Store(fileName, identity, Sha2Algorithm::Sha256, cached.data());
+    CHECK_EQUAL(loadedCache.Lookup(fileName, Sha2Algorithm::Sha256, found.data(), identity), true);
+
+    // step 6. Miss after the change of the status change time only. The file timestamps can be coarser than a millisecond
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    chmod(fileName.c_str(), 0600);
+    CHECK_EQUAL(loadedCache.Lookup(fileName, Sha2Algorithm::Sha256, found.data(), identity), false);
+
+    // step 7. Recently modified files are not stored
+    SetModificationTime(fileName, 0);
+    CHECK_EQUAL(loadedCache.Lookup(fileName, Sha2Algorithm::Sha256, found.data(), identity), false);
+    loadedCache.Store(fileName, identity, Sha2Algorithm::Sha256, cached.data());
+    CHECK_EQUAL(loadedCache.Lookup(fileName, Sha2Algorithm::Sha256, found.data(), identity), false);
+
+    // step 8. Damaged index files are not loaded and leave the cache empty
+    std::string index;
+    {
+        std::ifstream file(indexFileName, std::ios::binary);
+        index.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    const std::string damagedIndexes[] = { "", "not an index", index.substr(0, index.size() - 1), "X" + index.substr(1), index + "extra" };
+    for (const std::string& damagedIndex : damagedIndexes)
+    {
+        {
+            std::ofstream file(indexFileName, std::ios::binary | std::ios::trunc);
+            file.write(damagedIndex.data(), damagedIndex.size());
+        }
+        CHECK_EQUAL(loadedCache.Load(indexFileName), false);
+        CHECK_EQUAL(loadedCache.Size(), static_cast<std::size_t>(0));
+    }
+
+    std::remove(fileName.c_str());
+    std::remove(indexFileName.c_str());
+}
+#else
+/// \brief The digest cache is always empty without POSIX files
+static void TestCache()
+{
+}
+#endif // __unix__ || __APPLE__
+
+/// \brief Stream buffer which gives the data in short pieces, like a pipe
+class ShortReadsBuffer : public std::streambuf
+{
+private:
+    std::string data;
+    std::size_t position = 0;
+    std::size_t pieceSize;
+
+public:
+    ShortReadsBuffer(const std::string& data, const std::size_t& pieceSize) : data(data), pieceSize(pieceSize) {}
+
+protected:
+    int_type underflow() override
+    {
+        if (position >= data.size())
+            return traits_type::eof();
+
+        std::size_t len = std::min(pieceSize, data.size() - position);
+        setg(&data[position], &data[position], &data[position] + len);
+        position += len;
+        return traits_type::to_int_type(data[position - len]);
+    }
+};
+
+/**
+    \brief A function for splitting the data into chunks with ChunkStreamSha256 and checking the chunks and the hash sum of the whole data
+
+    \param [in] data the data to split
+    \param [in] stream the stream with the data
+
+    \return the chunks
+*/
+static std::vector<ContentChunk> ChunkAndCheck(const std::string& data, std::istream& stream)
+{
+    std::vector<ContentChunk> res;
+    Sha256Digest digest;
+    CHECK_EQUAL(ChunkStreamSha256(stream, [&res](const ContentChunk& chunk) { res.push_back(chunk); }, digest, true), true);
+    CHECK_EQUAL(digest, Sha256Binary(data));
+
+    std::uint64_t offset = 0;
+    for (const ContentChunk& chunk : res)
+    {
+        CHECK_EQUAL(chunk.offset, offset);
+        CHECK_EQUAL(chunk.sha256, Sha256Binary(data.data() + chunk.offset, chunk.length));
+        CHECK_EQUAL(chunk.sha512_256, Sha512_256Binary(data.data() + chunk.offset, chunk.length));
+        offset += chunk.length;
+    }
+    CHECK_EQUAL(offset, static_cast<std::uint64_t>(data.size()));
+
+    return res;
+}
+
+/// \brief Checking the content defined chunking against the boundaries found in memory, the chunk size limits and the locality of the edits
+static void TestChunking()
+{
+    // step 1. The data is longer than several segments of the chunking thread
+    const std::string data = TestData(5 * 1024 * 1024 + 123, 1234);
+    std::vector<std::size_t> expectedLens;
+    for (std::size_t position = 0; position < data.size(); position += expectedLens.back())
+        expectedLens.push_back(FindChunkBoundary(data.data() + position, data.size() - position));
+
+    // step 2. The boundaries do not depend on the size of the reads
+    std::istringstream stream(data);
+    const std::vector<ContentChunk> chunks = ChunkAndCheck(data, stream);
+    for (const std::size_t pieceSize : { 1, 777, 100000 })
+    {
+        // Reading by single bytes is slow, so only the beginning of the data is read then. Its last chunk is cut by the end of the data
+        const std::string piecesData = pieceSize == 1 ? data.substr(0, 300000) : data;
+        ShortReadsBuffer buffer(piecesData, pieceSize);
+        std::istream shortReadsStream(&buffer);
+        const std::vector<ContentChunk> shortReadsChunks = ChunkAndCheck(piecesData, shortReadsStream);
+        for (std::size_t i = 0; i < shortReadsChunks.size() && i < chunks.size() && chunks[i].offset + chunks[i].length < piecesData.size(); ++i)
+            CHECK_EQUAL(shortReadsChunks[i].length, chunks[i].length);
+        if (piecesData.size() == data.size())
+            CHECK_EQUAL(shortReadsChunks.size(), chunks.size());
+    }
+
+    std::vector<std::size_t> lens;
+    for (const ContentChunk& chunk : chunks)
+        lens.push_back(chunk.length);
+    CHECK_EQUAL(lens, expectedLens);
+
+    // step 3. Every chunk but the last is between the minimum and the maximum size, the sizes concentrate around the average size
+    for (std::size_t i = 0; i + 1 < lens.size(); ++i)
+        CHECK_EQUAL(lens[i] >= CDC_MIN_SIZE && lens[i] <= CDC_MAX_SIZE, true);
+    CHECK_EQUAL(!lens.empty() && lens.back() <= CDC_MAX_SIZE, true);
+    const std::size_t averageLen = data.size() / lens.size();
+    CHECK_EQUAL(averageLen >= CDC_AVERAGE_SIZE / 2 && averageLen <= CDC_AVERAGE_SIZE * 2, true);
+
+    // step 4. Inserted and changed bytes change only the chunks around them
+    std::string edited = data;
+    edited.insert(1000000, "inserted");
+    edited[3000000] ^= 1;
+    std::istringstream editedStream(edited);
+    const std::vector<ContentChunk> editedChunks = ChunkAndCheck(edited, editedStream);
+
+    std::vector<Sha256Digest> hashes;
+    for (const ContentChunk& chunk : chunks)
+        hashes.push_back(chunk.sha256);
+    std::sort(hashes.begin(), hashes.end());
+    std::size_t changedCount = 0;
+    for (const ContentChunk& chunk : editedChunks)
+        changedCount += std::binary_search(hashes.begin(), hashes.end(), chunk.sha256) ? 0 : 1;
+    CHECK_EQUAL(changedCount >= 2 && changedCount <= 6, true);
+
+    // step 5. A handler exception and a read error stop the chunking
+    std::istringstream throwingStream(data);
+    Sha256Digest digest;
+    CHECK_EQUAL(ChunkStreamSha256(throwingStream, [](const ContentChunk& chunk) { if (chunk.offset > 100000) throw std::runtime_error("handler failure"); }, digest), false);
+    CHECK_EQUAL(ChunkFileSha256(".", [](const ContentChunk&) {}, digest), false);
+    CHECK_EQUAL(ChunkFileSha256("sha2_tests_missing.bin", [](const ContentChunk&) {}, digest), false);
+
+    // step 6. The start fails if the segments can not be allocated, the hashing threads are already running then
+    std::istringstream hugeChunksStream(data);
+    CHECK_EQUAL(ChunkStreamSha256(hugeChunksStream, [](const ContentChunk&) {}, digest, false, CDC_MIN_SIZE, CDC_AVERAGE_SIZE, SIZE_MAX / 16), false);
+    std::istringstream overflowingChunksStream(data);
+    CHECK_EQUAL(ChunkStreamSha256(overflowingChunksStream, [](const ContentChunk&) {}, digest, false, CDC_MIN_SIZE, CDC_AVERAGE_SIZE, SIZE_MAX / 4 + 2), false);
+}
+
+/// \brief Checking the metrics snapshots, the reset and the export. The counters are checked only if the library collects them
+static void TestMetrics()
+{
+    // step 1. Calls after the reset, one of them on a finished thread
+    ResetSha2Metrics();
+    const std::string shortMessage = TestData(100, 100), longMessage = TestData(5000, 5000);
+    Sha256(shortMessage);
+    Sha256(shortMessage);
+    std::thread([&shortMessage, &longMessage]()
+    {
+        Sha256(shortMessage);
+        Sha512(longMessage);
+    }).join();
+
+    Sha2Metrics metrics = GetSha2Metrics();
+    CHECK_EQUAL(metrics.sha256.singleKernel.empty(), false);
+    CHECK_EQUAL(metrics.sha512.batchKernel.empty(), false);
+    if (metrics.isEnabled)
+    {
+        CHECK_EQUAL(metrics.sha256.bytesCount, static_cast<std::uint64_t>(300));
+        CHECK_EQUAL(metrics.sha256.blocksCount, static_cast<std::uint64_t>(6));
+        CHECK_EQUAL(metrics.sha256.callsCount, static_cast<std::uint64_t>(3));
+        CHECK_EQUAL(metrics.sha256.callsBySize[1], static_cast<std::uint64_t>(3));
+        CHECK_EQUAL(metrics.sha512.bytesCount, static_cast<std::uint64_t>(5000));
+        CHECK_EQUAL(metrics.sha512.blocksCount, static_cast<std::uint64_t>(40));
+        CHECK_EQUAL(metrics.sha512.callsBySize[4], static_cast<std::uint64_t>(1));
+        CHECK_EQUAL(metrics.sha512.latencySamplesCount, static_cast<std::uint64_t>(1));
+    }
+    else
+        CHECK_EQUAL(metrics.sha256.callsCount + metrics.sha512.callsCount, static_cast<std::uint64_t>(0));
+
+    // step 2. The export has the counters and the cumulative histograms
+    const std::string text = ExportSha2Metrics();
+    CHECK_EQUAL(text.find(std::string("sha2_metrics_enabled ") + (metrics.isEnabled ? "1" : "0") + "\n") != std::string::npos, true);
+    CHECK_EQUAL(text.find("sha2_kernel_info{family=\"sha256\",path=\"single\",kernel=\"" + metrics.sha256.singleKernel + "\"} 1\n") != std::string::npos, true);
+    CHECK_EQUAL(text.find("# TYPE sha2_message_size_bytes histogram\n") != std::string::npos, true);
+    if (metrics.isEnabled)
+    {
+        CHECK_EQUAL(text.find("sha2_hashed_bytes_total{family=\"sha256\"} 300\n") != std::string::npos, true);
+        CHECK_EQUAL(text.find("sha2_hashed_bytes_total{family=\"sha512\"} 5000\n") != std::string::npos, true);
+        CHECK_EQUAL(text.find("sha2_message_size_bytes_bucket{family=\"sha256\",le=\"64\"} 0\n") != std::string::npos, true);
+        CHECK_EQUAL(text.find("sha2_message_size_bytes_bucket{family=\"sha256\",le=\"256\"} 3\n") != std::string::npos, true);
+        CHECK_EQUAL(text.find("sha2_message_size_bytes_bucket{family=\"sha256\",le=\"+Inf\"} 3\n") != std::string::npos, true);
+        CHECK_EQUAL(text.find("sha2_message_size_bytes_sum{family=\"sha256\"} 300\n") != std::string::npos, true);
+        CHECK_EQUAL(text.find("sha2_message_size_bytes_count{family=\"sha512\"} 1\n") != std::string::npos, true);
+        CHECK_EQUAL(text.find("sha2_call_duration_seconds_count{family=\"sha512\"} 1\n") != std::string::npos, true);
+    }
+
+    // step 3. The reset clears the counters of the living and the finished threads
+    ResetSha2Metrics();
+    metrics = GetSha2Metrics();
+    CHECK_EQUAL(metrics.sha256.bytesCount + metrics.sha256.blocksCount + metrics.sha256.callsCount + metrics.sha256.latencySamplesCount, static_cast<std::uint64_t>(0));
+    CHECK_EQUAL(metrics.sha512.bytesCount + metrics.sha512.blocksCount + metrics.sha512.callsCount + metrics.sha512.latencySamplesCount, static_cast<std::uint64_t>(0));
+    CHECK_EQUAL(ExportSha2Metrics().find("sha2_hashed_bytes_total{family=\"sha256\"} 0\n") != std::string::npos, true);
+
+    Sha512(longMessage);
+    CHECK_EQUAL(GetSha2Metrics().sha512.bytesCount, static_cast<std::uint64_t>(metrics.isEnabled ? 5000 : 0));
+}
+
+/**
+    \brief A function for checking the export and the import of the context states of one family
+
+    \tparam Context type of the contexts
+    \tparam Variant type of the hashing algorithms of the contexts
+
+    \param [in] variants the hashing algorithms of the family
+    \param [in] headerLen length of the state without the incomplete block
+    \param [in] blockLen length of the block of the family
+*/
+template <typename Context, typename Variant>
+static void TestContextState(const std::vector<Variant>& variants, const std::size_t& headerLen, const std::size_t& blockLen)
+{
+    const std::string data = TestData(1000, 1000);
+    for (const Variant variant : variants)
+    {
+        Context whole(variant);
+        whole.Update(data);
+        const std::string expected = whole.Final();
+
+        // step 1. The state exported at any point continues in another context, the algorithm is taken from the state
+        for (std::size_t split = 0; split <= blockLen * 2 + 1; ++split)
+        {
+            Context first(variant);
+            first.Update(data.data(), split);
+            const std::string state = first.Export();
+            CHECK_EQUAL(state.size(), headerLen + split % blockLen);
+
+            Context second(variants.front() == variant ? variants.back() : variants.front());
+            CHECK_EQUAL(second.Import(state), true);
+            CHECK_EQUAL(second.Variant(), variant);
+            CHECK_EQUAL(second.Length(), static_cast<std::uint64_t>(split));
+            second.Update(data.data() + split, data.size() - split);
+            CHECK_EQUAL(second.Final(), expected);
+        }
+
+        // step 2. Truncated, extended and damaged states are rejected and do not change the context
+        Context first(variant);
+        first.Update(data.data(), blockLen + 10);
+        const std::string state = first.Export();
+
+        std::vector<std::string> damagedStates;
+        for (std::size_t len = 0; len < state.size(); ++len)
+            damagedStates.push_back(state.substr(0, len));
+        damagedStates.push_back(state + "x");
+        damagedStates.push_back(std::string(1, '\x02') + state.substr(1));
+        damagedStates.push_back(state.substr(0, 1) + '\x7f' + state.substr(2));
+        std::string wrongLength = state;
+        wrongLength[9] = static_cast<char>(wrongLength[9] + 1);
+        damagedStates.push_back(wrongLength);
+
+        for (const std::string& damagedState : damagedStates)
+        {
+            Context context(variant);
+            context.Update("abc");
+            CHECK_EQUAL(context.Import(damagedState), false);
+            CHECK_EQUAL(context.Length(), static_cast<std::uint64_t>(3));
+        }
+    }
+}
+
+/// \brief Checking the context states and the resumable file hashing
+static void TestState()
+{
+    // step 1. States of both families. The states of one family are rejected by the other
+    TestContextState<Sha256Context, Sha256Variant>({ Sha256Variant::Sha256, Sha256Variant::Sha224 }, 42, 64);
+    TestContextState<Sha512Context, Sha512Variant>({ Sha512Variant::Sha512, Sha512Variant::Sha384, Sha512Variant::Sha512_224, Sha512Variant::Sha512_256 }, 74, 128);
+
+    const std::string data = TestData(300, 3000);
+    for (std::size_t len = 0; len < 300; len += 7)
+    {
+        Sha256Context sha256Context;
+        sha256Context.Update(data.data(), len);
+        Sha512Context sha512Context;
+        sha512Context.Update(data.data(), len);
+        CHECK_EQUAL(Sha512Context().Import(sha256Context.Export()), false);
+        CHECK_EQUAL(Sha256Context().Import(sha512Context.Export()), false);
+    }
+
+    // step 2. Resuming the file hashing from the last checkpoint of an interrupted run
+    const std::string fileData = TestData(1000000 + 3, 4);
+    const std::string fileName = "sha2_tests_resumable.bin", checkpointFileName = "sha2_tests_resumable.checkpoint";
+    {
+        std::ofstream file(fileName, std::ios::binary);
+        file.write(fileData.data(), fileData.size());
+    }
+
+    std::string lastState;
+    std::size_t checkpointsCount = 0;
+    Sha256Context interrupted(Sha256Variant::Sha224);
+    try
+    {
+        HashFileSha256Resumable(fileName, interrupted, [&lastState, &checkpointsCount](const std::string& state)
+        {
+            if (++checkpointsCount == 3)
+                throw std::runtime_error("interrupted");
+            lastState = state;
+        }, 100000, 4096);
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+    CHECK_EQUAL(checkpointsCount, static_cast<std::size_t>(3));
+
+    Sha256Context resumed;
+    CHECK_EQUAL(resumed.Import(lastState), true);
+    CHECK_EQUAL(resumed.Length() >= 200000 && resumed.Length() < 300000, true);
+    checkpointsCount = 0;
+    CHECK_EQUAL(HashFileSha256Resumable(fileName, resumed, [&checkpointsCount](const std::string&) { ++checkpointsCount; }, 100000, 4096), true);
+    CHECK_EQUAL(checkpointsCount, static_cast<std::size_t>(7));
+    CHECK_EQUAL(resumed.Final(), Sha224(fileData));
+
+    // A context longer than the file can not be resumed
+    Sha512Context tooLong;
+    tooLong.Update(fileData);
+    tooLong.Update("x");
+    CHECK_EQUAL(HashFileSha512Resumable(fileName, tooLong, [](const std::string&) {}, 100000, 4096), false);
+
+    // step 3. Damaged and foreign checkpoint files are ignored, the checkpoint file is removed after hashing
+    for (const std::string& checkpoint : { std::string("damaged"), lastState, std::string("1 2 3 4\n") + lastState })
+    {
+        {
+            std::ofstream file(checkpointFileName, std::ios::binary);
+            file << checkpoint;
+        }
+        CHECK_EQUAL(ResumableFileSha256(fileName, checkpointFileName, Sha256Variant::Sha224, 100000, 4096), Sha224(fileData));
+        CHECK_EQUAL(ResumableFileSha512(fileName, checkpointFileName, Sha512Variant::Sha512, 100000, 4096), Sha512(fileData));
+        CHECK_EQUAL(std::ifstream(checkpointFileName).is_open(), false);
+    }
+
+    std::remove(fileName.c_str());
+}
+
+/// \brief Checking the prefix snapshots and the prefix caches against the hashing of the whole messages
+static void TestPrefix()
+{
+    const std::string data = TestData(3000, 3000);
+
+    // step 1. Prefix snapshots and caches. The small caches evict the prefixes
+    Sha256PrefixCache sha256Cache(2);
+    Sha512PrefixCache sha512Cache(2);
+    for (std::size_t round = 0; round < 3; ++round)
+    {
+        for (const std::size_t prefixLen : { 0, 1, 63, 64, 65, 127, 128, 129, 1000 })
+        {
+            const std::string prefix = data.substr(0, prefixLen), suffix = data.substr(prefixLen, 100 + round);
+            CHECK_EQUAL(Sha256Prefix(prefix, Sha256Variant::Sha224).Hash(suffix), Sha224(prefix + suffix));
+            CHECK_EQUAL(Sha512Prefix(prefix, Sha512Variant::Sha384).Hash(suffix), Sha384(prefix + suffix));
+            CHECK_EQUAL(sha256Cache.Hash(prefix, suffix), Sha256(prefix + suffix));
+            CHECK_EQUAL(sha256Cache.Hash(prefix, suffix, Sha256Variant::Sha224), Sha224(prefix + suffix));
+            CHECK_EQUAL(sha512Cache.Hash(prefix, suffix), Sha512(prefix + suffix));
+            CHECK_EQUAL(sha512Cache.Hash(prefix, suffix, Sha512Variant::Sha512_256), Sha512_256(prefix + suffix));
+
+            Sha256Digest digest;
+            CHECK_EQUAL(sha256Cache.Hash(prefix.data(), prefix.size(), suffix.data(), suffix.size(), digest.data()), static_cast<std::size_t>(32));
+            CHECK_EQUAL(DigestToHex(digest), Sha256(prefix + suffix));
+        }
+    }
+
+    // step 2. The cache is shared by several threads
+    Sha256PrefixCache sharedCache(4);
+    std::atomic<int> mismatchesCount(0);
+    std::vector<std::thread> threads;
+    for (std::uint32_t thread = 0; thread < 4; ++thread)
+        threads.emplace_back([&sharedCache, &mismatchesCount, &data, thread]()
+        {
+            for (std::size_t i = 0; i < 200; ++i)
+            {
+                const std::string prefix = data.substr(0, 60 + (i * 7 + thread) % 9 * 20), suffix = data.substr(2000, i);
+                if (sharedCache.Hash(prefix, suffix) != Sha256(prefix + suffix))
+                    mismatchesCount.fetch_add(1);
+            }
+        });
+    for (std::thread& thread : threads)
+        thread.join();
+    CHECK_EQUAL(mismatchesCount.load(), 0);
+}
+
+/// \brief Test group which can be run separately from the command line
+struct TestGroup
+{
+    const char* name;
+    void (*run)();
+};
+
+static const TestGroup TestGroups[] = {
+    { "known-answers", TestKnownAnswers },
+    { "kernels", TestKernels },
+    { "hmac", TestHmac },
+    { "pbkdf2", TestPbkdf2 },
+    { "files", TestFiles },
+    { "merkle", TestMerkle },
+    { "queue", TestQueue },
+    { "service", TestService },
+    { "sha256d", TestSha256d },
+    { "cache", TestCache },
+    { "chunking", TestChunking },
+    { "metrics", TestMetrics },
+    { "state", TestState },
+    { "prefix", TestPrefix },
+};
+
+int main(int argc, char** argv)
+{
+    // Without arguments all groups are run
+    bool found = argc < 2;
+    for (const TestGroup& group : TestGroups)
+    {
+        if (argc >= 2 && strcmp(argv[1], group.name) != 0)
+            continue;
+
+        found = true;
+        group.run();
+    }
+
+    if (!found)
+    {
+        std::cerr << "Unknown test group " << argv[1] << std::endl;
+        return 2;
+    }
+
+    if (FailedChecks > 0)
+    {
+        std::cerr << FailedChecks << " checks failed" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
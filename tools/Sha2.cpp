@@ -0,0 +1,98 @@
+#include "Sha2Tool.h"
+#include "Sha2.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <cstring>
+
+// Begin hash values of the algorithms
+static const std::uint32_t Sha256BeginHash[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+static const std::uint32_t Sha224BeginHash[8] = { 0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4 };
+
+/**
+    \brief A function for calculating the file hash sum for the command line tool
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [out] hash a string with the hash sum
+
+    \return true if the hash was calculated, false if the file cannot be opened
+*/
+template <typename Digest, bool (*FileHash)(const std::string&, Digest&, const std::size_t&) noexcept>
+bool ToolFileHash(const std::string& fileName, std::string& hash)
+{
+    Digest digest;
+    if (!FileHash(fileName, digest, CHUNK_SIZE))
+        return false;
+
+    hash = DigestToHex(digest);
+    return true;
+}
+
+/**
+    \brief A function for calculating the hash sum of a stream for the command line tool
+
+    \param [in] stream the stream to read
+
+    \return a string with the hash sum
+*/
+template <Sha256Variant Variant>
+std::string ToolStreamHash(std::istream& stream)
+{
+    Sha256Context context(Variant);
+    std::vector<char> chunk(CHUNK_SIZE);
+
+    while (stream.read(chunk.data(), chunk.size()) || stream.gcount() > 0)
+        context.Update(chunk.data(), stream.gcount());
+
+    return context.Final();
+}
+
+/**
+    \brief A function for getting the backends of the benchmark supported by the processor
+
+    The default backend is the one chosen by the library for single messages, the other ones are the kernels of the library
+
+    \return the backends hashing with the begin hash values of the algorithm
+*/
+template <const std::uint32_t* BeginHash>
+std::vector<ToolBackend> ToolBackends()
+{
+    std::vector<ToolBackend> res;
+
+    res.push_back({ "default", 1, [](const char* const* data, const std::size_t* dataLens, const std::size_t& count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::uint32_t h[8];
+            memcpy(h, BeginHash, sizeof(h));
+            HashSha256(data[i], dataLens[i], h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7]);
+        }
+    } });
+
+    // Kernels of the library
+    for (const Sha256Kernel& kernel : GetSha256Kernels())
+    {
+        res.push_back({ kernel.name, kernel.lanesCount, [kernel](const char* const* data, const std::size_t* dataLens, const std::size_t& count)
+        {
+            static thread_local std::vector<std::uint32_t> hashes;
+            hashes.resize(count * 8);
+            kernel.hash(data, dataLens, count, BeginHash, hashes.data());
+        } });
+    }
+
+    return res;
+}
+
+/// \brief Algorithms supported by the command line tool
+static const ToolAlgorithm Sha256Algorithms[] = {
+    { "sha256", 64, ToolFileHash<Sha256Digest, FileSha256Binary>, ToolStreamHash<Sha256Variant::Sha256>, ToolBackends<Sha256BeginHash> },
+    { "sha224", 56, ToolFileHash<Sha224Digest, FileSha224Binary>, ToolStreamHash<Sha256Variant::Sha224>, ToolBackends<Sha224BeginHash> },
+};
+
+int main(int argc, char** argv)
+{
+    ToolFamily family = { Sha256Algorithms, sizeof(Sha256Algorithms) / sizeof(Sha256Algorithms[0]), "sha256 or sha224", "sha256 (default) or sha224" };
+    return RunTool(argc, argv, family);
+}
@@ -0,0 +1,648 @@
+#include "Sha2Tool.h"
+#include "Sha2.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <filesystem>
+#include <cstdlib>
+#include <chrono>
+#include <iomanip>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Name of the program for the error messages
+static std::string ProgramName = "sha2";
+
+/**
+    \brief A function for printing an error about a file in the coreutils format
+
+    \param [in] fileName the name of the file
+    \param [in] error the error number, EIO if it is 0
+*/
+static void PrintFileError(const std::string& fileName, const int& error)
+{
+    std::cerr << ProgramName << ": " << fileName << ": " << std::strerror(error != 0 ? error : EIO) << std::endl;
+}
+
+/**
+    \brief A function for calculating results of tasks on several threads and handling them in the order of tasks
+
+    The workers take the tasks from a shared counter in their order instead of stealing them from each other, so the results which
+    are handled first are ready first and only a few results wait for the output. If no worker thread can be started,
+    the tasks are calculated on the calling thread
+
+    \param [in] tasksCount the number of tasks
+    \param [in] threadsCount the number of worker threads
+    \param [in] task the function to calculate the result of the task
+    \param [in] output the function to handle the result of the task. Called on the calling thread
+*/
+static void RunInOrder(const std::size_t& tasksCount, const unsigned int& threadsCount, const std::function<std::string(const std::size_t&)>& task, const std::function<void(const std::size_t&, const std::string&)>& output)
+{
+    std::vector<std::string> results(tasksCount);
+    std::vector<bool> isReady(tasksCount, false);
+    std::atomic<std::size_t> nextTask(0);
+    std::mutex mutex;
+    std::condition_variable resultReady;
+
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < std::min<std::size_t>(std::max(threadsCount, 1u), tasksCount); ++i)
+    {
+        try
+        {
+            workers.emplace_back([&]()
+            {
+                for (std::size_t taskIndex = nextTask++; taskIndex < tasksCount; taskIndex = nextTask++)
+                {
+                    std::string result = task(taskIndex);
+
+                    std::lock_guard<std::mutex> lock(mutex);
+                    results[taskIndex] = std::move(result);
+                    isReady[taskIndex] = true;
+                    resultReady.notify_one();
+                }
+            });
+        }
+        catch (...)
+        {
+            break;
+        }
+    }
+
+    // The started workers take all of the tasks, without them the tasks are calculated here
+    if (workers.empty())
+    {
+        for (std::size_t i = 0; i < tasksCount; ++i)
+            output(i, task(i));
+
+        return;
+    }
+
+    for (std::size_t i = 0; i < tasksCount; ++i)
+    {
+        std::string result;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            resultReady.wait(lock, [&]() { return isReady[i]; });
+            result = std::move(results[i]);
+        }
+
+        output(i, result);
+    }
+
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+/**
+    \brief A function for calculating the hash sum of a file or the standard input for the command line tool
+
+    \param [in] fileName the string with file name to calculate hash for. "-" means the standard input
+    \param [in] algorithm the hashing algorithm
+    \param [out] error the error number if the file cannot be read
+
+    \return a string with a hash sum or an empty string if the file cannot be read
+*/
+static std::string CommandLineFileHash(const std::string& fileName, const ToolAlgorithm& algorithm, int& error)
+{
+    if (fileName == "-")
+        return algorithm.streamHash(std::cin);
+
+    std::string hash;
+    errno = 0;
+    if (!algorithm.fileHash(fileName, hash))
+    {
+        error = errno;
+        return "";
+    }
+
+    return hash;
+}
+
+/**
+    \brief A function for expanding the command line arguments into the list of files
+
+    Directories are walked recursively, the files inside them are sorted by path
+
+    \param [in] names files and directories from the command line
+    \param [out] isFailed set to true if a directory cannot be read
+
+    \return a vector of file names
+*/
+static std::vector<std::string> CollectFiles(const std::vector<std::string>& names, bool& isFailed)
+{
+    std::vector<std::string> res;
+
+    for (const std::string& name : names)
+    {
+        std::error_code error;
+        if (name == "-" || !std::filesystem::is_directory(name, error))
+        {
+            res.push_back(name);
+            continue;
+        }
+
+        std::vector<std::string> directoryFiles;
+        for (std::filesystem::recursive_directory_iterator it(name, std::filesystem::directory_options::skip_permission_denied, error), end; !error && it != end; it.increment(error))
+            if (it->is_regular_file(error))
+                directoryFiles.push_back(it->path().string());
+
+        if (error) {PrintFileError(name, error.value()); isFailed = true;}
+
+        std::sort(directoryFiles.begin(), directoryFiles.end());
+        res.insert(res.end(), directoryFiles.begin(), directoryFiles.end());
+    }
+
+    return res;
+}
+
+/**
+    \brief A function for reading the lines of a file or the standard input
+
+    \param [in] fileName the string with file name to read. "-" means the standard input
+    \param [out] lines a vector to append the lines to
+
+    \return true if the file was read, false if it cannot be opened
+*/
+static bool ReadLines(const std::string& fileName, std::vector<std::string>& lines)
+{
+    std::ifstream file;
+    if (fileName != "-")
+    {
+        errno = 0;
+        file.open(fileName);
+        if (!file.is_open()) {PrintFileError(fileName, errno); return false;}
+    }
+
+    std::istream& stream = fileName == "-" ? std::cin : file;
+    for (std::string line; std::getline(stream, line);)
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        if (!line.empty())
+            lines.push_back(line);
+    }
+
+    return true;
+}
+
+/**
+    \brief A function for printing the hash sums of files in the coreutils format
+
+    \param [in] files the names of files to hash
+    \param [in] algorithm the hashing algorithm
+    \param [in] threadsCount the number of worker threads
+
+    \return true if all files were hashed
+*/
+static bool PrintFilesHashes(const std::vector<std::string>& files, const ToolAlgorithm& algorithm, const unsigned int& threadsCount)
+{
+    bool isSuccess = true;
+    std::vector<int> errors(files.size(), 0);
+
+    RunInOrder(files.size(), threadsCount, [&](const std::size_t& i) { return CommandLineFileHash(files[i], algorithm, errors[i]); },
+        [&](const std::size_t& i, const std::string& hash)
+        {
+            if (hash.empty())
+            {
+                std::cout.flush();
+                PrintFileError(files[i], errors[i]);
+                isSuccess = false;
+            }
+            else
+                std::cout << hash << "  " << files[i] << '\n';
+        });
+
+    return isSuccess;
+}
+
+/**
+    \brief A function for checking files against the hash sums from manifests in the coreutils format
+
+    Every line of a manifest contains a hash sum, two spaces or a space and an asterisk and the file name.
+    The algorithm of every line is chosen by the length of its hash sum
+
+    \param [in] manifests the names of manifest files. "-" means the standard input
+    \param [in] family the algorithms of the tool
+    \param [in] threadsCount the number of worker threads
+
+    \return true if all files match their hash sums
+*/
+static bool CheckFiles(const std::vector<std::string>& manifests, const ToolFamily& family, const unsigned int& threadsCount)
+{
+    bool isSuccess = true;
+
+    // Read and parse the manifests one by one, a manifest without any properly formatted line is an error like in coreutils
+    std::vector<std::string> hashes, files;
+    std::vector<const ToolAlgorithm*> algorithms;
+    std::size_t badLines = 0;
+    for (const std::string& manifest : manifests)
+    {
+        std::vector<std::string> lines;
+        if (!ReadLines(manifest, lines))
+        {
+            isSuccess = false;
+            continue;
+        }
+
+        std::size_t manifestBadLines = 0;
+        for (const std::string& line : lines)
+        {
+            std::size_t hashLen = line.find(' ');
+            const ToolAlgorithm* algorithm = nullptr;
+
+            for (std::size_t i = 0; i < family.algorithmsCount; ++i)
+                if (family.algorithms[i].hashLen == hashLen)
+                    algorithm = &family.algorithms[i];
+
+            if (algorithm == nullptr || line.length() < hashLen + 3 || (line[hashLen + 1] != ' ' && line[hashLen + 1] != '*'))
+            {
+                ++manifestBadLines;
+                continue;
+            }
+
+            std::string hash = line.substr(0, hashLen);
+            std::transform(hash.begin(), hash.end(), hash.begin(), [](unsigned char c) { return std::tolower(c); });
+
+            hashes.push_back(hash);
+            files.push_back(line.substr(hashLen + 2));
+            algorithms.push_back(algorithm);
+        }
+
+        if (manifestBadLines == lines.size())
+        {
+            std::cerr << ProgramName << ": " << (manifest == "-" ? "standard input" : manifest) << ": no properly formatted checksum lines found" << std::endl;
+            isSuccess = false;
+        }
+        else
+            badLines += manifestBadLines;
+    }
+
+    // Check files
+    std::size_t failedFiles = 0, unreadFiles = 0;
+    std::vector<int> errors(files.size(), 0);
+    RunInOrder(files.size(), threadsCount, [&](const std::size_t& i) { return CommandLineFileHash(files[i], *algorithms[i], errors[i]); },
+        [&](const std::size_t& i, const std::string& hash)
+        {
+            if (hash.empty())
+            {
+                std::cout.flush();
+                PrintFileError(files[i], errors[i]);
+                std::cout << files[i] << ": FAILED open or read\n";
+                ++unreadFiles;
+            }
+            else if (hash != hashes[i])
+            {
+                std::cout << files[i] << ": FAILED\n";
+                ++failedFiles;
+            }
+            else
+                std::cout << files[i] << ": OK\n";
+        });
+
+    std::cout.flush();
+
+    if (badLines > 0)
+        std::cerr << ProgramName << ": WARNING: " << badLines << " lines are improperly formatted" << std::endl;
+
+    if (unreadFiles > 0)
+        std::cerr << ProgramName << ": WARNING: " << unreadFiles << " listed files could not be read" << std::endl;
+
+    if (failedFiles > 0)
+        std::cerr << ProgramName << ": WARNING: " << failedFiles << " computed checksums did NOT match" << std::endl;
+
+    return isSuccess && failedFiles == 0 && unreadFiles == 0;
+}
+
+/// \brief Result of the benchmark of one algorithm, backend and message size
+struct BenchmarkResult
+{
+    // Name of the algorithm
+    std::string algorithm;
+
+    // Name of the hashing backend
+    std::string backend;
+
+    // Length of the hashed messages
+    std::size_t messageSize;
+
+    // Number of the hashed messages
+    std::uint64_t messagesCount;
+
+    // Duration of the benchmark in seconds
+    double seconds;
+
+    // Number of the processor time stamp counter cycles or 0 if the counter is not available
+    std::uint64_t cycles;
+};
+
+/// \brief Read the processor time stamp counter
+/// \return the number of cycles or 0 if the counter is not available
+static std::uint64_t ReadCycles() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+    \brief A function for measuring the speed of the hashing
+
+    The round function is called until the total duration is at least 0.25 seconds. The first round warms up caches and is not measured for messages less than 64 MiB
+
+    \param [in] algorithm the name of the algorithm
+    \param [in] backend the name of the hashing backend
+    \param [in] messageSize the length of the hashed messages
+    \param [in] round the function hashing some messages and returning their number
+
+    \return the benchmark result
+*/
+static BenchmarkResult MeasureHashing(const std::string& algorithm, const std::string& backend, const std::size_t& messageSize, const std::function<std::size_t()>& round)
+{
+    if (messageSize < (static_cast<std::size_t>(1) << 26))
+        round();
+
+    BenchmarkResult res = { algorithm, backend, messageSize, 0, 0, 0 };
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    std::uint64_t beginCycles = ReadCycles();
+
+    while (res.seconds < 0.25)
+    {
+        res.messagesCount += round();
+        res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    res.cycles = ReadCycles() - beginCycles;
+    return res;
+}
+
+/**
+    \brief A function for running the benchmark of the algorithms
+
+    Every algorithm is measured with messages from 0 bytes to maxSize bytes in memory with all backends supported by the processor and in files.
+    The multi-lane backends are meant for many small messages and are measured up to 1 MiB
+
+    \param [in] algorithms the algorithms to measure
+    \param [in] maxSize the maximum length of the messages
+    \param [in] isJson print the results in json format instead of the table
+
+    \return true if the benchmark was completed, false if the temporary file cannot be written
+*/
+static bool RunBenchmark(const std::vector<const ToolAlgorithm*>& algorithms, std::size_t maxSize, const bool& isJson)
+{
+    // Message lengths from 0 bytes to 1 GiB
+    const std::size_t sizes[] = { 0, 64, 1024, 16384, 1048576, 16777216, 268435456, 1073741824 };
+
+    std::vector<char> data;
+    while (data.empty())
+    {
+        try
+        {
+            data.resize(std::max(maxSize, static_cast<std::size_t>(1)));
+        }
+        catch (const std::bad_alloc&)
+        {
+            maxSize >>= 1;
+        }
+    }
+
+    for (std::size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<char>(i * 31 + (i >> 8));
+
+    std::string fileName = (std::filesystem::temp_directory_path() / ("sha2-benchmark-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()))).string();
+
+    std::vector<BenchmarkResult> results;
+    bool isFailed = false;
+
+    for (const ToolAlgorithm* algorithm : algorithms)
+    {
+        std::vector<ToolBackend> backends = algorithm->backends();
+
+        for (const std::size_t& size : sizes)
+        {
+            if (size > maxSize)
+                break;
+
+            for (const ToolBackend& backend : backends)
+            {
+                if (backend.lanesCount > 1 && size > 1048576)
+                    continue;
+
+                // Number of messages in a round, the same message is hashed many times
+                std::size_t count = backend.lanesCount > 1 ? backend.lanesCount * (size <= 16384 ? 16 : 1) : std::max(static_cast<std::size_t>(1), static_cast<std::size_t>(1048576) / (size + 128));
+                std::vector<const char*> messages(count, data.data());
+                std::vector<std::size_t> messagesLens(count, size);
+
+                results.push_back(MeasureHashing(algorithm->name, backend.name, size, [&]()
+                {
+                    backend.hash(messages.data(), messagesLens.data(), count);
+                    return count;
+                }));
+            }
+
+            std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+            if (!file.write(data.data(), size))
+            {
+                PrintFileError(fileName, errno);
+                isFailed = true;
+                continue;
+            }
+            file.close();
+
+            results.push_back(MeasureHashing(algorithm->name, "file", size, [&]()
+            {
+                std::string hash;
+                algorithm->fileHash(fileName, hash);
+                return static_cast<std::size_t>(1);
+            }));
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::remove(fileName, error);
+
+    // Print results
+    if (isJson)
+        std::cout << "{\"results\":[" << std::endl;
+    else
+        std::cout << "algorithm  backend     size        MB/s        messages/s    cycles/byte" << std::endl;
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchmarkResult& result = results[i];
+        double bytesPerSecond = result.messagesCount * result.messageSize / result.seconds;
+        double messagesPerSecond = result.messagesCount / result.seconds;
+        double cyclesPerMessage = static_cast<double>(result.cycles) / result.messagesCount;
+
+        // Cycles per byte are not defined for empty messages
+        std::string cyclesPerByte = result.cycles == 0 || result.messageSize == 0 ? "null" : std::to_string(cyclesPerMessage / result.messageSize);
+
+        if (isJson)
+        {
+            std::cout << "{\"algorithm\":\"" << result.algorithm << "\",\"backend\":\"" << result.backend << "\",\"message_size\":" << result.messageSize
+                << ",\"messages\":" << result.messagesCount << ",\"seconds\":" << result.seconds << ",\"bytes_per_second\":" << bytesPerSecond
+                << ",\"messages_per_second\":" << messagesPerSecond << ",\"cycles_per_message\":" << (result.cycles == 0 ? "null" : std::to_string(cyclesPerMessage))
+                << ",\"cycles_per_byte\":" << cyclesPerByte << "}" << (i + 1 < results.size() ? "," : "") << std::endl;
+        }
+        else
+        {
+            std::cout << std::left << std::setw(11) << result.algorithm << std::setw(12) << result.backend << std::setw(12) << result.messageSize
+                << std::fixed << std::setprecision(1) << std::setw(12) << bytesPerSecond / 1000000 << std::setw(14) << messagesPerSecond << std::setprecision(2);
+            if (cyclesPerByte == "null")
+                std::cout << "-";
+            else
+                std::cout << cyclesPerMessage / result.messageSize;
+            std::cout << std::defaultfloat << std::endl;
+        }
+    }
+
+    if (isJson)
+        std::cout << "]}" << std::endl;
+
+    return !isFailed;
+}
+
+/// \brief Print the help of the command line tool
+/// \param [in] family the algorithms of the tool
+static void PrintHelp(const ToolFamily& family)
+{
+    std::cout << "Usage: " << ProgramName << " [OPTION]... [FILE]..." << std::endl
+        << "Print or check " << family.algorithmsNames << " checksums of files." << std::endl
+        << "Directories are hashed recursively. With no FILE, or when FILE is -, read standard input." << std::endl
+        << std::endl
+        << "  -a, --algorithm ALG   " << family.algorithmHelp << std::endl
+        << "  -c, --check           read checksums from the FILEs and check them" << std::endl
+        << "  -f, --files-from LIST read names of files to hash from LIST, one per line" << std::endl
+        << "      --cache INDEX     reuse the checksums of unchanged files from the INDEX file and save the new ones to it" << std::endl
+        << "  -j, --threads N       number of hashing threads (default: number of processors)" << std::endl
+        << "  -b, --benchmark       measure the hashing speed of the algorithm, or of all algorithms if -a is not set" << std::endl
+        << "      --max-size N      maximum message length of the benchmark in bytes (default: 1073741824)" << std::endl
+        << "      --json            print the benchmark results in json format" << std::endl
+        << "      --metrics         print the hashing metrics in Prometheus text format to standard error at exit" << std::endl
+        << "  -h, --help            display this help and exit" << std::endl;
+}
+
+int RunTool(int argc, char** argv, const ToolFamily& family)
+{
+    if (argc > 0)
+        ProgramName = argv[0];
+
+    const ToolAlgorithm* algorithm = &family.algorithms[0];
+    bool isCheck = false;
+    bool isFailed = false;
+    bool isBenchmark = false;
+    bool isJson = false;
+    bool isAlgorithmSet = false;
+    bool isMetricsPrinted = false;
+    std::size_t benchmarkMaxSize = 1073741824;
+    unsigned int threadsCount = std::max(std::thread::hardware_concurrency(), 1u);
+    std::vector<std::string> names;
+    std::string cacheFileName;
+
+    // Parse arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "-h" || arg == "--help")
+        {
+            PrintHelp(family);
+            return 0;
+        }
+        else if (arg == "-c" || arg == "--check")
+            isCheck = true;
+        else if ((arg == "-a" || arg == "--algorithm") && i + 1 < argc)
+        {
+            std::string name = argv[++i];
+            algorithm = nullptr;
+
+            for (std::size_t j = 0; j < family.algorithmsCount; ++j)
+                if (name == family.algorithms[j].name || "sha" + name == family.algorithms[j].name)
+                    algorithm = &family.algorithms[j];
+
+            if (algorithm == nullptr) {std::cerr << ProgramName << ": unknown algorithm: " << name << std::endl; return 1;}
+            isAlgorithmSet = true;
+        }
+        else if (arg == "-b" || arg == "--benchmark")
+            isBenchmark = true;
+        else if (arg == "--json")
+            isJson = true;
+        else if (arg == "--metrics")
+            isMetricsPrinted = true;
+        else if (arg == "--max-size" && i + 1 < argc)
+            benchmarkMaxSize = std::strtoull(argv[++i], nullptr, 10);
+        else if ((arg == "-f" || arg == "--files-from") && i + 1 < argc)
+            isFailed |= !ReadLines(argv[++i], names);
+        else if (arg == "--cache" && i + 1 < argc)
+            cacheFileName = argv[++i];
+        else if ((arg == "-j" || arg == "--threads") && i + 1 < argc)
+            threadsCount = std::max(std::atoi(argv[++i]), 1);
+        else if (arg.length() > 1 && arg[0] == '-' && arg != "--")
+        {
+            std::cerr << ProgramName << ": unrecognized option '" << arg << "'" << std::endl;
+            PrintHelp(family);
+            return 1;
+        }
+        else if (arg != "--")
+            names.push_back(arg);
+    }
+
+    if (isBenchmark)
+    {
+        std::vector<const ToolAlgorithm*> algorithms;
+        for (std::size_t i = 0; i < family.algorithmsCount; ++i)
+            if (!isAlgorithmSet || &family.algorithms[i] == algorithm)
+                algorithms.push_back(&family.algorithms[i]);
+
+        bool isBenchmarkDone = RunBenchmark(algorithms, benchmarkMaxSize, isJson);
+        if (isMetricsPrinted)
+            std::cerr << ExportSha2Metrics();
+
+        return isBenchmarkDone ? 0 : 1;
+    }
+
+    if (names.empty() && !isFailed)
+        names.push_back("-");
+
+    // Use the digest cache for the files which were not changed since the previous run
+    DigestCache cache;
+    if (!cacheFileName.empty())
+    {
+        cache.Load(cacheFileName);
+        SetDigestCache(&cache);
+    }
+
+    if (isCheck)
+        isFailed |= !CheckFiles(names, family, threadsCount);
+    else
+    {
+        std::vector<std::string> files = CollectFiles(names, isFailed);
+        isFailed |= !PrintFilesHashes(files, *algorithm, threadsCount);
+    }
+
+    if (!cacheFileName.empty())
+    {
+        SetDigestCache(nullptr);
+        if (!cache.Save(cacheFileName)) {std::cerr << ProgramName << ": " << cacheFileName << ": can not write the cache" << std::endl; isFailed = true;}
+    }
+
+    if (isMetricsPrinted)
+        std::cerr << ExportSha2Metrics();
+
+    return isFailed ? 1 : 0;
+}
@@ -0,0 +1,70 @@
+#ifndef SHA2_TOOL_H
+#define SHA2_TOOL_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+
+/// \brief Hashing backend measured by the benchmark of the command line tool
+struct ToolBackend
+{
+    // Name of the backend
+    std::string name;
+
+    // Number of messages hashed together in parallel lanes, 1 for the backends hashing one message at a time
+    std::size_t lanesCount;
+
+    // Function for hashing messages of the same length with the begin hash values of the algorithm
+    std::function<void(const char* const* data, const std::size_t* dataLens, const std::size_t& count)> hash;
+};
+
+/// \brief Description of the algorithm for the command line tool
+struct ToolAlgorithm
+{
+    // Name of the algorithm in the command line
+    const char* name;
+
+    // Length of the hash sum in hex form
+    std::size_t hashLen;
+
+    // Function for calculating the file hash sum. Returns false if the file cannot be read, errno is set to the reason
+    bool (*fileHash)(const std::string& fileName, std::string& hash);
+
+    // Function for calculating the hash sum of a stream
+    std::string (*streamHash)(std::istream& stream);
+
+    // Function for getting the backends supported by the processor for the benchmark
+    std::vector<ToolBackend> (*backends)();
+};
+
+/// \brief Description of the command line tool of an algorithms family
+struct ToolFamily
+{
+    // Supported algorithms, the first one is the default
+    const ToolAlgorithm* algorithms;
+    std::size_t algorithmsCount;
+
+    // Names of the algorithms for the help, for example "sha256 or sha224"
+    const char* algorithmsNames;
+
+    // Help of the algorithm option, for example "sha256 (default) or sha224"
+    const char* algorithmHelp;
+};
+
+/**
+    \brief A function for running the sha2sum-style command line tool
+
+    Hashes files, directories and lists of files in the coreutils format, checks manifests and runs the benchmark
+
+    \param [in] argc the number of the command line arguments
+    \param [in] argv the command line arguments
+    \param [in] family the algorithms of the tool
+
+    \return the exit status of the tool
+*/
+int RunTool(int argc, char** argv, const ToolFamily& family);
+
+#endif // SHA2_TOOL_H
@@ -0,0 +1,102 @@
+#include "Sha2Tool.h"
+#include "Sha2.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <cstring>
+
+// Begin hash values of the algorithms
+static const std::uint64_t Sha512BeginHash[8] = { 0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1, 0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179 };
+static const std::uint64_t Sha384BeginHash[8] = { 0xcbbb9d5dc1059ed8, 0x629a292a367cd507, 0x9159015a3070dd17, 0x152fecd8f70e5939, 0x67332667ffc00b31, 0x8eb44a8768581511, 0xdb0c2e0d64f98fa7, 0x47b5481dbefa4fa4 };
+static const std::uint64_t Sha512_224BeginHash[8] = { 0x8c3d37c819544da2, 0x73e1996689dcd4d6, 0x1dfab7ae32ff9c82, 0x679dd514582f9fcf, 0x0f6d2b697bd44da8, 0x77e36f7304c48942, 0x3f9d85a86a1d36c8, 0x1112e6ad91d692a1 };
+static const std::uint64_t Sha512_256BeginHash[8] = { 0x22312194fc2bf72c, 0x9f555fa3c84c64c2, 0x2393b86b6f53b151, 0x963877195940eabd, 0x96283ee2a88effe3, 0xbe5e1e2553863992, 0x2b0199fc2c85b8aa, 0x0eb72ddc81c52ca2 };
+
+/**
+    \brief A function for calculating the file hash sum for the command line tool
+
+    \param [in] fileName the string with file name to calculate hash for
+    \param [out] hash a string with the hash sum
+
+    \return true if the hash was calculated, false if the file cannot be opened
+*/
+template <typename Digest, bool (*FileHash)(const std::string&, Digest&, const std::size_t&) noexcept>
+bool ToolFileHash(const std::string& fileName, std::string& hash)
+{
+    Digest digest;
+    if (!FileHash(fileName, digest, CHUNK_SIZE))
+        return false;
+
+    hash = DigestToHex(digest);
+    return true;
+}
+
+/**
+    \brief A function for calculating the hash sum of a stream for the command line tool
+
+    \param [in] stream the stream to read
+
+    \return a string with the hash sum
+*/
+template <Sha512Variant Variant>
+std::string ToolStreamHash(std::istream& stream)
+{
+    Sha512Context context(Variant);
+    std::vector<char> chunk(CHUNK_SIZE);
+
+    while (stream.read(chunk.data(), chunk.size()) || stream.gcount() > 0)
+        context.Update(chunk.data(), stream.gcount());
+
+    return context.Final();
+}
+
+/**
+    \brief A function for getting the backends of the benchmark supported by the processor
+
+    The default backend is the one chosen by the library for single messages, the other ones are the kernels of the library
+
+    \return the backends hashing with the begin hash values of the algorithm
+*/
+template <const std::uint64_t* BeginHash>
+std::vector<ToolBackend> ToolBackends()
+{
+    std::vector<ToolBackend> res;
+
+    res.push_back({ "default", 1, [](const char* const* data, const std::size_t* dataLens, const std::size_t& count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::uint64_t h[8];
+            memcpy(h, BeginHash, sizeof(h));
+            HashSha512(data[i], dataLens[i], h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7]);
+        }
+    } });
+
+    // Kernels of the library
+    for (const Sha512Kernel& kernel : GetSha512Kernels())
+    {
+        res.push_back({ kernel.name, kernel.lanesCount, [kernel](const char* const* data, const std::size_t* dataLens, const std::size_t& count)
+        {
+            static thread_local std::vector<std::uint64_t> hashes;
+            hashes.resize(count * 8);
+            kernel.hash(data, dataLens, count, BeginHash, hashes.data());
+        } });
+    }
+
+    return res;
+}
+
+/// \brief Algorithms supported by the command line tool
+static const ToolAlgorithm Sha512Algorithms[] = {
+    { "sha512", 128, ToolFileHash<Sha512Digest, FileSha512Binary>, ToolStreamHash<Sha512Variant::Sha512>, ToolBackends<Sha512BeginHash> },
+    { "sha384", 96, ToolFileHash<Sha384Digest, FileSha384Binary>, ToolStreamHash<Sha512Variant::Sha384>, ToolBackends<Sha384BeginHash> },
+    { "sha512-224", 56, ToolFileHash<Sha512_224Digest, FileSha512_224Binary>, ToolStreamHash<Sha512Variant::Sha512_224>, ToolBackends<Sha512_224BeginHash> },
+    { "sha512-256", 64, ToolFileHash<Sha512_256Digest, FileSha512_256Binary>, ToolStreamHash<Sha512Variant::Sha512_256>, ToolBackends<Sha512_256BeginHash> },
+};
+
+int main(int argc, char** argv)
+{
+    ToolFamily family = { Sha512Algorithms, sizeof(Sha512Algorithms) / sizeof(Sha512Algorithms[0]), "sha512, sha384, sha512/224 or sha512/256", "sha512 (default), sha384, sha512-224 or sha512-256" };
+    return RunTool(argc, argv, family);
+}